@@ -7,9 +7,58 @@
 
 #include <hydro_bds.H>
 #include <hydro_utils.H>
+#include <hydro_utils_K.H>
 
 using namespace amrex;
 
+bool
+BDS::SlopeCache::isValid (MultiFab const& state, int a_state_comp, int a_ncomp,
+                          Long a_state_version) const
+{
+    return state_version >= 0 && state_version == a_state_version &&
+           state_comp == a_state_comp && ncomp == a_ncomp &&
+           slopes.ok() &&
+           slopes.boxArray() == state.boxArray() &&
+           slopes.DistributionMap() == state.DistributionMap();
+}
+
+void
+BDS::FillSlopeCache ( SlopeCache& slope_cache,
+                      MultiFab const& state, int state_comp, int ncomp,
+                      Long state_version,
+                      Geometry const& geom,
+                      BCRec const* d_bc)
+{
+    BL_PROFILE("BDS::FillSlopeCache()");
+
+    constexpr int nslopes = (AMREX_SPACEDIM == 2) ? 3 : 7;
+
+    MultiFab& slopes = slope_cache.slopes;
+    if ( !slopes.ok() ||
+         slopes.boxArray() != state.boxArray() ||
+         slopes.DistributionMap() != state.DistributionMap() ||
+         slopes.nComp() != nslopes*ncomp )
+    {
+        slopes.clear();
+        slopes.define(state.boxArray(), state.DistributionMap(), nslopes*ncomp, 1);
+    }
+
+    // No tiling: ComputeSlopes fills the box grown by 1, and grown tiles would overlap
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(slopes); mfi.isValid(); ++mfi)
+    {
+        BDS::ComputeSlopes( mfi.validbox(), geom, ncomp,
+                            state.const_array(mfi, state_comp),
+                            slopes.array(mfi), d_bc );
+    }
+
+    slope_cache.state_version = state_version;
+    slope_cache.state_comp    = state_comp;
+    slope_cache.ncomp         = ncomp;
+}
+
 void
 BDS::ComputeAofs ( MultiFab& aofs,
                    const int aofs_comp,
@@ -35,34 +84,35 @@ BDS::ComputeAofs ( MultiFab& aofs,
                    Geometry const& geom,
                    Vector<int>& iconserv,
                    const Real dt,
-                   const bool is_velocity)
+                   const bool is_velocity,
+                   SlopeCache* slope_cache,
+                   Long state_version,
+                   HydroUtils::AdvectionDiagnostics* diagnostics)
 {
 
     BL_PROFILE("BDS::ComputeAofs()");
+
     amrex::ignore_unused(divu);
 
     bool fluxes_are_area_weighted = true;
 
+    // Optional diagnostics, reduced in the kernel that finishes aofs on each tile
+    std::unique_ptr<HydroUtils::AdvectionDiagnosticsReduction> diag_reduction;
+    if (diagnostics) {
+        diag_reduction = std::make_unique<HydroUtils::AdvectionDiagnosticsReduction>(
+            ncomp, geom, fluxes_are_area_weighted);
+    }
+
     // Make a device copy of the iconserv vector for use in kernels
     Gpu::DeviceVector<int> iconserv_d(iconserv.size());
     Gpu::copy(Gpu::hostToDevice, iconserv.begin(), iconserv.end(), iconserv_d.begin());
     int const* iconserv_ptr = iconserv_d.data();
 
-    // If we need convective form, we must also compute div(u_mac)
-    MultiFab divu_mac(state.boxArray(),state.DistributionMap(),1,0);;
-    for (Long i = 0; i < iconserv.size(); ++i)
-    {
-        if (!iconserv[i])
-        {
-            Array<MultiFab const*,AMREX_SPACEDIM> u;
-            AMREX_D_TERM(u[0] = &umac;,
-                         u[1] = &vmac;,
-                         u[2] = &wmac;);
-            amrex::computeDivergence(divu_mac,u,geom);
-
-            break;
-        }
-    }
+    // If we need convective form, we also need div(u_mac). It is computed
+    // inline from the face velocities of each tile.
+    const auto dxinv  = geom.InvCellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const bool is_rz  = geom.IsRZ();
 
 #if (AMREX_SPACEDIM==2)
     if ( geom.IsRZ() )
@@ -71,6 +121,12 @@ BDS::ComputeAofs ( MultiFab& aofs,
     }
 #endif
 
+    // Reuse the caller's slopes if they were computed from this state, otherwise fill them
+    const bool use_slope_cache = !known_edgestate && slope_cache != nullptr && state_version >= 0;
+    if ( use_slope_cache && !slope_cache->isValid(state, state_comp, ncomp, state_version) ) {
+        FillSlopeCache(*slope_cache, state, state_comp, ncomp, state_version, geom, d_bc);
+    }
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
@@ -94,7 +150,17 @@ BDS::ComputeAofs ( MultiFab& aofs,
                       const auto& v = vmac.const_array(mfi);,
                       const auto& w = wmac.const_array(mfi););
 
-        if ( !known_edgestate ) {
+        if ( use_slope_cache ) {
+            BDS::ComputeEdgeState( bx, ncomp,
+                                   state.array(mfi, state_comp),
+                                   AMREX_D_DECL(xed, yed, zed),
+                                   AMREX_D_DECL(u, v, w),
+                                   divu.array(mfi),
+                                   fq.array(mfi, fq_comp),
+                                   geom, dt, d_bc, iconserv_ptr,
+                                   is_velocity,
+                                   slope_cache->slopes.const_array(mfi));
+        } else if ( !known_edgestate ) {
             BDS::ComputeEdgeState( bx, ncomp,
                                    state.array(mfi, state_comp),
                                    AMREX_D_DECL(xed, yed, zed),
@@ -128,9 +194,9 @@ BDS::ComputeAofs ( MultiFab& aofs,
         // Compute the convective form if needed and
         // flip the sign to return div
         auto const& aofs_arr  = aofs.array(mfi, aofs_comp);
-        auto const& divu_arr  = divu_mac.array(mfi);
-        amrex::ParallelFor(bx, ncomp, [=]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        HydroUtils::ParallelForWithDiagnostics(diag_reduction.get(), bx, ncomp, aofs_arr,
+                                               {{AMREX_D_DECL(u,v,w)}, {AMREX_D_DECL(fx,fy,fz)}, {}},
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         {
             if (!iconserv_ptr[n])
             {
@@ -142,7 +208,8 @@ BDS::ComputeAofs ( MultiFab& aofs,
                 q += zed(i,j,k,n) + zed(i,j,k+1,n);
                 q /= 6.0;
 #endif
-                aofs_arr(i,j,k,n) += q*divu_arr(i,j,k);
+                aofs_arr(i,j,k,n) += q*HydroUtils::umac_divergence(i,j,k,AMREX_D_DECL(u,v,w),
+                                                                    dxinv,problo,is_rz);
             }
 
             aofs_arr( i, j, k, n ) *=  - 1.0;
@@ -157,6 +224,10 @@ BDS::ComputeAofs ( MultiFab& aofs,
         Gpu::streamSynchronize();  // otherwise we might be using too much memory
     }
 
+    if (diag_reduction) {
+        diag_reduction->finalize(*diagnostics);
+    }
+
 }
 
 
@@ -189,7 +260,9 @@ BDS::ComputeSyncAofs ( MultiFab& aofs,
                        Geometry const& geom,
                        Gpu::DeviceVector<int>& iconserv,
                        const Real dt,
-                       const bool is_velocity)
+                       const bool is_velocity,
+                       SlopeCache* slope_cache,
+                       Long state_version)
 {
 
     BL_PROFILE("BDS::ComputeSyncAofs()");
@@ -206,6 +279,12 @@ BDS::ComputeSyncAofs ( MultiFab& aofs,
     }
 #endif
 
+    // Reuse the caller's slopes if they were computed from this state, otherwise fill them
+    const bool use_slope_cache = !known_edgestate && slope_cache != nullptr && state_version >= 0;
+    if ( use_slope_cache && !slope_cache->isValid(state, state_comp, ncomp, state_version) ) {
+        FillSlopeCache(*slope_cache, state, state_comp, ncomp, state_version, geom, d_bc);
+    }
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
@@ -235,24 +314,30 @@ BDS::ComputeSyncAofs ( MultiFab& aofs,
                           const auto& v = vmac.const_array(mfi);,
                           const auto& w = wmac.const_array(mfi););
 
-            BDS::ComputeEdgeState( bx, ncomp,
-                                   state.array(mfi, state_comp),
-                                   AMREX_D_DECL(xed,yed,zed),
-                                   AMREX_D_DECL(u,v,w),
-                                   divu.array(mfi),
-                                   fq.array(mfi,fq_comp),
-                                   geom, dt, d_bc, iconserv_ptr,
-                                   is_velocity);
+            if ( use_slope_cache ) {
+                BDS::ComputeEdgeState( bx, ncomp,
+                                       state.array(mfi, state_comp),
+                                       AMREX_D_DECL(xed,yed,zed),
+                                       AMREX_D_DECL(u,v,w),
+                                       divu.array(mfi),
+                                       fq.array(mfi,fq_comp),
+                                       geom, dt, d_bc, iconserv_ptr,
+                                       is_velocity,
+                                       slope_cache->slopes.const_array(mfi));
+            } else {
+                BDS::ComputeEdgeState( bx, ncomp,
+                                       state.array(mfi, state_comp),
+                                       AMREX_D_DECL(xed,yed,zed),
+                                       AMREX_D_DECL(u,v,w),
+                                       divu.array(mfi),
+                                       fq.array(mfi,fq_comp),
+                                       geom, dt, d_bc, iconserv_ptr,
+                                       is_velocity);
+            }
         }
 
-        // Temporary divergence
-        Box tmpbox = amrex::surroundingNodes(bx);
-        int tmpcomp = ncomp*AMREX_SPACEDIM;
-        FArrayBox tmpfab(tmpbox, tmpcomp);
-        Elixir eli = tmpfab.elixir();
-        Array4<Real> divtmp_arr = tmpfab.array();
-
-        Real mult = -1.0;
+        // The sync contribution is +div, added straight into aofs
+        Real mult = 1.0;
 
         HydroUtils::ComputeFluxes( bx,
                                    AMREX_D_DECL( fx, fy, fz ),
@@ -260,17 +345,11 @@ BDS::ComputeSyncAofs ( MultiFab& aofs,
                                    AMREX_D_DECL( xed, yed, zed ),
                                    geom, ncomp, fluxes_are_area_weighted );
 
-        HydroUtils::ComputeDivergence( bx, divtmp_arr,
+        HydroUtils::ComputeDivergence( bx, aofs.array(mfi, aofs_comp),
                                        AMREX_D_DECL( fx, fy, fz ),
                                        ncomp, geom,
-                                       mult, fluxes_are_area_weighted);
-
-        // Sum contribution to sync aofs
-        auto const& aofs_arr = aofs.array(mfi, aofs_comp);
-
-        amrex::ParallelFor(bx, ncomp, [aofs_arr, divtmp_arr]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        { aofs_arr( i, j, k, n ) += - divtmp_arr( i, j, k, n ); });
+                                       mult, fluxes_are_area_weighted,
+                                       /*accumulate=*/true);
 
         Gpu::streamSynchronize();  // otherwise we might be using too much memory
     }
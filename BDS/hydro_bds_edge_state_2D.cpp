@@ -48,258 +48,376 @@ BDS::ComputeEdgeState ( Box const& bx, int ncomp,
                         BCRec const* pbc, int const* iconserv,
                         const bool is_velocity)
 {
-    // For now, loop on components here
-    for( int icomp = 0; icomp < ncomp; ++icomp)
-    {
-        // Temporary slope container per components
-        Box const& bxg1 = amrex::grow(bx,1);
-        FArrayBox slopefab(bxg1,3);
-        Elixir slopeeli = slopefab.elixir();
-
-        BDS::ComputeSlopes(bx, geom, icomp,
-                           q, slopefab.array(),
-                           pbc);
-
-        BDS::ComputeConc(bx, geom, icomp,
-                         q, xedge, yedge, slopefab.array(),
-                         umac, vmac, divu, fq,
-                         iconserv,
-                         l_dt, pbc, is_velocity);
-    }
+    // Slopes of all components, 3 per component
+    Box const& bxg1 = amrex::grow(bx,1);
+    FArrayBox slopefab(bxg1,3*ncomp);
+    Elixir slopeeli = slopefab.elixir();
+
+    BDS::ComputeSlopes(bx, geom, ncomp,
+                       q, slopefab.array(),
+                       pbc);
+
+    BDS::ComputeEdgeState(bx, ncomp, q,
+                          AMREX_D_DECL(xedge, yedge, zedge),
+                          AMREX_D_DECL(umac, vmac, wmac),
+                          divu, fq, geom, l_dt, pbc, iconserv,
+                          is_velocity, slopefab.const_array());
 }
 
 /**
- * Compute bilinear slopes for BDS algorithm.
+ * Computes BDS edge states from slopes already computed by ComputeSlopes.
  *
- * \param [in]  bx      Current grid patch
- * \param [in]  geom    Level geometry.
+ * \param [in]     slopes      Array4 of the slopes of q on the box grown by 1,
+ *                             3 components per state component.
+ */
+
+void
+BDS::ComputeEdgeState ( Box const& bx, int ncomp,
+                        Array4<Real const> const& q,
+                        Array4<Real      > const& xedge,
+                        Array4<Real      > const& yedge,
+                        Array4<Real const> const& umac,
+                        Array4<Real const> const& vmac,
+                        Array4<Real const> const& divu,
+                        Array4<Real const> const& fq,
+                        Geometry geom,
+                        Real l_dt,
+                        BCRec const* pbc, int const* iconserv,
+                        const bool is_velocity,
+                        Array4<Real const> const& slopes)
+{
+    BDS::ComputeConc(bx, geom, ncomp,
+                     q, xedge, yedge, slopes,
+                     umac, vmac, divu, fq,
+                     iconserv,
+                     l_dt, pbc, is_velocity);
+}
+
+/**
+ * Returns the bicubic interpolant of the state at node (i,j,k), the lower
+ * corner of cell (i,j,k), reverting to lower order next to physical
+ * boundaries.
+ *
+ * \param [in]  i,j,k   Node index.
  * \param [in]  icomp   Component of the state Array4.
  * \param [in]  s       Array4<const> of state vector.
- * \param [out] slopes  Array4 to store slope information.
+ * \param [in]  bc      Boundary conditions of component icomp.
+ * \param [in]  dlo     Lower corner of the domain.
+ * \param [in]  dhi     Upper corner of the domain.
  *
  */
 
-void
-BDS::ComputeSlopes ( Box const& bx,
-                     const Geometry& geom,
-                     int icomp,
-                     Array4<Real const> const& s,
-                     Array4<Real      > const& slopes,
-                     BCRec const* pbc)
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real node_value (int i, int j, int k, int icomp,
+                 Array4<Real const> const& s, BCRec const& bc,
+                 Dim3 const& dlo, Dim3 const& dhi)
 {
-    constexpr bool limit_slopes = true;
+    bool lo_x_physbc = (bc.lo(0) == BCType::foextrap || bc.lo(0) == BCType::hoextrap || bc.lo(0) == BCType::ext_dir) ? true : false;
+    bool hi_x_physbc = (bc.hi(0) == BCType::foextrap || bc.hi(0) == BCType::hoextrap || bc.hi(0) == BCType::ext_dir) ? true : false;
+    bool lo_y_physbc = (bc.lo(1) == BCType::foextrap || bc.lo(1) == BCType::hoextrap || bc.lo(1) == BCType::ext_dir) ? true : false;
+    bool hi_y_physbc = (bc.hi(1) == BCType::foextrap || bc.hi(1) == BCType::hoextrap || bc.hi(1) == BCType::ext_dir) ? true : false;
+
+    // set node values equal to the average of the ghost cell values since they store the physical condition on the boundary
+    if ( i<=dlo.x && lo_x_physbc ) {
+        return 0.5*(s(dlo.x-1,j,k,icomp) + s(dlo.x-1,j-1,k,icomp));
+    }
+    if ( i>=dhi.x+1 && hi_x_physbc ) {
+        return 0.5*(s(dhi.x+1,j,k,icomp) + s(dhi.x+1,j-1,k,icomp));
+    }
+    if ( j<=dlo.y && lo_y_physbc ) {
+        return 0.5*(s(i,dlo.y-1,k,icomp) + s(i-1,dlo.y-1,k,icomp));
+    }
+    if ( j>=dhi.y+1 && hi_y_physbc ) {
+        return 0.5*(s(i,dhi.y+1,k,icomp) + s(i-1,dhi.y+1,k,icomp));
+    }
 
-    // Define container for the nodal interpolated state
-    Box const& ngbx = amrex::grow(amrex::convert(bx,IntVect(AMREX_D_DECL(1,1,1))),1);
-    FArrayBox tmpnodefab(ngbx,1);
-    Elixir tmpeli = tmpnodefab.elixir();
-    auto const& sint = tmpnodefab.array();
+    // one cell inward from any physical boundary, revert to 4-point average
+    if ( (i==dlo.x+1 && lo_x_physbc) ||
+         (i==dhi.x   && hi_x_physbc) ||
+         (j==dlo.y+1 && lo_y_physbc) ||
+         (j==dhi.y   && hi_y_physbc) ) {
 
-    Box const& gbx = amrex::grow(bx,1);
-    GpuArray<Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
+        return 0.25* (s(i,j,k,icomp) + s(i-1,j,k,icomp) + s(i,j-1,k,icomp) + s(i-1,j-1,k,icomp));
+    }
 
-    Real hx = dx[0];
-    Real hy = dx[1];
+    return (s(i-2,j-2,k,icomp) + s(i-2,j+1,k,icomp) + s(i+1,j-2,k,icomp) + s(i+1,j+1,k,icomp)
+            - 7.0*(s(i-2,j-1,k,icomp) + s(i-2,j  ,k,icomp) + s(i-1,j-2,k,icomp) + s(i  ,j-2,k,icomp) +
+                   s(i-1,j+1,k,icomp) + s(i  ,j+1,k,icomp) + s(i+1,j-1,k,icomp) + s(i+1,j  ,k,icomp))
+           + 49.0*(s(i-1,j-1,k,icomp) + s(i  ,j-1,k,icomp) + s(i-1,j  ,k,icomp) + s(i  ,j  ,k,icomp)) ) / 144.0;
+}
 
-    Box const& domain = geom.Domain();
-    const auto dlo = amrex::lbound(domain);
-    const auto dhi = amrex::ubound(domain);
+/**
+ * Computes the limited slopes of cell (i,j,k) from the four node values
+ * at its corners, nd(ii,jj) being the value at node (i+ii,j+jj).
+ *
+ * \param [in]  i,j,k   Cell index.
+ * \param [in]  icomp   Component of the state Array4.
+ * \param [in]  nd      Node values at the corners of the cell.
+ * \param [in]  s       Array4<const> of state vector.
+ * \param [out] slopes  Array4 to store slope information, 3 components per state component.
+ * \param [in]  bc      Boundary conditions of component icomp.
+ * \param [in]  dlo     Lower corner of the domain.
+ * \param [in]  dhi     Upper corner of the domain.
+ * \param [in]  dx      Cell size.
+ *
+ */
 
-    auto bc = pbc[icomp];
+template <typename N>
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void limited_slopes (int i, int j, int k, int icomp, N const& nd,
+                     Array4<Real const> const& s, Array4<Real> const& slopes,
+                     BCRec const& bc, Dim3 const& dlo, Dim3 const& dhi,
+                     GpuArray<Real,AMREX_SPACEDIM> const& dx)
+{
+    constexpr bool limit_slopes = true;
 
-    // Abort for cell-centered BC types
-    if ( bc.lo(0) == BCType::reflect_even || bc.lo(0) == BCType::reflect_odd || bc.lo(0) == BCType::hoextrapcc ||
-         bc.hi(0) == BCType::reflect_even || bc.hi(0) == BCType::reflect_odd || bc.hi(0) == BCType::hoextrapcc ||
-         bc.lo(1) == BCType::reflect_even || bc.lo(1) == BCType::reflect_odd || bc.lo(1) == BCType::hoextrapcc ||
-         bc.hi(1) == BCType::reflect_even || bc.hi(1) == BCType::reflect_odd || bc.hi(1) == BCType::hoextrapcc )
-        amrex::Abort("BDS::Slopes: Unsupported BC type. Supported types are int_dir, ext_dir, foextrap, and hoextrap");
+    Real hx = dx[0];
+    Real hy = dx[1];
 
     bool lo_x_physbc = (bc.lo(0) == BCType::foextrap || bc.lo(0) == BCType::hoextrap || bc.lo(0) == BCType::ext_dir) ? true : false;
     bool hi_x_physbc = (bc.hi(0) == BCType::foextrap || bc.hi(0) == BCType::hoextrap || bc.hi(0) == BCType::ext_dir) ? true : false;
     bool lo_y_physbc = (bc.lo(1) == BCType::foextrap || bc.lo(1) == BCType::hoextrap || bc.lo(1) == BCType::ext_dir) ? true : false;
     bool hi_y_physbc = (bc.hi(1) == BCType::foextrap || bc.hi(1) == BCType::hoextrap || bc.hi(1) == BCType::ext_dir) ? true : false;
 
-    // bicubic interpolation to corner points
-    // (i,j,k) refers to lower corner of cell
-    // Added k index -- placeholder for 2d
-    ParallelFor(ngbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
+    // compute initial estimates of slopes from unlimited corner points
 
-        // set node values equal to the average of the ghost cell values since they store the physical condition on the boundary
-        if ( i<=dlo.x && lo_x_physbc ) {
-            sint(i,j,k) = 0.5*(s(dlo.x-1,j,k,icomp) + s(dlo.x-1,j-1,k,icomp));
-            return;
-        }
-        if ( i>=dhi.x+1 && hi_x_physbc ) {
-            sint(i,j,k) = 0.5*(s(dhi.x+1,j,k,icomp) + s(dhi.x+1,j-1,k,icomp));
-            return;
-        }
-        if ( j<=dlo.y && lo_y_physbc ) {
-            sint(i,j,k) = 0.5*(s(i,dlo.y-1,k,icomp) + s(i-1,dlo.y-1,k,icomp));
-            return;
-        }
-        if ( j>=dhi.y+1 && hi_y_physbc ) {
-            sint(i,j,k) = 0.5*(s(i,dhi.y+1,k,icomp) + s(i-1,dhi.y+1,k,icomp));
-            return;
-        }
+    // local variables
+    Real sumloc, redfac, redmax, div, kdp, sumdif, sgndif;
 
-        // one cell inward from any physical boundary, revert to 4-point average
-        if ( (i==dlo.x+1 && lo_x_physbc) ||
-             (i==dhi.x   && hi_x_physbc) ||
-             (j==dlo.y+1 && lo_y_physbc) ||
-             (j==dhi.y   && hi_y_physbc) ) {
+    Array1D<Real, 1, 4> diff;
+    Array1D<Real, 1, 4> smin;
+    Array1D<Real, 1, 4> smax;
+    Array1D<Real, 1, 4> sc;
 
-            sint(i,j,k) = 0.25* (s(i,j,k,icomp) + s(i-1,j,k,icomp) + s(i,j-1,k,icomp) + s(i-1,j-1,k,icomp));
-            return;
-        }
+    Array1D<bool, 1, 4> allow_change;
+    for (int mm=1; mm<=4; ++mm) {
+        allow_change(mm) = true;
+    }
 
-        sint(i,j,k) = (s(i-2,j-2,k,icomp) + s(i-2,j+1,k,icomp) + s(i+1,j-2,k,icomp) + s(i+1,j+1,k,icomp)
-                - 7.0*(s(i-2,j-1,k,icomp) + s(i-2,j  ,k,icomp) + s(i-1,j-2,k,icomp) + s(i  ,j-2,k,icomp) +
-                       s(i-1,j+1,k,icomp) + s(i  ,j+1,k,icomp) + s(i+1,j-1,k,icomp) + s(i+1,j  ,k,icomp))
-               + 49.0*(s(i-1,j-1,k,icomp) + s(i  ,j-1,k,icomp) + s(i-1,j  ,k,icomp) + s(i  ,j  ,k,icomp)) ) / 144.0;
-    });
+    if ( i<=dlo.x && lo_x_physbc ) {
+        allow_change(1) = false;
+        allow_change(2) = false;
+    }
+    if ( i>=dhi.x+1 && hi_x_physbc ) {
+        allow_change(3) = false;
+        allow_change(4) = false;
+    }
+    if ( j<=dlo.y && lo_y_physbc ) {
+        allow_change(1) = false;
+        allow_change(3) = false;
+    }
+    if ( j>=dhi.y+1 && hi_y_physbc ) {
+        allow_change(2) = false;
+        allow_change(4) = false;
+    }
 
-    ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
-        // compute initial estimates of slopes from unlimited corner points
+    // compute initial estimates of slopes from unlimited corner points
+    // sx
+    slopes(i,j,k,3*icomp+0) = 0.5*(nd(1,1) + nd(1,0) - nd(0,1) - nd(0,0)) / hx;
+    // sy
+    slopes(i,j,k,3*icomp+1) = 0.5*(nd(1,1) - nd(1,0) + nd(0,1) - nd(0,0)) / hy;
+    // sxy
+    slopes(i,j,k,3*icomp+2) =     (nd(1,1) - nd(1,0) - nd(0,1) + nd(0,0)) / (hx*hy);
 
-        // local variables
-        Real sumloc, redfac, redmax, div, kdp, sumdif, sgndif;
+    if (limit_slopes) {
 
-        Array1D<Real, 1, 4> diff;
-        Array1D<Real, 1, 4> smin;
-        Array1D<Real, 1, 4> smax;
-        Array1D<Real, 1, 4> sc;
+        // ++ / nd(1,1)
+        sc(4) = s(i,j,k,icomp) + 0.5*(hx*slopes(i,j,k,3*icomp+0) + hy*slopes(i,j,k,3*icomp+1)) + 0.25*hx*hy*slopes(i,j,k,3*icomp+2);
 
-        Array1D<bool, 1, 4> allow_change;
-        for (int mm=1; mm<=4; ++mm) {
-            allow_change(mm) = true;
-        }
+        // +- / nd(1,0)
+        sc(3) = s(i,j,k,icomp) + 0.5*(hx*slopes(i,j,k,3*icomp+0) - hy*slopes(i,j,k,3*icomp+1)) - 0.25*hx*hy*slopes(i,j,k,3*icomp+2);
 
-        if ( i<=dlo.x && lo_x_physbc ) {
-            allow_change(1) = false;
-            allow_change(2) = false;
-        }
-        if ( i>=dhi.x+1 && hi_x_physbc ) {
-            allow_change(3) = false;
-            allow_change(4) = false;
-        }
-        if ( j<=dlo.y && lo_y_physbc ) {
-            allow_change(1) = false;
-            allow_change(3) = false;
-        }
-        if ( j>=dhi.y+1 && hi_y_physbc ) {
-            allow_change(2) = false;
-            allow_change(4) = false;
+        // -+ / nd(0,1)
+        sc(2) = s(i,j,k,icomp) - 0.5*(hx*slopes(i,j,k,3*icomp+0) - hy*slopes(i,j,k,3*icomp+1)) - 0.25*hx*hy*slopes(i,j,k,3*icomp+2);
+
+        // -- / nd(0,0)
+        sc(1) = s(i,j,k,icomp) - 0.5*(hx*slopes(i,j,k,3*icomp+0) + hy*slopes(i,j,k,3*icomp+1)) + 0.25*hx*hy*slopes(i,j,k,3*icomp+2);
+
+        // enforce max/min bounds
+        smin(4) = amrex::min(s(i,j,k,icomp), s(i+1,j,k,icomp), s(i,j+1,k,icomp), s(i+1,j+1,k,icomp));
+        smax(4) = amrex::max(s(i,j,k,icomp), s(i+1,j,k,icomp), s(i,j+1,k,icomp), s(i+1,j+1,k,icomp));
+
+        smin(3) = amrex::min(s(i,j,k,icomp), s(i+1,j,k,icomp), s(i,j-1,k,icomp), s(i+1,j-1,k,icomp));
+        smax(3) = amrex::max(s(i,j,k,icomp), s(i+1,j,k,icomp), s(i,j-1,k,icomp), s(i+1,j-1,k,icomp));
+
+        smin(2) = amrex::min(s(i,j,k,icomp), s(i-1,j,k,icomp), s(i,j+1,k,icomp), s(i-1,j+1,k,icomp));
+        smax(2) = amrex::max(s(i,j,k,icomp), s(i-1,j,k,icomp), s(i,j+1,k,icomp), s(i-1,j+1,k,icomp));
+
+        smin(1) = amrex::min(s(i,j,k,icomp), s(i-1,j,k,icomp), s(i,j-1,k,icomp), s(i-1,j-1,k,icomp));
+        smax(1) = amrex::max(s(i,j,k,icomp), s(i-1,j,k,icomp), s(i,j-1,k,icomp), s(i-1,j-1,k,icomp));
+
+        for(int mm=1; mm<=4; ++mm){
+           if (allow_change(mm)) {
+               sc(mm) = amrex::max(amrex::min(sc(mm), smax(mm)), smin(mm));
+           }
         }
 
-        // compute initial estimates of slopes from unlimited corner points
-        // sx
-        slopes(i,j,k,0) = 0.5*(sint(i+1,j+1,k) + sint(i+1,j,k) - sint(i,j+1,k) - sint(i,j,k)) / hx;
-        // sy
-        slopes(i,j,k,1) = 0.5*(sint(i+1,j+1,k) - sint(i+1,j,k) + sint(i,j+1,k) - sint(i,j,k)) / hy;
-        // sxy
-        slopes(i,j,k,2) =     (sint(i+1,j+1,k) - sint(i+1,j,k) - sint(i,j+1,k) + sint(i,j,k)) / (hx*hy);
+        // iterative loop
+        for(int ll=1; ll<=3; ++ll){
 
-        if (limit_slopes) {
+           // compute the amount by which the average of the nodal values differs from cell-center value
+           sumloc = 0.25*(sc(4) + sc(3) + sc(2) + sc(1));
+           sumdif = (sumloc - s(i,j,k,icomp))*4.0;
 
-            // ++ / sint(i+1,j+1)
-            sc(4) = s(i,j,k,icomp) + 0.5*(hx*slopes(i,j,k,0) + hy*slopes(i,j,k,1)) + 0.25*hx*hy*slopes(i,j,k,2);
+           // sgndif = +(-)1 if the node average is too large(small)
+           sgndif = std::copysign(1.0,sumdif);
 
-            // +- / sint(i+1,j  )
-            sc(3) = s(i,j,k,icomp) + 0.5*(hx*slopes(i,j,k,0) - hy*slopes(i,j,k,1)) - 0.25*hx*hy*slopes(i,j,k,2);
+           // compute how much each node is larger(smaller) than the cell-centered value
+           for(int mm=1; mm<=4; ++mm){
+              diff(mm) = (sc(mm) - s(i,j,k,icomp))*sgndif;
+           }
 
-            // -+ / sint(i  ,j+1)
-            sc(2) = s(i,j,k,icomp) - 0.5*(hx*slopes(i,j,k,0) - hy*slopes(i,j,k,1)) - 0.25*hx*hy*slopes(i,j,k,2);
+           kdp = 0;
 
-            // -- / sint(i  ,j  )
-            sc(1) = s(i,j,k,icomp) - 0.5*(hx*slopes(i,j,k,0) + hy*slopes(i,j,k,1)) + 0.25*hx*hy*slopes(i,j,k,2);
+           // count how many nodes are larger(smaller) than the cell-centered value
+           for(int mm=1; mm<=4; ++mm){
+              if (diff(mm) > eps && allow_change(mm)) {
+                 kdp = kdp+1;
+              }
+           }
 
-            // enforce max/min bounds
-            smin(4) = amrex::min(s(i,j,k,icomp), s(i+1,j,k,icomp), s(i,j+1,k,icomp), s(i+1,j+1,k,icomp));
-            smax(4) = amrex::max(s(i,j,k,icomp), s(i+1,j,k,icomp), s(i,j+1,k,icomp), s(i+1,j+1,k,icomp));
+           // adjust node values
+           for(int mm=1; mm<=4; ++mm){
 
-            smin(3) = amrex::min(s(i,j,k,icomp), s(i+1,j,k,icomp), s(i,j-1,k,icomp), s(i+1,j-1,k,icomp));
-            smax(3) = amrex::max(s(i,j,k,icomp), s(i+1,j,k,icomp), s(i,j-1,k,icomp), s(i+1,j-1,k,icomp));
+              // don't allow boundary nodes to change value
+              if (!allow_change(mm)) continue;
 
-            smin(2) = amrex::min(s(i,j,k,icomp), s(i-1,j,k,icomp), s(i,j+1,k,icomp), s(i-1,j+1,k,icomp));
-            smax(2) = amrex::max(s(i,j,k,icomp), s(i-1,j,k,icomp), s(i,j+1,k,icomp), s(i-1,j+1,k,icomp));
+              // how many node values are left to potentially adjust
+              if (kdp<1) {
+                 div = 1.0;
+              } else {
+                 div = kdp;
+              }
 
-            smin(1) = amrex::min(s(i,j,k,icomp), s(i-1,j,k,icomp), s(i,j-1,k,icomp), s(i-1,j-1,k,icomp));
-            smax(1) = amrex::max(s(i,j,k,icomp), s(i-1,j,k,icomp), s(i,j-1,k,icomp), s(i-1,j-1,k,icomp));
+              // if the node needs adjusting, figure out by how much the remaining sum is divy'ed up
+              if (diff(mm)>eps) {
+                 redfac = sumdif*sgndif/div;
+                 kdp = kdp-1;
+              } else {
+                 redfac = 0.0;
+              }
 
-            for(int mm=1; mm<=4; ++mm){
-               if (allow_change(mm)) {
-                   sc(mm) = amrex::max(amrex::min(sc(mm), smax(mm)), smin(mm));
-               }
-            }
+              // don't let the adjustment introduce any new extrema
+              if (sgndif > 0.0) {
+                 redmax = sc(mm) - smin(mm);
+              } else {
+                 redmax = smax(mm) - sc(mm);
+              }
+              redfac = amrex::min(redfac,redmax);
+
+              // adjust nodal value and decrement the excess
+              sumdif = sumdif - redfac*sgndif;
+              sc(mm) = sc(mm) - redfac*sgndif;
+           }
+        }
+
+        // final slopes
+        // sx
+        slopes(i,j,k,3*icomp+0) = 0.5*( sc(4) + sc(3) -sc(1) - sc(2) )/hx;
+        // sy
+        slopes(i,j,k,3*icomp+1) = 0.5*( sc(4) + sc(2) -sc(1) - sc(3) )/hy;
+        // sxy
+        slopes(i,j,k,3*icomp+2) =     ( sc(1) + sc(4) -sc(2) - sc(3) )/(hx*hy);
+    }
+}
 
-            // iterative loop
-            for(int ll=1; ll<=3; ++ll){
-
-               // compute the amount by which the average of the nodal values differs from cell-center value
-               sumloc = 0.25*(sc(4) + sc(3) + sc(2) + sc(1));
-               sumdif = (sumloc - s(i,j,k,icomp))*4.0;
-
-               // sgndif = +(-)1 if the node average is too large(small)
-               sgndif = std::copysign(1.0,sumdif);
-
-               // compute how much each node is larger(smaller) than the cell-centered value
-               for(int mm=1; mm<=4; ++mm){
-                  diff(mm) = (sc(mm) - s(i,j,k,icomp))*sgndif;
-               }
-
-               kdp = 0;
-
-               // count how many nodes are larger(smaller) than the cell-centered value
-               for(int mm=1; mm<=4; ++mm){
-                  if (diff(mm) > eps && allow_change(mm)) {
-                     kdp = kdp+1;
-                  }
-               }
-
-               // adjust node values
-               for(int mm=1; mm<=4; ++mm){
-
-                  // don't allow boundary nodes to change value
-                  if (!allow_change(mm)) continue;
-
-                  // how many node values are left to potentially adjust
-                  if (kdp<1) {
-                     div = 1.0;
-                  } else {
-                     div = kdp;
-                  }
-
-                  // if the node needs adjusting, figure out by how much the remaining sum is divy'ed up
-                  if (diff(mm)>eps) {
-                     redfac = sumdif*sgndif/div;
-                     kdp = kdp-1;
-                  } else {
-                     redfac = 0.0;
-                  }
-
-                  // don't let the adjustment introduce any new extrema
-                  if (sgndif > 0.0) {
-                     redmax = sc(mm) - smin(mm);
-                  } else {
-                     redmax = smax(mm) - sc(mm);
-                  }
-                  redfac = amrex::min(redfac,redmax);
-
-                  // adjust nodal value and decrement the excess
-                  sumdif = sumdif - redfac*sgndif;
-                  sc(mm) = sc(mm) - redfac*sgndif;
-               }
+/**
+ * Compute bilinear slopes for BDS algorithm.
+ *
+ * \param [in]  bx      Current grid patch
+ * \param [in]  geom    Level geometry.
+ * \param [in]  ncomp   Number of components of the state Array4.
+ * \param [in]  s       Array4<const> of state vector.
+ * \param [out] slopes  Array4 to store slope information, 3 components per state component.
+ * \param [in]  pbc     Boundary conditions.
+ * \param [in]  fuse_nodes  If true, interpolate the node values on the fly instead of
+ *                          storing them in a nodal temporary.
+ *
+ */
+
+void
+BDS::ComputeSlopes ( Box const& bx,
+                     const Geometry& geom,
+                     int ncomp,
+                     Array4<Real const> const& s,
+                     Array4<Real      > const& slopes,
+                     BCRec const* pbc,
+                     bool fuse_nodes)
+{
+    Box const& gbx = amrex::grow(bx,1);
+    GpuArray<Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
+
+    Box const& domain = geom.Domain();
+    const auto dlo = amrex::lbound(domain);
+    const auto dhi = amrex::ubound(domain);
+
+    for (int icomp = 0; icomp < ncomp; ++icomp)
+    {
+        auto bc = pbc[icomp];
+
+        // Abort for cell-centered BC types
+        if ( bc.lo(0) == BCType::reflect_even || bc.lo(0) == BCType::reflect_odd || bc.lo(0) == BCType::hoextrapcc ||
+             bc.hi(0) == BCType::reflect_even || bc.hi(0) == BCType::reflect_odd || bc.hi(0) == BCType::hoextrapcc ||
+             bc.lo(1) == BCType::reflect_even || bc.lo(1) == BCType::reflect_odd || bc.lo(1) == BCType::hoextrapcc ||
+             bc.hi(1) == BCType::reflect_even || bc.hi(1) == BCType::reflect_odd || bc.hi(1) == BCType::hoextrapcc )
+            amrex::Abort("BDS::Slopes: Unsupported BC type. Supported types are int_dir, ext_dir, foextrap, and hoextrap");
+    }
+
+    if (fuse_nodes)
+    {
+        // Sweep each row of cells along i, keeping the nodes on the low and
+        // high x-faces of the current cell. No nodal temporary is stored, but
+        // each node is interpolated by every row that uses it (up to two rows).
+        int const ilo = gbx.smallEnd(0);
+        int const ihi = gbx.bigEnd(0);
+        Box rowbx = gbx;
+        rowbx.setBig(0, ilo);
+
+        ParallelFor(rowbx, ncomp, [=] AMREX_GPU_DEVICE (int, int j, int k, int icomp)
+        {
+            auto const bc = pbc[icomp];
+
+            Real w[2][2];
+            for (int jj = 0; jj <= 1; ++jj) {
+                w[0][jj] = node_value(ilo,j+jj,k,icomp,s,bc,dlo,dhi);
             }
 
-            // final slopes
-            // sx
-            slopes(i,j,k,0) = 0.5*( sc(4) + sc(3) -sc(1) - sc(2) )/hx;
-            // sy
-            slopes(i,j,k,1) = 0.5*( sc(4) + sc(2) -sc(1) - sc(3) )/hy;
-            // sxy
-            slopes(i,j,k,2) =     ( sc(1) + sc(4) -sc(2) - sc(3) )/(hx*hy);
-        }
-    });
+            for (int i = ilo; i <= ihi; ++i)
+            {
+                for (int jj = 0; jj <= 1; ++jj) {
+                    w[1][jj] = node_value(i+1,j+jj,k,icomp,s,bc,dlo,dhi);
+                }
+
+                limited_slopes(i, j, k, icomp, [&] (int ii, int jj) { return w[ii][jj]; },
+                               s, slopes, bc, dlo, dhi, dx);
+
+                for (int jj = 0; jj <= 1; ++jj) {
+                    w[0][jj] = w[1][jj];
+                }
+            }
+        });
+    }
+    else
+    {
+        // Define container for the nodal interpolated state
+        Box const& ngbx = amrex::grow(amrex::convert(bx,IntVect(AMREX_D_DECL(1,1,1))),1);
+        FArrayBox tmpnodefab(ngbx,ncomp);
+        Elixir tmpeli = tmpnodefab.elixir();
+        auto const& sint = tmpnodefab.array();
+
+        // bicubic interpolation to corner points
+        // (i,j,k) refers to lower corner of cell
+        ParallelFor(ngbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp)
+        {
+            sint(i,j,k,icomp) = node_value(i,j,k,icomp,s,pbc[icomp],dlo,dhi);
+        });
+
+        ParallelFor(gbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp)
+        {
+            limited_slopes(i, j, k, icomp, [&] (int ii, int jj) { return sint(i+ii,j+jj,k,icomp); },
+                           s, slopes, pbc[icomp], dlo, dhi, dx);
+        });
+    }
 }
 
 /**
@@ -327,7 +445,7 @@ Real eval (const Real s,
  *
  * \param [in]     bx          Current grid patch
  * \param [in]     geom        Level geometry.
- * \param [in]     icomp       Component of the Array4s.
+ * \param [in]     ncomp       Number of components to work on.
  * \param [in]     s           Array4 of state.
  * \param [in,out] sedgex      Array4 containing x-edges.
  * \param [in,out] sedgey      Array4 containing y-edges.
@@ -346,7 +464,7 @@ Real eval (const Real s,
 void
 BDS::ComputeConc (Box const& bx,
                   const Geometry& geom,
-                  int icomp,
+                  int ncomp,
                   Array4<Real const> const& s,
                   Array4<Real      > const& sedgex,
                   Array4<Real      > const& sedgey,
@@ -379,13 +497,7 @@ BDS::ComputeConc (Box const& bx,
     const auto dlo = amrex::lbound(domain);
     const auto dhi = amrex::ubound(domain);
 
-    auto bc = pbc[icomp];
-    bool lo_x_physbc = (bc.lo(0) == BCType::foextrap || bc.lo(0) == BCType::hoextrap || bc.lo(0) == BCType::ext_dir) ? true : false;
-    bool hi_x_physbc = (bc.hi(0) == BCType::foextrap || bc.hi(0) == BCType::hoextrap || bc.hi(0) == BCType::ext_dir) ? true : false;
-    bool lo_y_physbc = (bc.lo(1) == BCType::foextrap || bc.lo(1) == BCType::hoextrap || bc.lo(1) == BCType::ext_dir) ? true : false;
-    bool hi_y_physbc = (bc.hi(1) == BCType::foextrap || bc.hi(1) == BCType::hoextrap || bc.hi(1) == BCType::ext_dir) ? true : false;
-
-    // compute cell-centered ux, vy
+    // compute cell-centered ux, vy, shared by all components
     ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
         ux(i,j,k) = (umac(i+1,j,k) - umac(i,j,k)) / hx;
         vy(i,j,k) = (vmac(i,j+1,k) - vmac(i,j,k)) / hy;
@@ -393,7 +505,11 @@ BDS::ComputeConc (Box const& bx,
 
     // compute sedgex on x-faces
     Box const& xbx = amrex::surroundingNodes(bx,0);
-    ParallelFor(xbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
+    ParallelFor(xbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp){
+
+        auto const bc = pbc[icomp];
+        bool lo_x_physbc = (bc.lo(0) == BCType::foextrap || bc.lo(0) == BCType::hoextrap || bc.lo(0) == BCType::ext_dir) ? true : false;
+        bool hi_x_physbc = (bc.hi(0) == BCType::foextrap || bc.hi(0) == BCType::hoextrap || bc.hi(0) == BCType::ext_dir) ? true : false;
 
         // set edge values equal to the ghost cell value since they store the physical condition on the boundary
         if ( i==dlo.x && lo_x_physbc ) {
@@ -447,7 +563,7 @@ BDS::ComputeConc (Box const& bx,
         }
 
         for(int n=1; n<=3; ++n){
-            slope_tmp(n) = slopes(i+ioff,j,k,n-1);
+            slope_tmp(n) = slopes(i+ioff,j,k,3*icomp+n-1);
         }
 
         // centroid of rectangular volume
@@ -492,7 +608,7 @@ BDS::ComputeConc (Box const& bx,
         p3(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k)*dt;
 
         for(int n=1; n<=3; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k,n-1);
+            slope_tmp(n) = slopes(i+ioff,j+joff,k,3*icomp+n-1);
         }
 
         for (int ll=1; ll<=2; ++ll) {
@@ -553,7 +669,7 @@ BDS::ComputeConc (Box const& bx,
         p3(2) = jsign*0.5*hy - vmac(i+ioff,j,k)*dt;
 
         for(int n=1; n<=3; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k,n-1);
+            slope_tmp(n) = slopes(i+ioff,j+joff,k,3*icomp+n-1);
         }
 
         for (int ll=1; ll<=2; ++ll) {
@@ -589,7 +705,11 @@ BDS::ComputeConc (Box const& bx,
 
     // compute sedgey on y-faces
     Box const& ybx = amrex::surroundingNodes(bx,1);
-    ParallelFor(ybx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
+    ParallelFor(ybx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp){
+
+        auto const bc = pbc[icomp];
+        bool lo_y_physbc = (bc.lo(1) == BCType::foextrap || bc.lo(1) == BCType::hoextrap || bc.lo(1) == BCType::ext_dir) ? true : false;
+        bool hi_y_physbc = (bc.hi(1) == BCType::foextrap || bc.hi(1) == BCType::hoextrap || bc.hi(1) == BCType::ext_dir) ? true : false;
 
         // set edge values equal to the ghost cell value since they store the physical condition on the boundary
         if ( j==dlo.y && lo_y_physbc ) {
@@ -640,7 +760,7 @@ BDS::ComputeConc (Box const& bx,
         }
 
         for(int n=1; n<=3; ++n){
-            slope_tmp(n) = slopes(i,j+joff,k,n-1);
+            slope_tmp(n) = slopes(i,j+joff,k,3*icomp+n-1);
         }
 
         del(1) = 0.;
@@ -684,7 +804,7 @@ BDS::ComputeConc (Box const& bx,
         p3(2) = jsign*0.5*hy - v*dt;
 
         for(int n=1; n<=3; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k,n-1);
+            slope_tmp(n) = slopes(i+ioff,j+joff,k,3*icomp+n-1);
         }
 
         for (int ll=1; ll<=2; ++ll) {
@@ -744,7 +864,7 @@ BDS::ComputeConc (Box const& bx,
         p3(2) = jsign*0.5*hy - v*dt;
 
         for(int n=1; n<=3; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k,n-1);
+            slope_tmp(n) = slopes(i+ioff,j+joff,k,3*icomp+n-1);
         }
 
         for (int ll=1; ll<=2; ++ll) {
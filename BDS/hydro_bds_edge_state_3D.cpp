@@ -51,80 +51,169 @@ BDS::ComputeEdgeState ( Box const& bx, int ncomp,
                         BCRec const* pbc, int const* iconserv,
                         const bool is_velocity)
 {
-    // For now, loop on components here
-    for( int icomp = 0; icomp < ncomp; ++icomp)
-    {
-        // Temporary slope container per components
-        Box const& bxg1 = amrex::grow(bx,1);
-        FArrayBox slopefab(bxg1,7);
-        Elixir slopeeli = slopefab.elixir();
-
-        BDS::ComputeSlopes(bx, geom, icomp,
-                           q, slopefab.array(),
-                           pbc);
-
-        BDS::ComputeConc(bx, geom, icomp,
-                         q, xedge, yedge, zedge,
-                         slopefab.array(),
-                         umac, vmac, wmac, divu, fq,
-                         iconserv,
-                         l_dt, pbc, is_velocity);
-    }
+    // Slopes of all components, 7 per component
+    Box const& bxg1 = amrex::grow(bx,1);
+    FArrayBox slopefab(bxg1,7*ncomp);
+    Elixir slopeeli = slopefab.elixir();
+
+    BDS::ComputeSlopes(bx, geom, ncomp,
+                       q, slopefab.array(),
+                       pbc);
+
+    BDS::ComputeEdgeState(bx, ncomp, q,
+                          AMREX_D_DECL(xedge, yedge, zedge),
+                          AMREX_D_DECL(umac, vmac, wmac),
+                          divu, fq, geom, l_dt, pbc, iconserv,
+                          is_velocity, slopefab.const_array());
 }
 
 /**
- * Compute bilinear slopes for BDS algorithm.
- *
- * \param [in]  bx      Current grid patch
- * \param [in]  geom    Level geometry.
- * \param [in]  icomp   Component of the state Array4.
- * \param [in]  s       Array4<const> of state vector.
- * \param [out] slopes  Array4 to store slope information.
+ * Computes BDS edge states from slopes already computed by ComputeSlopes.
  *
+ * \param [in]     slopes      Array4 of the slopes of q on the box grown by 1,
+ *                             7 components per state component.
  */
 
 void
-BDS::ComputeSlopes ( Box const& bx,
-                     const Geometry& geom,
-                     int icomp,
-                     Array4<Real const> const& s,
-                     Array4<Real      > const& slopes,
-                     BCRec const* pbc)
+BDS::ComputeEdgeState ( Box const& bx, int ncomp,
+                        Array4<Real const> const& q,
+                        Array4<Real      > const& xedge,
+                        Array4<Real      > const& yedge,
+                        Array4<Real      > const& zedge,
+                        Array4<Real const> const& umac,
+                        Array4<Real const> const& vmac,
+                        Array4<Real const> const& wmac,
+                        Array4<Real const> const& divu,
+                        Array4<Real const> const& fq,
+                        Geometry geom,
+                        Real l_dt,
+                        BCRec const* pbc, int const* iconserv,
+                        const bool is_velocity,
+                        Array4<Real const> const& slopes)
 {
-    constexpr bool limit_slopes = true;
-
-    // Define container for the nodal interpolated state
-    Box const& ngbx = amrex::grow(amrex::convert(bx,IntVect(AMREX_D_DECL(1,1,1))),1);
-    FArrayBox tmpnodefab(ngbx,1);
-    Elixir tmpeli = tmpnodefab.elixir();
-    auto const& sint = tmpnodefab.array();
-
-    Box const& gbx = amrex::grow(bx,1);
-    GpuArray<Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
+    BDS::ComputeConc(bx, geom, ncomp,
+                     q, xedge, yedge, zedge,
+                     slopes,
+                     umac, vmac, wmac, divu, fq,
+                     iconserv,
+                     l_dt, pbc, is_velocity);
+}
 
-    Real hx = dx[0];
-    Real hy = dx[1];
-    Real hz = dx[2];
+/**
+ * Returns the tricubic interpolant of the state at node (i,j,k), the lower
+ * corner of cell (i,j,k), reverting to lower order next to physical
+ * boundaries.
+ *
+ * \param [in]  i,j,k   Node index.
+ * \param [in]  icomp   Component of the state Array4.
+ * \param [in]  s       Array4<const> of state vector.
+ * \param [in]  bc      Boundary conditions of component icomp.
+ * \param [in]  dlo     Lower corner of the domain.
+ * \param [in]  dhi     Upper corner of the domain.
+ *
+ */
 
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real node_value (int i, int j, int k, int icomp,
+                 Array4<Real const> const& s, BCRec const& bc,
+                 Dim3 const& dlo, Dim3 const& dhi)
+{
     Real c1 = (343.0/1728.0);
     Real c2 = (49.0 /1728.0);
     Real c3 = (7.0  /1728.0);
     Real c4 = (1.0  /1728.0);
 
-    Box const& domain = geom.Domain();
-    const auto dlo = amrex::lbound(domain);
-    const auto dhi = amrex::ubound(domain);
+    bool lo_x_physbc = (bc.lo(0) == BCType::foextrap || bc.lo(0) == BCType::hoextrap || bc.lo(0) == BCType::ext_dir) ? true : false;
+    bool hi_x_physbc = (bc.hi(0) == BCType::foextrap || bc.hi(0) == BCType::hoextrap || bc.hi(0) == BCType::ext_dir) ? true : false;
+    bool lo_y_physbc = (bc.lo(1) == BCType::foextrap || bc.lo(1) == BCType::hoextrap || bc.lo(1) == BCType::ext_dir) ? true : false;
+    bool hi_y_physbc = (bc.hi(1) == BCType::foextrap || bc.hi(1) == BCType::hoextrap || bc.hi(1) == BCType::ext_dir) ? true : false;
+    bool lo_z_physbc = (bc.lo(2) == BCType::foextrap || bc.lo(2) == BCType::hoextrap || bc.lo(2) == BCType::ext_dir) ? true : false;
+    bool hi_z_physbc = (bc.hi(2) == BCType::foextrap || bc.hi(2) == BCType::hoextrap || bc.hi(2) == BCType::ext_dir) ? true : false;
+
+    // set node values equal to the average of the ghost cell values since they store the physical condition on the boundary
+    if ( i<=dlo.x && lo_x_physbc ) {
+        return 0.25*(s(dlo.x-1,j,k,icomp) + s(dlo.x-1,j-1,k,icomp) + s(dlo.x-1,j,k-1,icomp) + s(dlo.x-1,j-1,k-1,icomp));
+    }
+    if ( i>=dhi.x+1 && hi_x_physbc ) {
+        return 0.25*(s(dhi.x+1,j,k,icomp) + s(dhi.x+1,j-1,k,icomp) + s(dhi.x+1,j,k-1,icomp) + s(dhi.x+1,j-1,k-1,icomp));
+    }
+    if ( j<=dlo.y && lo_y_physbc ) {
+        return 0.25*(s(i,dlo.y-1,k,icomp) + s(i-1,dlo.y-1,k,icomp) + s(i,dlo.y-1,k-1,icomp) + s(i-1,dlo.y-1,k-1,icomp));
+    }
+    if ( j>=dhi.y+1 && hi_y_physbc ) {
+        return 0.25*(s(i,dhi.y+1,k,icomp) + s(i-1,dhi.y+1,k,icomp) + s(i,dhi.y+1,k-1,icomp) + s(i-1,dhi.y+1,k-1,icomp));
+    }
+    if ( k<=dlo.z && lo_z_physbc ) {
+        return 0.25*(s(i,j,dlo.z-1,icomp) + s(i-1,j,dlo.z-1,icomp) + s(i,j-1,dlo.z-1,icomp) + s(i-1,j-1,dlo.z-1,icomp));
+    }
+    if ( k>=dhi.z+1 && hi_z_physbc ) {
+        return 0.25*(s(i,j,dhi.z+1,icomp) + s(i-1,j,dhi.z+1,icomp) + s(i,j-1,dhi.z+1,icomp) + s(i-1,j-1,dhi.z+1,icomp));
+    }
+
+    // one cell inward from any physical boundary, revert to 8-point average
+    if ( (i==dlo.x+1 && lo_x_physbc) ||
+         (i==dhi.x   && hi_x_physbc) ||
+         (j==dlo.y+1 && lo_y_physbc) ||
+         (j==dhi.y   && hi_y_physbc) ||
+         (k==dlo.z+1 && lo_z_physbc) ||
+         (k==dhi.z   && hi_z_physbc) ) {
+
+        return 0.125* (s(i,j,k  ,icomp) + s(i-1,j,k  ,icomp) + s(i,j-1,k  ,icomp) + s(i-1,j-1,k  ,icomp) +
+                              s(i,j,k-1,icomp) + s(i-1,j,k-1,icomp) + s(i,j-1,k-1,icomp) + s(i-1,j-1,k-1,icomp));
+    }
+
+    return c1*( s(i  ,j  ,k  ,icomp) + s(i-1,j  ,k  ,icomp) + s(i  ,j-1,k  ,icomp)
+                      +s(i  ,j  ,k-1,icomp) + s(i-1,j-1,k  ,icomp) + s(i-1,j  ,k-1,icomp)
+                      +s(i  ,j-1,k-1,icomp) + s(i-1,j-1,k-1,icomp) )
+                 -c2*( s(i-1,j  ,k+1,icomp) + s(i  ,j  ,k+1,icomp) + s(i-1,j-1,k+1,icomp)
+                      +s(i  ,j-1,k+1,icomp) + s(i-1,j+1,k  ,icomp) + s(i  ,j+1,k  ,icomp)
+                      +s(i-2,j  ,k  ,icomp) + s(i+1,j  ,k  ,icomp) + s(i-2,j-1,k  ,icomp)
+                      +s(i+1,j-1,k  ,icomp) + s(i-1,j-2,k  ,icomp) + s(i  ,j-2,k  ,icomp)
+                      +s(i-1,j+1,k-1,icomp) + s(i  ,j+1,k-1,icomp) + s(i-2,j  ,k-1,icomp)
+                      +s(i+1,j  ,k-1,icomp) + s(i-2,j-1,k-1,icomp) + s(i+1,j-1,k-1,icomp)
+                      +s(i-1,j-2,k-1,icomp) + s(i  ,j-2,k-1,icomp) + s(i-1,j  ,k-2,icomp)
+                      +s(i  ,j  ,k-2,icomp) + s(i-1,j-1,k-2,icomp) + s(i  ,j-1,k-2,icomp) )
+                 +c3*( s(i-1,j+1,k+1,icomp) + s(i  ,j+1,k+1,icomp) + s(i-2,j  ,k+1,icomp)
+                      +s(i+1,j  ,k+1,icomp) + s(i-2,j-1,k+1,icomp) + s(i+1,j-1,k+1,icomp)
+                      +s(i-1,j-2,k+1,icomp) + s(i  ,j-2,k+1,icomp) + s(i-2,j+1,k  ,icomp)
+                      +s(i+1,j+1,k  ,icomp) + s(i-2,j-2,k  ,icomp) + s(i+1,j-2,k  ,icomp)
+                      +s(i-2,j+1,k-1,icomp) + s(i+1,j+1,k-1,icomp) + s(i-2,j-2,k-1,icomp)
+                      +s(i+1,j-2,k-1,icomp) + s(i-1,j+1,k-2,icomp) + s(i  ,j+1,k-2,icomp)
+                      +s(i-2,j  ,k-2,icomp) + s(i+1,j  ,k-2,icomp) + s(i-2,j-1,k-2,icomp)
+                      +s(i+1,j-1,k-2,icomp) + s(i-1,j-2,k-2,icomp) + s(i  ,j-2,k-2,icomp) )
+                 -c4*( s(i-2,j+1,k+1,icomp) + s(i+1,j+1,k+1,icomp) + s(i-2,j-2,k+1,icomp)
+                      +s(i+1,j-2,k+1,icomp) + s(i-2,j+1,k-2,icomp) + s(i+1,j+1,k-2,icomp)
+                      +s(i-2,j-2,k-2,icomp) + s(i+1,j-2,k-2,icomp) );
+}
+
+/**
+ * Computes the limited slopes of cell (i,j,k) from the eight node values
+ * at its corners, nd(ii,jj,kk) being the value at node (i+ii,j+jj,k+kk).
+ *
+ * \param [in]  i,j,k   Cell index.
+ * \param [in]  icomp   Component of the state Array4.
+ * \param [in]  nd      Node values at the corners of the cell.
+ * \param [in]  s       Array4<const> of state vector.
+ * \param [out] slopes  Array4 to store slope information, 7 components per state component.
+ * \param [in]  bc      Boundary conditions of component icomp.
+ * \param [in]  dlo     Lower corner of the domain.
+ * \param [in]  dhi     Upper corner of the domain.
+ * \param [in]  dx      Cell size.
+ *
+ */
 
-    auto bc = pbc[icomp];
+template <typename N>
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void limited_slopes (int i, int j, int k, int icomp, N const& nd,
+                     Array4<Real const> const& s, Array4<Real> const& slopes,
+                     BCRec const& bc, Dim3 const& dlo, Dim3 const& dhi,
+                     GpuArray<Real,AMREX_SPACEDIM> const& dx)
+{
+    constexpr bool limit_slopes = true;
 
-    // Abort for cell-centered BC types
-    if ( bc.lo(0) == BCType::reflect_even || bc.lo(0) == BCType::reflect_odd || bc.lo(0) == BCType::hoextrapcc ||
-         bc.hi(0) == BCType::reflect_even || bc.hi(0) == BCType::reflect_odd || bc.hi(0) == BCType::hoextrapcc ||
-         bc.lo(1) == BCType::reflect_even || bc.lo(1) == BCType::reflect_odd || bc.lo(1) == BCType::hoextrapcc ||
-         bc.hi(1) == BCType::reflect_even || bc.hi(1) == BCType::reflect_odd || bc.hi(1) == BCType::hoextrapcc ||
-         bc.lo(2) == BCType::reflect_even || bc.lo(2) == BCType::reflect_odd || bc.lo(2) == BCType::hoextrapcc ||
-         bc.hi(2) == BCType::reflect_even || bc.hi(2) == BCType::reflect_odd || bc.hi(2) == BCType::hoextrapcc )
-        amrex::Abort("BDS::Slopes: Unsupported BC type. Supported types are int_dir, ext_dir, foextrap, and hoextrap");
+    Real hx = dx[0];
+    Real hy = dx[1];
+    Real hz = dx[2];
 
     bool lo_x_physbc = (bc.lo(0) == BCType::foextrap || bc.lo(0) == BCType::hoextrap || bc.lo(0) == BCType::ext_dir) ? true : false;
     bool hi_x_physbc = (bc.hi(0) == BCType::foextrap || bc.hi(0) == BCType::hoextrap || bc.hi(0) == BCType::ext_dir) ? true : false;
@@ -133,395 +222,621 @@ BDS::ComputeSlopes ( Box const& bx,
     bool lo_z_physbc = (bc.lo(2) == BCType::foextrap || bc.lo(2) == BCType::hoextrap || bc.lo(2) == BCType::ext_dir) ? true : false;
     bool hi_z_physbc = (bc.hi(2) == BCType::foextrap || bc.hi(2) == BCType::hoextrap || bc.hi(2) == BCType::ext_dir) ? true : false;
 
-    // tricubic interpolation to corner points
-    // (i,j,k) refers to lower corner of cell
-    ParallelFor(ngbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
+    // compute initial estimates of slopes from unlimited corner points
 
-        // set node values equal to the average of the ghost cell values since they store the physical condition on the boundary
-        if ( i<=dlo.x && lo_x_physbc ) {
-            sint(i,j,k) = 0.25*(s(dlo.x-1,j,k,icomp) + s(dlo.x-1,j-1,k,icomp) + s(dlo.x-1,j,k-1,icomp) + s(dlo.x-1,j-1,k-1,icomp));
-            return;
-        }
-        if ( i>=dhi.x+1 && hi_x_physbc ) {
-            sint(i,j,k) = 0.25*(s(dhi.x+1,j,k,icomp) + s(dhi.x+1,j-1,k,icomp) + s(dhi.x+1,j,k-1,icomp) + s(dhi.x+1,j-1,k-1,icomp));
-            return;
-        }
-        if ( j<=dlo.y && lo_y_physbc ) {
-            sint(i,j,k) = 0.25*(s(i,dlo.y-1,k,icomp) + s(i-1,dlo.y-1,k,icomp) + s(i,dlo.y-1,k-1,icomp) + s(i-1,dlo.y-1,k-1,icomp));
-            return;
-        }
-        if ( j>=dhi.y+1 && hi_y_physbc ) {
-            sint(i,j,k) = 0.25*(s(i,dhi.y+1,k,icomp) + s(i-1,dhi.y+1,k,icomp) + s(i,dhi.y+1,k-1,icomp) + s(i-1,dhi.y+1,k-1,icomp));
-            return;
-        }
-        if ( k<=dlo.z && lo_z_physbc ) {
-            sint(i,j,k) = 0.25*(s(i,j,dlo.z-1,icomp) + s(i-1,j,dlo.z-1,icomp) + s(i,j-1,dlo.z-1,icomp) + s(i-1,j-1,dlo.z-1,icomp));
-            return;
-        }
-        if ( k>=dhi.z+1 && hi_z_physbc ) {
-            sint(i,j,k) = 0.25*(s(i,j,dhi.z+1,icomp) + s(i-1,j,dhi.z+1,icomp) + s(i,j-1,dhi.z+1,icomp) + s(i-1,j-1,dhi.z+1,icomp));
-            return;
-        }
+    // local variables
+    Real sumloc, redfac, redmax, div, kdp, sumdif, sgndif;
 
-        // one cell inward from any physical boundary, revert to 8-point average
-        if ( (i==dlo.x+1 && lo_x_physbc) ||
-             (i==dhi.x   && hi_x_physbc) ||
-             (j==dlo.y+1 && lo_y_physbc) ||
-             (j==dhi.y   && hi_y_physbc) ||
-             (k==dlo.z+1 && lo_z_physbc) ||
-             (k==dhi.z   && hi_z_physbc) ) {
-
-            sint(i,j,k) = 0.125* (s(i,j,k  ,icomp) + s(i-1,j,k  ,icomp) + s(i,j-1,k  ,icomp) + s(i-1,j-1,k  ,icomp) +
-                                  s(i,j,k-1,icomp) + s(i-1,j,k-1,icomp) + s(i,j-1,k-1,icomp) + s(i-1,j-1,k-1,icomp));
-            return;
-        }
+    // Variables local to this loop
+    Array1D<Real, 1, 8> diff;
+    Array1D<Real, 1, 8> smin;
+    Array1D<Real, 1, 8> smax;
+    Array1D<Real, 1, 8> sc;
 
-        sint(i,j,k) = c1*( s(i  ,j  ,k  ,icomp) + s(i-1,j  ,k  ,icomp) + s(i  ,j-1,k  ,icomp)
-                          +s(i  ,j  ,k-1,icomp) + s(i-1,j-1,k  ,icomp) + s(i-1,j  ,k-1,icomp)
-                          +s(i  ,j-1,k-1,icomp) + s(i-1,j-1,k-1,icomp) )
-                     -c2*( s(i-1,j  ,k+1,icomp) + s(i  ,j  ,k+1,icomp) + s(i-1,j-1,k+1,icomp)
-                          +s(i  ,j-1,k+1,icomp) + s(i-1,j+1,k  ,icomp) + s(i  ,j+1,k  ,icomp)
-                          +s(i-2,j  ,k  ,icomp) + s(i+1,j  ,k  ,icomp) + s(i-2,j-1,k  ,icomp)
-                          +s(i+1,j-1,k  ,icomp) + s(i-1,j-2,k  ,icomp) + s(i  ,j-2,k  ,icomp)
-                          +s(i-1,j+1,k-1,icomp) + s(i  ,j+1,k-1,icomp) + s(i-2,j  ,k-1,icomp)
-                          +s(i+1,j  ,k-1,icomp) + s(i-2,j-1,k-1,icomp) + s(i+1,j-1,k-1,icomp)
-                          +s(i-1,j-2,k-1,icomp) + s(i  ,j-2,k-1,icomp) + s(i-1,j  ,k-2,icomp)
-                          +s(i  ,j  ,k-2,icomp) + s(i-1,j-1,k-2,icomp) + s(i  ,j-1,k-2,icomp) )
-                     +c3*( s(i-1,j+1,k+1,icomp) + s(i  ,j+1,k+1,icomp) + s(i-2,j  ,k+1,icomp)
-                          +s(i+1,j  ,k+1,icomp) + s(i-2,j-1,k+1,icomp) + s(i+1,j-1,k+1,icomp)
-                          +s(i-1,j-2,k+1,icomp) + s(i  ,j-2,k+1,icomp) + s(i-2,j+1,k  ,icomp)
-                          +s(i+1,j+1,k  ,icomp) + s(i-2,j-2,k  ,icomp) + s(i+1,j-2,k  ,icomp)
-                          +s(i-2,j+1,k-1,icomp) + s(i+1,j+1,k-1,icomp) + s(i-2,j-2,k-1,icomp)
-                          +s(i+1,j-2,k-1,icomp) + s(i-1,j+1,k-2,icomp) + s(i  ,j+1,k-2,icomp)
-                          +s(i-2,j  ,k-2,icomp) + s(i+1,j  ,k-2,icomp) + s(i-2,j-1,k-2,icomp)
-                          +s(i+1,j-1,k-2,icomp) + s(i-1,j-2,k-2,icomp) + s(i  ,j-2,k-2,icomp) )
-                     -c4*( s(i-2,j+1,k+1,icomp) + s(i+1,j+1,k+1,icomp) + s(i-2,j-2,k+1,icomp)
-                          +s(i+1,j-2,k+1,icomp) + s(i-2,j+1,k-2,icomp) + s(i+1,j+1,k-2,icomp)
-                          +s(i-2,j-2,k-2,icomp) + s(i+1,j-2,k-2,icomp) );
-    });
+    Array1D<bool, 1, 8> allow_change;
+    for (int mm=1; mm<=8; ++mm) {
+        allow_change(mm) = true;
+    }
 
-    ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
-        // compute initial estimates of slopes from unlimited corner points
+    if ( i==dlo.x && lo_x_physbc ) {
+        allow_change(1) = false;
+        allow_change(2) = false;
+        allow_change(3) = false;
+        allow_change(4) = false;
+    }
+    if ( i==dhi.x+1 && hi_x_physbc ) {
+        allow_change(5) = false;
+        allow_change(6) = false;
+        allow_change(7) = false;
+        allow_change(8) = false;
+    }
+    if ( j==dlo.y && lo_y_physbc ) {
+        allow_change(1) = false;
+        allow_change(2) = false;
+        allow_change(5) = false;
+        allow_change(6) = false;
+    }
+    if ( j==dhi.y+1 && hi_y_physbc ) {
+        allow_change(3) = false;
+        allow_change(4) = false;
+        allow_change(7) = false;
+        allow_change(8) = false;
+    }
+    if ( k==dlo.z && lo_z_physbc ) {
+        allow_change(1) = false;
+        allow_change(3) = false;
+        allow_change(5) = false;
+        allow_change(7) = false;
+    }
+    if ( k==dhi.z+1 && hi_z_physbc ) {
+        allow_change(2) = false;
+        allow_change(4) = false;
+        allow_change(6) = false;
+        allow_change(8) = false;
+    }
 
-        // local variables
-        Real sumloc, redfac, redmax, div, kdp, sumdif, sgndif;
+     // compute initial estimates of slopes from unlimited corner points
+     // sx
+     slopes(i,j,k,7*icomp+0) = 0.25*(( nd(1,0,0) + nd(1,1,0)
+                              +nd(1,0,1) + nd(1,1,1) )
+                            -( nd(0,0,0) + nd(0,1,0)
+                              +nd(0,0,1) + nd(0,1,1) )) / hx;
+     // sy
+     slopes(i,j,k,7*icomp+1) = 0.25*(( nd(0,1,0) + nd(1,1,0)
+                              +nd(0,1,1) + nd(1,1,1) )
+                            -( nd(0,0,0) + nd(1,0,0)
+                              +nd(0,0,1) + nd(1,0,1) )) / hy;
+
+     // sz
+     slopes(i,j,k,7*icomp+2) = 0.25*(( nd(0,0,1) + nd(1,0,1)
+                              +nd(0,1,1) + nd(1,1,1) )
+                            -( nd(0,0,0) + nd(1,0,0)
+                              +nd(0,1,0) + nd(1,1,0) )) / hz;
+
+     // sxy
+     slopes(i,j,k,7*icomp+3) = 0.5*( ( nd(0,0,0) + nd(0,0,1)
+                              +nd(1,1,0) + nd(1,1,1) )
+                            -( nd(1,0,0) + nd(1,0,1)
+                              +nd(0,1,0) + nd(0,1,1) )) / (hx*hy);
+
+     // sxz
+     slopes(i,j,k,7*icomp+4) = 0.5*( ( nd(0,0,0) + nd(0,1,0)
+                              +nd(1,0,1) + nd(1,1,1) )
+                            -( nd(1,0,0) + nd(1,1,0)
+                              +nd(0,0,1) + nd(0,1,1) )) / (hx*hz);
+
+     // syz
+     slopes(i,j,k,7*icomp+5) = 0.5*( ( nd(0,0,0) + nd(1,0,0)
+                              +nd(0,1,1) + nd(1,1,1) )
+                            -( nd(0,0,1) + nd(1,0,1)
+                              +nd(0,1,0) + nd(1,1,0) )) / (hy*hz);
+
+     // sxyz
+     slopes(i,j,k,7*icomp+6) =       (-nd(0,0,0) + nd(1,0,0) + nd(0,1,0)
+                              +nd(0,0,1) - nd(1,1,0) - nd(1,0,1)
+                              -nd(0,1,1) + nd(1,1,1) ) / (hx*hy*hz);
+
+     if (limit_slopes) {
+
+         // +++ / nd(1,1,1)
+         sc(8) = s(i,j,k,icomp)
+              +0.5  *(     hx*slopes(i,j,k,7*icomp+0)+   hy*slopes(i,j,k,7*icomp+1)+   hz*slopes(i,j,k,7*icomp+2))
+              +0.25 *(  hx*hy*slopes(i,j,k,7*icomp+3)+hx*hz*slopes(i,j,k,7*icomp+4)+hy*hz*slopes(i,j,k,7*icomp+5))
+              +0.125*hx*hy*hz*slopes(i,j,k,7*icomp+6);
+
+         // ++- / nd(1,1,0)
+         sc(7) = s(i,j,k,icomp)
+              +0.5  *(     hx*slopes(i,j,k,7*icomp+0)+   hy*slopes(i,j,k,7*icomp+1)-   hz*slopes(i,j,k,7*icomp+2))
+              +0.25 *(  hx*hy*slopes(i,j,k,7*icomp+3)-hx*hz*slopes(i,j,k,7*icomp+4)-hy*hz*slopes(i,j,k,7*icomp+5))
+              -0.125*hx*hy*hz*slopes(i,j,k,7*icomp+6);
+
+         // +-+ / nd(1,0,1)
+         sc(6) = s(i,j,k,icomp)
+              +0.5  *(     hx*slopes(i,j,k,7*icomp+0)-   hy*slopes(i,j,k,7*icomp+1)+   hz*slopes(i,j,k,7*icomp+2))
+              +0.25 *( -hx*hy*slopes(i,j,k,7*icomp+3)+hx*hz*slopes(i,j,k,7*icomp+4)-hy*hz*slopes(i,j,k,7*icomp+5))
+              -0.125*hx*hy*hz*slopes(i,j,k,7*icomp+6);
+
+         // +-- / nd(1,0,0)
+         sc(5) = s(i,j,k,icomp)
+              +0.5  *(     hx*slopes(i,j,k,7*icomp+0)-   hy*slopes(i,j,k,7*icomp+1)-   hz*slopes(i,j,k,7*icomp+2))
+              +0.25 *( -hx*hy*slopes(i,j,k,7*icomp+3)-hx*hz*slopes(i,j,k,7*icomp+4)+hy*hz*slopes(i,j,k,7*icomp+5))
+              +0.125*hx*hy*hz*slopes(i,j,k,7*icomp+6);
+
+         // -++ / nd(0,1,1)
+         sc(4) = s(i,j,k,icomp)
+              +0.5  *(    -hx*slopes(i,j,k,7*icomp+0)+   hy*slopes(i,j,k,7*icomp+1)+   hz*slopes(i,j,k,7*icomp+2))
+              +0.25 *( -hx*hy*slopes(i,j,k,7*icomp+3)-hx*hz*slopes(i,j,k,7*icomp+4)+hy*hz*slopes(i,j,k,7*icomp+5))
+              -0.125*hx*hy*hz*slopes(i,j,k,7*icomp+6);
+
+         // -+- / nd(0,1,0)
+         sc(3) = s(i,j,k,icomp)
+              +0.5  *(    -hx*slopes(i,j,k,7*icomp+0)+   hy*slopes(i,j,k,7*icomp+1)-   hz*slopes(i,j,k,7*icomp+2))
+              +0.25 *( -hx*hy*slopes(i,j,k,7*icomp+3)+hx*hz*slopes(i,j,k,7*icomp+4)-hy*hz*slopes(i,j,k,7*icomp+5))
+              +0.125*hx*hy*hz*slopes(i,j,k,7*icomp+6);
+
+         // --+ / nd(0,0,1)
+         sc(2) = s(i,j,k,icomp)
+              +0.5  *(    -hx*slopes(i,j,k,7*icomp+0)-   hy*slopes(i,j,k,7*icomp+1)+   hz*slopes(i,j,k,7*icomp+2))
+              +0.25 *(  hx*hy*slopes(i,j,k,7*icomp+3)-hx*hz*slopes(i,j,k,7*icomp+4)-hy*hz*slopes(i,j,k,7*icomp+5))
+              +0.125*hx*hy*hz*slopes(i,j,k,7*icomp+6);
+
+         // ---/ nd(0,0,0)
+         sc(1) = s(i,j,k,icomp)
+              +0.5  *(    -hx*slopes(i,j,k,7*icomp+0)-   hy*slopes(i,j,k,7*icomp+1)-   hz*slopes(i,j,k,7*icomp+2))
+              +0.25 *(  hx*hy*slopes(i,j,k,7*icomp+3)+hx*hz*slopes(i,j,k,7*icomp+4)+hy*hz*slopes(i,j,k,7*icomp+5))
+              -0.125*hx*hy*hz*slopes(i,j,k,7*icomp+6);
+
+         // enforce max/min bounds
+         smin(8) = min(s(i  ,j  ,k  ,icomp),s(i+1,j  ,k  ,icomp),s(i  ,j+1,k  ,icomp),s(i  ,j  ,k+1,icomp),
+                       s(i+1,j+1,k  ,icomp),s(i+1,j  ,k+1,icomp),s(i  ,j+1,k+1,icomp),s(i+1,j+1,k+1,icomp));
+         smax(8) = max(s(i  ,j  ,k  ,icomp),s(i+1,j  ,k  ,icomp),s(i  ,j+1,k  ,icomp),s(i  ,j  ,k+1,icomp),
+                       s(i+1,j+1,k  ,icomp),s(i+1,j  ,k+1,icomp),s(i  ,j+1,k+1,icomp),s(i+1,j+1,k+1,icomp));
+
+         smin(7) = min(s(i  ,j  ,k-1,icomp),s(i+1,j  ,k-1,icomp),s(i  ,j+1,k-1,icomp),s(i  ,j  ,k  ,icomp),
+                       s(i+1,j+1,k-1,icomp),s(i+1,j  ,k  ,icomp),s(i  ,j+1,k  ,icomp),s(i+1,j+1,k  ,icomp));
+         smax(7) = max(s(i  ,j  ,k-1,icomp),s(i+1,j  ,k-1,icomp),s(i  ,j+1,k-1,icomp),s(i  ,j  ,k  ,icomp),
+                       s(i+1,j+1,k-1,icomp),s(i+1,j  ,k  ,icomp),s(i  ,j+1,k  ,icomp),s(i+1,j+1,k  ,icomp));
+
+         smin(6) = min(s(i  ,j-1,k  ,icomp),s(i+1,j-1,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i  ,j-1,k+1,icomp),
+                       s(i+1,j  ,k  ,icomp),s(i+1,j-1,k+1,icomp),s(i  ,j  ,k+1,icomp),s(i+1,j  ,k+1,icomp));
+         smax(6) = max(s(i  ,j-1,k  ,icomp),s(i+1,j-1,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i  ,j-1,k+1,icomp),
+                       s(i+1,j  ,k  ,icomp),s(i+1,j-1,k+1,icomp),s(i  ,j  ,k+1,icomp),s(i+1,j  ,k+1,icomp));
+
+         smin(5) = min(s(i  ,j-1,k-1,icomp),s(i+1,j-1,k-1,icomp),s(i  ,j  ,k-1,icomp),s(i  ,j-1,k  ,icomp),
+                       s(i+1,j  ,k-1,icomp),s(i+1,j-1,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i+1,j  ,k  ,icomp));
+         smax(5) = max(s(i  ,j-1,k-1,icomp),s(i+1,j-1,k-1,icomp),s(i  ,j  ,k-1,icomp),s(i  ,j-1,k  ,icomp),
+                       s(i+1,j  ,k-1,icomp),s(i+1,j-1,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i+1,j  ,k  ,icomp));
+
+         smin(4) = min(s(i-1,j  ,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i-1,j+1,k  ,icomp),s(i-1,j  ,k+1,icomp),
+                       s(i  ,j+1,k  ,icomp),s(i  ,j  ,k+1,icomp),s(i-1,j+1,k+1,icomp),s(i  ,j+1,k+1,icomp));
+         smax(4) = max(s(i-1,j  ,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i-1,j+1,k  ,icomp),s(i-1,j  ,k+1,icomp),
+                       s(i  ,j+1,k  ,icomp),s(i  ,j  ,k+1,icomp),s(i-1,j+1,k+1,icomp),s(i  ,j+1,k+1,icomp));
+
+         smin(3) = min(s(i-1,j  ,k-1,icomp),s(i  ,j  ,k-1,icomp),s(i-1,j+1,k-1,icomp),s(i-1,j  ,k  ,icomp),
+                       s(i  ,j+1,k-1,icomp),s(i  ,j  ,k  ,icomp),s(i-1,j+1,k  ,icomp),s(i  ,j+1,k  ,icomp));
+         smax(3) = max(s(i-1,j  ,k-1,icomp),s(i  ,j  ,k-1,icomp),s(i-1,j+1,k-1,icomp),s(i-1,j  ,k  ,icomp),
+                       s(i  ,j+1,k-1,icomp),s(i  ,j  ,k  ,icomp),s(i-1,j+1,k  ,icomp),s(i  ,j+1,k  ,icomp));
+
+         smin(2) = min(s(i-1,j-1,k  ,icomp),s(i  ,j-1,k  ,icomp),s(i-1,j  ,k  ,icomp),s(i-1,j-1,k+1,icomp),
+                       s(i  ,j  ,k  ,icomp),s(i  ,j-1,k+1,icomp),s(i-1,j  ,k+1,icomp),s(i  ,j  ,k+1,icomp));
+         smax(2) = max(s(i-1,j-1,k  ,icomp),s(i  ,j-1,k  ,icomp),s(i-1,j  ,k  ,icomp),s(i-1,j-1,k+1,icomp),
+                       s(i  ,j  ,k  ,icomp),s(i  ,j-1,k+1,icomp),s(i-1,j  ,k+1,icomp),s(i  ,j  ,k+1,icomp));
+
+         smin(1) = min(s(i-1,j-1,k-1,icomp),s(i  ,j-1,k-1,icomp),s(i-1,j  ,k-1,icomp),s(i-1,j-1,k  ,icomp),
+                       s(i  ,j  ,k-1,icomp),s(i  ,j-1,k  ,icomp),s(i-1,j  ,k  ,icomp),s(i  ,j  ,k  ,icomp));
+         smax(1) = max(s(i-1,j-1,k-1,icomp),s(i  ,j-1,k-1,icomp),s(i-1,j  ,k-1,icomp),s(i-1,j-1,k  ,icomp),
+                       s(i  ,j  ,k-1,icomp),s(i  ,j-1,k  ,icomp),s(i-1,j  ,k  ,icomp),s(i  ,j  ,k  ,icomp));
+
+         for(int mm=1; mm<=8; ++mm){
+            if (allow_change(mm)) {
+                sc(mm) = max(min(sc(mm), smax(mm)), smin(mm));
+            }
+         }
 
-        // Variables local to this loop
-        Array1D<Real, 1, 8> diff;
-        Array1D<Real, 1, 8> smin;
-        Array1D<Real, 1, 8> smax;
-        Array1D<Real, 1, 8> sc;
+         // iterative loop
+         for(int ll = 1; ll<=6; ++ll){
 
-        Array1D<bool, 1, 8> allow_change;
-        for (int mm=1; mm<=8; ++mm) {
-            allow_change(mm) = true;
-        }
+            // compute the amount by which the average of the nodal values differs from cell-center value
+            sumloc = 0.125*(sc(1)+sc(2)+sc(3)+sc(4)+sc(5)+sc(6)+sc(7)+sc(8));
+            sumdif = (sumloc - s(i,j,k,icomp))*8.0;
 
-        if ( i==dlo.x && lo_x_physbc ) {
-            allow_change(1) = false;
-            allow_change(2) = false;
-            allow_change(3) = false;
-            allow_change(4) = false;
-        }
-        if ( i==dhi.x+1 && hi_x_physbc ) {
-            allow_change(5) = false;
-            allow_change(6) = false;
-            allow_change(7) = false;
-            allow_change(8) = false;
-        }
-        if ( j==dlo.y && lo_y_physbc ) {
-            allow_change(1) = false;
-            allow_change(2) = false;
-            allow_change(5) = false;
-            allow_change(6) = false;
-        }
-        if ( j==dhi.y+1 && hi_y_physbc ) {
-            allow_change(3) = false;
-            allow_change(4) = false;
-            allow_change(7) = false;
-            allow_change(8) = false;
-        }
-        if ( k==dlo.z && lo_z_physbc ) {
-            allow_change(1) = false;
-            allow_change(3) = false;
-            allow_change(5) = false;
-            allow_change(7) = false;
-        }
-        if ( k==dhi.z+1 && hi_z_physbc ) {
-            allow_change(2) = false;
-            allow_change(4) = false;
-            allow_change(6) = false;
-            allow_change(8) = false;
-        }
+            // sgndif = +(-)1 if the node average is too large(small)
+            sgndif = std::copysign(1.0_rt,sumdif);
+
+            // compute how much each node is larger(smaller) than the cell-centered value
+            for(int mm=1; mm<=8; ++mm){
+               diff(mm) = (sc(mm) - s(i,j,k,icomp))*sgndif;
+            }
+
+            kdp = 0;
+
+           // count how many nodes are larger(smaller) than the cell-centered value
+            for(int mm=1; mm<=8; ++mm){
+               if (diff(mm) > eps && allow_change(mm)) {
+                  kdp = kdp+1;
+               }
+            }
+
+            // adjust node values
+            for(int mm=1; mm<=8; ++mm){
+
+               // don't allow boundary nodes to change value
+               if (!allow_change(mm)) continue;
+
+               if (kdp<1) {
+                  div = 1.0;
+               } else {
+                  div = kdp;
+               }
+
+               if (diff(mm)>eps) {
+                  redfac = sumdif*sgndif/div;
+                  kdp = kdp-1;
+               } else {
+                  redfac = 0.0;
+               }
+
+               if (sgndif > 0.0) {
+                  redmax = sc(mm) - smin(mm);
+               } else {
+                  redmax = smax(mm) - sc(mm);
+               }
+
+               redfac = min(redfac,redmax);
+               sumdif = sumdif - redfac*sgndif;
+               sc(mm) = sc(mm) - redfac*sgndif;
+            }
+         }
+
+         // final slopes
 
-         // compute initial estimates of slopes from unlimited corner points
          // sx
-         slopes(i,j,k,0) = 0.25*(( sint(i+1,j  ,k  ) + sint(i+1,j+1,k  )
-                                  +sint(i+1,j  ,k+1) + sint(i+1,j+1,k+1) )
-                                -( sint(i  ,j  ,k  ) + sint(i  ,j+1,k  )
-                                  +sint(i  ,j  ,k+1) + sint(i  ,j+1,k+1) )) / hx;
+         slopes(i,j,k,7*icomp+0) = 0.25*( ( sc(5) + sc(7)
+                                   +sc(6) + sc(8))
+                                 -( sc(1) + sc(3)
+                                   +sc(2) + sc(4)) ) / hx;
+
          // sy
-         slopes(i,j,k,1) = 0.25*(( sint(i  ,j+1,k  ) + sint(i+1,j+1,k  )
-                                  +sint(i  ,j+1,k+1) + sint(i+1,j+1,k+1) )
-                                -( sint(i  ,j  ,k  ) + sint(i+1,j  ,k  )
-                                  +sint(i  ,j  ,k+1) + sint(i+1,j  ,k+1) )) / hy;
+         slopes(i,j,k,7*icomp+1) = 0.25*( ( sc(3) + sc(7)
+                                   +sc(4) + sc(8))
+                                 -( sc(1) + sc(5)
+                                   +sc(2) + sc(6)) ) / hy;
 
          // sz
-         slopes(i,j,k,2) = 0.25*(( sint(i  ,j  ,k+1) + sint(i+1,j  ,k+1)
-                                  +sint(i  ,j+1,k+1) + sint(i+1,j+1,k+1) )
-                                -( sint(i  ,j  ,k  ) + sint(i+1,j  ,k  )
-                                  +sint(i  ,j+1,k  ) + sint(i+1,j+1,k  ) )) / hz;
+         slopes(i,j,k,7*icomp+2) = 0.25*( ( sc(2) + sc(6)
+                                   +sc(4) + sc(8))
+                                 -( sc(1) + sc(5)
+                                   +sc(3) + sc(7)) ) / hz;
 
          // sxy
-         slopes(i,j,k,3) = 0.5*( ( sint(i  ,j  ,k  ) + sint(i  ,j  ,k+1)
-                                  +sint(i+1,j+1,k  ) + sint(i+1,j+1,k+1) )
-                                -( sint(i+1,j  ,k  ) + sint(i+1,j  ,k+1)
-                                  +sint(i  ,j+1,k  ) + sint(i  ,j+1,k+1) )) / (hx*hy);
+         slopes(i,j,k,7*icomp+3) = 0.5*( ( sc(1) + sc(2)
+                                  +sc(7) + sc(8))
+                                -( sc(5) + sc(6)
+                                  +sc(3) + sc(4)) ) / (hx*hy);
 
          // sxz
-         slopes(i,j,k,4) = 0.5*( ( sint(i  ,j  ,k  ) + sint(i  ,j+1,k  )
-                                  +sint(i+1,j  ,k+1) + sint(i+1,j+1,k+1) )
-                                -( sint(i+1,j  ,k  ) + sint(i+1,j+1,k  )
-                                  +sint(i  ,j  ,k+1) + sint(i  ,j+1,k+1) )) / (hx*hz);
+         slopes(i,j,k,7*icomp+4) = 0.5*( ( sc(1) + sc(3)
+                                  +sc(6) + sc(8))
+                                -( sc(5) + sc(7)
+                                  +sc(2) + sc(4)) ) / (hx*hz);
 
          // syz
-         slopes(i,j,k,5) = 0.5*( ( sint(i  ,j  ,k  ) + sint(i+1,j  ,k  )
-                                  +sint(i  ,j+1,k+1) + sint(i+1,j+1,k+1) )
-                                -( sint(i  ,j  ,k+1) + sint(i+1,j  ,k+1)
-                                  +sint(i  ,j+1,k  ) + sint(i+1,j+1,k  ) )) / (hy*hz);
+         slopes(i,j,k,7*icomp+5) = 0.5*( ( sc(1) + sc(5)
+                                  +sc(4) + sc(8))
+                                -( sc(2) + sc(6)
+                                  +sc(3) + sc(7)) ) / (hy*hz);
 
          // sxyz
-         slopes(i,j,k,6) =       (-sint(i  ,j  ,k  ) + sint(i+1,j  ,k  ) + sint(i  ,j+1,k  )
-                                  +sint(i  ,j  ,k+1) - sint(i+1,j+1,k  ) - sint(i+1,j  ,k+1)
-                                  -sint(i  ,j+1,k+1) + sint(i+1,j+1,k+1) ) / (hx*hy*hz);
-
-         if (limit_slopes) {
-
-             // +++ / sint(i+1,j+1,k+1)
-             sc(8) = s(i,j,k,icomp)
-                  +0.5  *(     hx*slopes(i,j,k,0)+   hy*slopes(i,j,k,1)+   hz*slopes(i,j,k,2))
-                  +0.25 *(  hx*hy*slopes(i,j,k,3)+hx*hz*slopes(i,j,k,4)+hy*hz*slopes(i,j,k,5))
-                  +0.125*hx*hy*hz*slopes(i,j,k,6);
-
-             // ++- / sint(i+1,j+1,k  )
-             sc(7) = s(i,j,k,icomp)
-                  +0.5  *(     hx*slopes(i,j,k,0)+   hy*slopes(i,j,k,1)-   hz*slopes(i,j,k,2))
-                  +0.25 *(  hx*hy*slopes(i,j,k,3)-hx*hz*slopes(i,j,k,4)-hy*hz*slopes(i,j,k,5))
-                  -0.125*hx*hy*hz*slopes(i,j,k,6);
-
-             // +-+ / sint(i+1,j  ,k+1)
-             sc(6) = s(i,j,k,icomp)
-                  +0.5  *(     hx*slopes(i,j,k,0)-   hy*slopes(i,j,k,1)+   hz*slopes(i,j,k,2))
-                  +0.25 *( -hx*hy*slopes(i,j,k,3)+hx*hz*slopes(i,j,k,4)-hy*hz*slopes(i,j,k,5))
-                  -0.125*hx*hy*hz*slopes(i,j,k,6);
-
-             // +-- / sint(i+1,j  ,k  )
-             sc(5) = s(i,j,k,icomp)
-                  +0.5  *(     hx*slopes(i,j,k,0)-   hy*slopes(i,j,k,1)-   hz*slopes(i,j,k,2))
-                  +0.25 *( -hx*hy*slopes(i,j,k,3)-hx*hz*slopes(i,j,k,4)+hy*hz*slopes(i,j,k,5))
-                  +0.125*hx*hy*hz*slopes(i,j,k,6);
-
-             // -++ / sint(i  ,j+1,k+1)
-             sc(4) = s(i,j,k,icomp)
-                  +0.5  *(    -hx*slopes(i,j,k,0)+   hy*slopes(i,j,k,1)+   hz*slopes(i,j,k,2))
-                  +0.25 *( -hx*hy*slopes(i,j,k,3)-hx*hz*slopes(i,j,k,4)+hy*hz*slopes(i,j,k,5))
-                  -0.125*hx*hy*hz*slopes(i,j,k,6);
-
-             // -+- / sint(i  ,j+1,k  )
-             sc(3) = s(i,j,k,icomp)
-                  +0.5  *(    -hx*slopes(i,j,k,0)+   hy*slopes(i,j,k,1)-   hz*slopes(i,j,k,2))
-                  +0.25 *( -hx*hy*slopes(i,j,k,3)+hx*hz*slopes(i,j,k,4)-hy*hz*slopes(i,j,k,5))
-                  +0.125*hx*hy*hz*slopes(i,j,k,6);
-
-             // --+ / sint(i  ,j  ,k+1)
-             sc(2) = s(i,j,k,icomp)
-                  +0.5  *(    -hx*slopes(i,j,k,0)-   hy*slopes(i,j,k,1)+   hz*slopes(i,j,k,2))
-                  +0.25 *(  hx*hy*slopes(i,j,k,3)-hx*hz*slopes(i,j,k,4)-hy*hz*slopes(i,j,k,5))
-                  +0.125*hx*hy*hz*slopes(i,j,k,6);
-
-             // ---/ sint(i  ,j  ,k  )
-             sc(1) = s(i,j,k,icomp)
-                  +0.5  *(    -hx*slopes(i,j,k,0)-   hy*slopes(i,j,k,1)-   hz*slopes(i,j,k,2))
-                  +0.25 *(  hx*hy*slopes(i,j,k,3)+hx*hz*slopes(i,j,k,4)+hy*hz*slopes(i,j,k,5))
-                  -0.125*hx*hy*hz*slopes(i,j,k,6);
-
-             // enforce max/min bounds
-             smin(8) = min(s(i  ,j  ,k  ,icomp),s(i+1,j  ,k  ,icomp),s(i  ,j+1,k  ,icomp),s(i  ,j  ,k+1,icomp),
-                           s(i+1,j+1,k  ,icomp),s(i+1,j  ,k+1,icomp),s(i  ,j+1,k+1,icomp),s(i+1,j+1,k+1,icomp));
-             smax(8) = max(s(i  ,j  ,k  ,icomp),s(i+1,j  ,k  ,icomp),s(i  ,j+1,k  ,icomp),s(i  ,j  ,k+1,icomp),
-                           s(i+1,j+1,k  ,icomp),s(i+1,j  ,k+1,icomp),s(i  ,j+1,k+1,icomp),s(i+1,j+1,k+1,icomp));
-
-             smin(7) = min(s(i  ,j  ,k-1,icomp),s(i+1,j  ,k-1,icomp),s(i  ,j+1,k-1,icomp),s(i  ,j  ,k  ,icomp),
-                           s(i+1,j+1,k-1,icomp),s(i+1,j  ,k  ,icomp),s(i  ,j+1,k  ,icomp),s(i+1,j+1,k  ,icomp));
-             smax(7) = max(s(i  ,j  ,k-1,icomp),s(i+1,j  ,k-1,icomp),s(i  ,j+1,k-1,icomp),s(i  ,j  ,k  ,icomp),
-                           s(i+1,j+1,k-1,icomp),s(i+1,j  ,k  ,icomp),s(i  ,j+1,k  ,icomp),s(i+1,j+1,k  ,icomp));
-
-             smin(6) = min(s(i  ,j-1,k  ,icomp),s(i+1,j-1,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i  ,j-1,k+1,icomp),
-                           s(i+1,j  ,k  ,icomp),s(i+1,j-1,k+1,icomp),s(i  ,j  ,k+1,icomp),s(i+1,j  ,k+1,icomp));
-             smax(6) = max(s(i  ,j-1,k  ,icomp),s(i+1,j-1,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i  ,j-1,k+1,icomp),
-                           s(i+1,j  ,k  ,icomp),s(i+1,j-1,k+1,icomp),s(i  ,j  ,k+1,icomp),s(i+1,j  ,k+1,icomp));
-
-             smin(5) = min(s(i  ,j-1,k-1,icomp),s(i+1,j-1,k-1,icomp),s(i  ,j  ,k-1,icomp),s(i  ,j-1,k  ,icomp),
-                           s(i+1,j  ,k-1,icomp),s(i+1,j-1,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i+1,j  ,k  ,icomp));
-             smax(5) = max(s(i  ,j-1,k-1,icomp),s(i+1,j-1,k-1,icomp),s(i  ,j  ,k-1,icomp),s(i  ,j-1,k  ,icomp),
-                           s(i+1,j  ,k-1,icomp),s(i+1,j-1,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i+1,j  ,k  ,icomp));
-
-             smin(4) = min(s(i-1,j  ,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i-1,j+1,k  ,icomp),s(i-1,j  ,k+1,icomp),
-                           s(i  ,j+1,k  ,icomp),s(i  ,j  ,k+1,icomp),s(i-1,j+1,k+1,icomp),s(i  ,j+1,k+1,icomp));
-             smax(4) = max(s(i-1,j  ,k  ,icomp),s(i  ,j  ,k  ,icomp),s(i-1,j+1,k  ,icomp),s(i-1,j  ,k+1,icomp),
-                           s(i  ,j+1,k  ,icomp),s(i  ,j  ,k+1,icomp),s(i-1,j+1,k+1,icomp),s(i  ,j+1,k+1,icomp));
-
-             smin(3) = min(s(i-1,j  ,k-1,icomp),s(i  ,j  ,k-1,icomp),s(i-1,j+1,k-1,icomp),s(i-1,j  ,k  ,icomp),
-                           s(i  ,j+1,k-1,icomp),s(i  ,j  ,k  ,icomp),s(i-1,j+1,k  ,icomp),s(i  ,j+1,k  ,icomp));
-             smax(3) = max(s(i-1,j  ,k-1,icomp),s(i  ,j  ,k-1,icomp),s(i-1,j+1,k-1,icomp),s(i-1,j  ,k  ,icomp),
-                           s(i  ,j+1,k-1,icomp),s(i  ,j  ,k  ,icomp),s(i-1,j+1,k  ,icomp),s(i  ,j+1,k  ,icomp));
-
-             smin(2) = min(s(i-1,j-1,k  ,icomp),s(i  ,j-1,k  ,icomp),s(i-1,j  ,k  ,icomp),s(i-1,j-1,k+1,icomp),
-                           s(i  ,j  ,k  ,icomp),s(i  ,j-1,k+1,icomp),s(i-1,j  ,k+1,icomp),s(i  ,j  ,k+1,icomp));
-             smax(2) = max(s(i-1,j-1,k  ,icomp),s(i  ,j-1,k  ,icomp),s(i-1,j  ,k  ,icomp),s(i-1,j-1,k+1,icomp),
-                           s(i  ,j  ,k  ,icomp),s(i  ,j-1,k+1,icomp),s(i-1,j  ,k+1,icomp),s(i  ,j  ,k+1,icomp));
-
-             smin(1) = min(s(i-1,j-1,k-1,icomp),s(i  ,j-1,k-1,icomp),s(i-1,j  ,k-1,icomp),s(i-1,j-1,k  ,icomp),
-                           s(i  ,j  ,k-1,icomp),s(i  ,j-1,k  ,icomp),s(i-1,j  ,k  ,icomp),s(i  ,j  ,k  ,icomp));
-             smax(1) = max(s(i-1,j-1,k-1,icomp),s(i  ,j-1,k-1,icomp),s(i-1,j  ,k-1,icomp),s(i-1,j-1,k  ,icomp),
-                           s(i  ,j  ,k-1,icomp),s(i  ,j-1,k  ,icomp),s(i-1,j  ,k  ,icomp),s(i  ,j  ,k  ,icomp));
-
-             for(int mm=1; mm<=8; ++mm){
-                if (allow_change(mm)) {
-                    sc(mm) = max(min(sc(mm), smax(mm)), smin(mm));
-                }
-             }
+         slopes(i,j,k,7*icomp+6) = (-sc(1) + sc(5) + sc(3)
+                            +sc(2) - sc(7) - sc(6)
+                            -sc(4) + sc(8) ) / (hx*hy*hz);
 
-             // iterative loop
-             for(int ll = 1; ll<=6; ++ll){
+     }
+}
+
+/**
+ * Compute bilinear slopes for BDS algorithm.
+ *
+ * \param [in]  bx      Current grid patch
+ * \param [in]  geom    Level geometry.
+ * \param [in]  ncomp   Number of components of the state Array4.
+ * \param [in]  s       Array4<const> of state vector.
+ * \param [out] slopes  Array4 to store slope information, 7 components per state component.
+ * \param [in]  pbc     Boundary conditions.
+ * \param [in]  fuse_nodes  If true, interpolate the node values on the fly instead of
+ *                          storing them in a nodal temporary.
+ *
+ */
+
+void
+BDS::ComputeSlopes ( Box const& bx,
+                     const Geometry& geom,
+                     int ncomp,
+                     Array4<Real const> const& s,
+                     Array4<Real      > const& slopes,
+                     BCRec const* pbc,
+                     bool fuse_nodes)
+{
+    Box const& gbx = amrex::grow(bx,1);
+    GpuArray<Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
 
-                // compute the amount by which the average of the nodal values differs from cell-center value
-                sumloc = 0.125*(sc(1)+sc(2)+sc(3)+sc(4)+sc(5)+sc(6)+sc(7)+sc(8));
-                sumdif = (sumloc - s(i,j,k,icomp))*8.0;
+    Box const& domain = geom.Domain();
+    const auto dlo = amrex::lbound(domain);
+    const auto dhi = amrex::ubound(domain);
 
-                // sgndif = +(-)1 if the node average is too large(small)
-                sgndif = std::copysign(1.0_rt,sumdif);
+    for (int icomp = 0; icomp < ncomp; ++icomp)
+    {
+        auto bc = pbc[icomp];
+
+        // Abort for cell-centered BC types
+        if ( bc.lo(0) == BCType::reflect_even || bc.lo(0) == BCType::reflect_odd || bc.lo(0) == BCType::hoextrapcc ||
+             bc.hi(0) == BCType::reflect_even || bc.hi(0) == BCType::reflect_odd || bc.hi(0) == BCType::hoextrapcc ||
+             bc.lo(1) == BCType::reflect_even || bc.lo(1) == BCType::reflect_odd || bc.lo(1) == BCType::hoextrapcc ||
+             bc.hi(1) == BCType::reflect_even || bc.hi(1) == BCType::reflect_odd || bc.hi(1) == BCType::hoextrapcc ||
+             bc.lo(2) == BCType::reflect_even || bc.lo(2) == BCType::reflect_odd || bc.lo(2) == BCType::hoextrapcc ||
+             bc.hi(2) == BCType::reflect_even || bc.hi(2) == BCType::reflect_odd || bc.hi(2) == BCType::hoextrapcc )
+            amrex::Abort("BDS::Slopes: Unsupported BC type. Supported types are int_dir, ext_dir, foextrap, and hoextrap");
+    }
 
-                // compute how much each node is larger(smaller) than the cell-centered value
-                for(int mm=1; mm<=8; ++mm){
-                   diff(mm) = (sc(mm) - s(i,j,k,icomp))*sgndif;
-                }
+    if (fuse_nodes)
+    {
+        // Sweep each row of cells along i, keeping the nodes on the low and
+        // high x-faces of the current cell. No nodal temporary is stored, but
+        // each node is interpolated by every row that uses it (up to four rows).
+        int const ilo = gbx.smallEnd(0);
+        int const ihi = gbx.bigEnd(0);
+        Box rowbx = gbx;
+        rowbx.setBig(0, ilo);
+
+        ParallelFor(rowbx, ncomp, [=] AMREX_GPU_DEVICE (int, int j, int k, int icomp)
+        {
+            auto const bc = pbc[icomp];
+
+            Real w[2][2][2];
+            for (int kk = 0; kk <= 1; ++kk) {
+            for (int jj = 0; jj <= 1; ++jj) {
+                w[0][jj][kk] = node_value(ilo,j+jj,k+kk,icomp,s,bc,dlo,dhi);
+            }}
+
+            for (int i = ilo; i <= ihi; ++i)
+            {
+                for (int kk = 0; kk <= 1; ++kk) {
+                for (int jj = 0; jj <= 1; ++jj) {
+                    w[1][jj][kk] = node_value(i+1,j+jj,k+kk,icomp,s,bc,dlo,dhi);
+                }}
+
+                limited_slopes(i, j, k, icomp, [&] (int ii, int jj, int kk) { return w[ii][jj][kk]; },
+                               s, slopes, bc, dlo, dhi, dx);
+
+                for (int kk = 0; kk <= 1; ++kk) {
+                for (int jj = 0; jj <= 1; ++jj) {
+                    w[0][jj][kk] = w[1][jj][kk];
+                }}
+            }
+        });
+    }
+    else
+    {
+        // Define container for the nodal interpolated state
+        Box const& ngbx = amrex::grow(amrex::convert(bx,IntVect(AMREX_D_DECL(1,1,1))),1);
+        FArrayBox tmpnodefab(ngbx,ncomp);
+        Elixir tmpeli = tmpnodefab.elixir();
+        auto const& sint = tmpnodefab.array();
+
+        // tricubic interpolation to corner points
+        // (i,j,k) refers to lower corner of cell
+        ParallelFor(ngbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp)
+        {
+            sint(i,j,k,icomp) = node_value(i,j,k,icomp,s,pbc[icomp],dlo,dhi);
+        });
+
+        ParallelFor(gbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp)
+        {
+            limited_slopes(i, j, k, icomp, [&] (int ii, int jj, int kk) { return sint(i+ii,j+jj,k+kk,icomp); },
+                           s, slopes, pbc[icomp], dlo, dhi, dx);
+        });
+    }
+}
 
-                kdp = 0;
+/**
+ * Adds fac times the weights of the seven slope terms of the trilinear
+ * interpolant, evaluated at displacement del from the cell center.
+ *
+ * \param [in,out] w
+ * \param [in]     fac
+ * \param [in]     del
+ *
+ *
+ */
 
-               // count how many nodes are larger(smaller) than the cell-centered value
-                for(int mm=1; mm<=8; ++mm){
-                   if (diff(mm) > eps && allow_change(mm)) {
-                      kdp = kdp+1;
-                   }
-                }
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void add_weights (Real* w, const Real fac,
+                  GpuArray<Real,3> const& del)
+{
+    w[0] += fac*del[0];
+    w[1] += fac*del[1];
+    w[2] += fac*del[2];
+    w[3] += fac*del[0]*del[1];
+    w[4] += fac*del[0]*del[2];
+    w[5] += fac*del[1]*del[2];
+    w[6] += fac*del[0]*del[1]*del[2];
+}
 
-                // adjust node values
-                for(int mm=1; mm<=8; ++mm){
-
-                   // don't allow boundary nodes to change value
-                   if (!allow_change(mm)) continue;
-
-                   if (kdp<1) {
-                      div = 1.0;
-                   } else {
-                      div = kdp;
-                   }
-
-                   if (diff(mm)>eps) {
-                      redfac = sumdif*sgndif/div;
-                      kdp = kdp-1;
-                   } else {
-                      redfac = 0.0;
-                   }
-
-                   if (sgndif > 0.0) {
-                      redmax = sc(mm) - smin(mm);
-                   } else {
-                      redmax = smax(mm) - sc(mm);
-                   }
-
-                   redfac = min(redfac,redmax);
-                   sumdif = sumdif - redfac*sgndif;
-                   sc(mm) = sc(mm) - redfac*sgndif;
-                }
-             }
-
-             // final slopes
-
-             // sx
-             slopes(i,j,k,0) = 0.25*( ( sc(5) + sc(7)
-                                       +sc(6) + sc(8))
-                                     -( sc(1) + sc(3)
-                                       +sc(2) + sc(4)) ) / hx;
-
-             // sy
-             slopes(i,j,k,1) = 0.25*( ( sc(3) + sc(7)
-                                       +sc(4) + sc(8))
-                                     -( sc(1) + sc(5)
-                                       +sc(2) + sc(6)) ) / hy;
-
-             // sz
-             slopes(i,j,k,2) = 0.25*( ( sc(2) + sc(6)
-                                       +sc(4) + sc(8))
-                                     -( sc(1) + sc(5)
-                                       +sc(3) + sc(7)) ) / hz;
-
-             // sxy
-             slopes(i,j,k,3) = 0.5*( ( sc(1) + sc(2)
-                                      +sc(7) + sc(8))
-                                    -( sc(5) + sc(6)
-                                      +sc(3) + sc(4)) ) / (hx*hy);
-
-             // sxz
-             slopes(i,j,k,4) = 0.5*( ( sc(1) + sc(3)
-                                      +sc(6) + sc(8))
-                                    -( sc(5) + sc(7)
-                                      +sc(2) + sc(4)) ) / (hx*hz);
-
-             // syz
-             slopes(i,j,k,5) = 0.5*( ( sc(1) + sc(5)
-                                      +sc(4) + sc(8))
-                                    -( sc(2) + sc(6)
-                                      +sc(3) + sc(7)) ) / (hy*hz);
-
-             // sxyz
-             slopes(i,j,k,6) = (-sc(1) + sc(5) + sc(3)
-                                +sc(2) - sc(7) - sc(6)
-                                -sc(4) + sc(8) ) / (hx*hy*hz);
+/**
+ * Packs an offset in {-1,0,1}^3 into a single integer.
+ */
 
-         }
-    });
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+int pack_offset (IntVect const& off)
+{
+    return (off[0]+1) + 3*(off[1]+1) + 9*(off[2]+1);
 }
 
 /**
- * Returns updated edge value.
+ * Computes the trace geometry of the transverse triangle on side sT of the
+ * d-faces in direction T, and of its two corner corrections in direction R:
+ * the upwind cells, the weights of the slope terms and the coefficients of
+ * the three evaluations in the edge state. The result does not depend on the
+ * component and is shared by all of them.
  *
- * \param [in] s
- * \param [in] slope
- * \param [in] del
+ * \param [in]  fbx  Box of d-faces.
+ * \param [in]  sT   1 for the high T-face of the upwind cell, -1 for the low one.
+ * \param [in]  vel  Array4s of the face velocities.
+ * \param [in]  h    Cell size.
+ * \param [in]  dt   Time step.
+ * \param [out] geo  Weights and coefficients.
+ * \param [out] off  Upwind cells, packed by pack_offset.
  *
  *
  */
 
-AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
-Real eval (const Real s,
-           Array1D<Real,1,7>& slope,
-           Array1D<Real,1,3>& del)
+template <int d, int T, int R>
+void trace_geometry (Box const& fbx, const int sT,
+                     GpuArray<Array4<Real const>,3> const& vel,
+                     GpuArray<Real,AMREX_SPACEDIM> const& h, const Real dt,
+                     Array4<Real> const& geo, Array4<int> const& off)
 {
-    Real val = s + del(1)*slope(1)        + del(2)*slope(2)        + del(3)*slope(3)
-                 + del(1)*del(2)*slope(4) + del(1)*del(3)*slope(5) + del(2)*del(3)*slope(6)
-                 + del(1)*del(2)*del(3)*slope(7);
+    Real sixth = 1.0/6.0;
+
+    ParallelFor(fbx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+    {
+            IntVect const f(i,j,k);
+            Real const un = vel[d](f);
+
+            IntVect cA = f;
+            Real a;
+            if (un > 0.0) {
+                cA[d] -= 1;
+                a = 0.5*h[d];
+            } else {
+                a = -0.5*h[d];
+            }
+
+            // upwind cell across the T-face on side sT
+            IntVect fT = cA;
+            if (sT > 0) { fT[T] += 1; }
+            Real const vT = vel[T](fT);
+
+            IntVect cB = cA;
+            Real b;
+            if (vT > 0.0) {
+                b = 0.5*h[T];
+                if (sT < 0) { cB[T] -= 1; }
+            } else {
+                b = -0.5*h[T];
+                if (sT > 0) { cB[T] += 1; }
+            }
+
+            Real const unB = vel[d](f + (cB - cA));
+            Real const u = (un*unB > 0.0) ? unB : 0.0;
+
+            // \Gamma^{T} is the average over the triangle p1, p2, p3
+            GpuArray<Real,3> p1{}, p2{}, p3{}, p4{}, del{};
+            p1[d] = a;
+            p1[T] = b;
+
+            p2[d] = a - un*dt;
+            p2[T] = b;
+
+            p3[d] = a - u*dt;
+            p3[T] = b - vT*dt;
+
+            Real w[7] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+            for(int ll=0; ll<3; ++ll ){
+               del[ll] = (p2[ll]+p3[ll])/2.0;
+            }
+            add_weights(w, 1.0/3.0, del);
+            for(int ll=0; ll<3; ++ll ){
+               del[ll] = (p1[ll]+p3[ll])/2.0;
+            }
+            add_weights(w, 1.0/3.0, del);
+            for(int ll=0; ll<3; ++ll ){
+               del[ll] = (p1[ll]+p2[ll])/2.0;
+            }
+            add_weights(w, 1.0/3.0, del);
+
+            Real const coefT = -sT*dt*vT/(2.0*h[T]);
+
+            for (int n = 0; n < 7; ++n) {
+                geo(i,j,k,n) = w[n];
+            }
+            geo(i,j,k,7) = coefT;
+            off(i,j,k,0) = pack_offset(cB - f);
+
+            // corner corrections \Gamma^{T,R+} and \Gamma^{T,R-}
+            for (int e = 1; e <= 2; ++e)
+            {
+                const int sR = (e == 1) ? 1 : -1;
+
+                IntVect fR = cB;
+                if (sR > 0) { fR[R] += 1; }
+                Real const vR = vel[R](fR);
+
+                IntVect cC = cB;
+                Real c;
+                if (vR > 0.0) {
+                    c = 0.5*h[R];
+                    if (sR < 0) { cC[R] -= 1; }
+                } else {
+                    c = -0.5*h[R];
+                    if (sR > 0) { cC[R] += 1; }
+                }
+
+                Real const unC = vel[d](f + (cC - cA));
+                Real const uu = (un*unC > 0.0) ? unC : 0.0;
+
+                Real const vTC = vel[T](fT + (cC - cB));
+                Real const vv = (vT*vTC > 0.0) ? vTC : 0.0;
+
+                // On z-faces the corner traces take the transverse velocity on the
+                // T-face shifted by the corner offset instead of the normal one
+                Real const vT3 = (d == 2) ? vel[T](fT + (cC - cB) - (cA - f)) : vT;
+
+                p1[d] = a;
+                p1[T] = b;
+                p1[R] = c;
+
+                p2[d] = a - un*dt;
+                p2[T] = b;
+                p2[R] = c;
+
+                p3[d] = a - un*dt;
+                p3[T] = b - vT3*dt;
+                p3[R] = c;
+
+                p4[d] = a - uu*dt;
+                p4[T] = b - vv*dt;
+                p4[R] = c - vR*dt;
+
+                for (int n = 0; n < 7; ++n) {
+                    w[n] = 0.0;
+                }
+                for(int ll=0; ll<3; ++ll ){
+                   del[ll] = (p1[ll]+p2[ll]+p3[ll]+p4[ll])/4.0;
+                }
+                add_weights(w, -0.8, del);
+                for(int ll=0; ll<3; ++ll ){
+                   del[ll] = 0.5*p1[ll] + sixth*(p2[ll]+p3[ll]+p4[ll]);
+                }
+                add_weights(w, 0.45, del);
+                for(int ll=0; ll<3; ++ll ){
+                   del[ll] = 0.5*p2[ll] + sixth*(p1[ll]+p3[ll]+p4[ll]);
+                }
+                add_weights(w, 0.45, del);
+                for(int ll=0; ll<3; ++ll ){
+                   del[ll] = 0.5*p3[ll] + sixth*(p2[ll]+p1[ll]+p4[ll]);
+                }
+                add_weights(w, 0.45, del);
+                for(int ll=0; ll<3; ++ll ){
+                   del[ll] = 0.5*p4[ll] + sixth*(p2[ll]+p3[ll]+p1[ll]);
+                }
+                add_weights(w, 0.45, del);
 
-    return val;
+                for (int n = 0; n < 7; ++n) {
+                    geo(i,j,k,8*e+n) = w[n];
+                }
+                geo(i,j,k,8*e+7) = coefT * (-sR*dt*vR/(3.0*h[R]));
+                off(i,j,k,e) = pack_offset(cC - f);
+            }
+    });
 }
 
 /**
  * Compute Conc for BDS algorithm.
  *
+ * The edge state on each face is a linear combination of the trilinear
+ * interpolant of the upwind cells evaluated at the centroid of the upwind
+ * volume, averaged over the transverse triangles, and averaged over the
+ * corner corrections of each triangle. The work is staged one face direction
+ * at a time: the centroid term of all components is computed first, then for
+ * each of the four transverse triangles the trace geometry (upwind cells,
+ * weights of the slope terms and velocity coefficients) is computed once per
+ * face and stored in scratch, after which all components are evaluated with
+ * a short loop over that scratch.
+ *
  * \param [in]     bx          Current grid patch
  * \param [in]     geom        Level geometry.
- * \param [in]     icomp       Component of the Array4s.
+ * \param [in]     ncomp       Number of components to work on.
  * \param [in]     s           Array4 of state.
  * \param [in,out] sedgex      Array4 containing x-edges.
  * \param [in,out] sedgey      Array4 containing y-edges.
@@ -543,7 +858,7 @@ Real eval (const Real s,
 void
 BDS::ComputeConc (Box const& bx,
                   const Geometry& geom,
-                  int icomp,
+                  int ncomp,
                   Array4<Real const> const& s,
                   Array4<Real      > const& sedgex,
                   Array4<Real      > const& sedgey,
@@ -559,2932 +874,182 @@ BDS::ComputeConc (Box const& bx,
                   const bool is_velocity)
 {
     Box const& gbx = amrex::grow(bx,1);
-    GpuArray<Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
+    GpuArray<Real, AMREX_SPACEDIM> h = geom.CellSizeArray();
 
-    FArrayBox ux_fab(gbx,1);
-    FArrayBox vy_fab(gbx,1);
-    FArrayBox wz_fab(gbx,1);
-    Elixir uxeli = ux_fab.elixir();
-    Elixir vyeli = vy_fab.elixir();
-    Elixir wzeli = wz_fab.elixir();
-    auto const& ux    = ux_fab.array();
-    auto const& vy    = vy_fab.array();
-    auto const& wz    = wz_fab.array();
+    // ux, vy and wz, followed by per face scratch for one transverse triangle
+    // and its two corner corrections: 7 slope weights and 1 coefficient for
+    // each of the 3 evaluations, then the edge state of each component while
+    // it is being accumulated. gbx holds at least as many points as any of the
+    // face boxes.
+    constexpr int ngeom = 3*8;
+    FArrayBox tmpfab(gbx, 3 + ngeom + ncomp);
+    Elixir tmpeli = tmpfab.elixir();
 
-    Real hx = dx[0];
-    Real hy = dx[1];
-    Real hz = dx[2];
+    // Upwind cell of each of the 3 evaluations, packed by pack_offset
+    IArrayBox offfab(gbx, 3);
+    Elixir offeli = offfab.elixir();
+
+    auto const& ux    = tmpfab.array(0,1);
+    auto const& vy    = tmpfab.array(1,1);
+    auto const& wz    = tmpfab.array(2,1);
 
     Real dt2 = dt/2.0;
     Real dt3 = dt/3.0;
     Real dt4 = dt/4.0;
 
-    Real sixth = 1.0/6.0;
-
     Box const& domain = geom.Domain();
-    const auto dlo = amrex::lbound(domain);
-    const auto dhi = amrex::ubound(domain);
-
-    auto bc = pbc[icomp];
-    bool lo_x_physbc = (bc.lo(0) == BCType::foextrap || bc.lo(0) == BCType::hoextrap || bc.lo(0) == BCType::ext_dir) ? true : false;
-    bool hi_x_physbc = (bc.hi(0) == BCType::foextrap || bc.hi(0) == BCType::hoextrap || bc.hi(0) == BCType::ext_dir) ? true : false;
-    bool lo_y_physbc = (bc.lo(1) == BCType::foextrap || bc.lo(1) == BCType::hoextrap || bc.lo(1) == BCType::ext_dir) ? true : false;
-    bool hi_y_physbc = (bc.hi(1) == BCType::foextrap || bc.hi(1) == BCType::hoextrap || bc.hi(1) == BCType::ext_dir) ? true : false;
-    bool lo_z_physbc = (bc.lo(2) == BCType::foextrap || bc.lo(2) == BCType::hoextrap || bc.lo(2) == BCType::ext_dir) ? true : false;
-    bool hi_z_physbc = (bc.hi(2) == BCType::foextrap || bc.hi(2) == BCType::hoextrap || bc.hi(2) == BCType::ext_dir) ? true : false;
+    const IntVect dlo = domain.smallEnd();
+    const IntVect dhi = domain.bigEnd();
 
+    // velocity divergence terms are shared by all components
     ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
-          ux(i,j,k) = (umac(i+1,j,k) - umac(i,j,k)) / hx;
-          vy(i,j,k) = (vmac(i,j+1,k) - vmac(i,j,k)) / hy;
-          wz(i,j,k) = (wmac(i,j,k+1) - wmac(i,j,k)) / hz;
+          ux(i,j,k) = (umac(i+1,j,k) - umac(i,j,k)) / h[0];
+          vy(i,j,k) = (vmac(i,j+1,k) - vmac(i,j,k)) / h[1];
+          wz(i,j,k) = (wmac(i,j,k+1) - wmac(i,j,k)) / h[2];
     });
 
-    // compute sedgex on x-faces
-    Box const& xbx = amrex::surroundingNodes(bx,0);
-    ParallelFor(xbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
-
-        // set edge values equal to the ghost cell value since they store the physical condition on the boundary
-        if ( i==dlo.x && lo_x_physbc ) {
-            sedgex(i,j,k,icomp) = s(i-1,j,k,icomp);
-            if (is_velocity && icomp == XVEL && (bc.lo(0) == BCType::foextrap ||  bc.lo(0) == BCType::hoextrap) ) {
-                // make sure velocity is not blowing inward
-                sedgex(i,j,k,icomp) = amrex::min(0._rt,sedgex(i,j,k,icomp));
-            }
-            // This will return from computing (i,j,k), not exit from ComputeConc.
-            // Recall that ParallelFor is a macro that sets up a multidimensional loop
-            // and then calls this lambda on the loop interior.
-            return;
-        }
-        if ( i==dhi.x+1 && hi_x_physbc ) {
-            sedgex(i,j,k,icomp) = s(i,j,k,icomp);
-            if (is_velocity && icomp == XVEL && (bc.hi(0) == BCType::foextrap ||  bc.hi(0) == BCType::hoextrap) ) {
-                // make sure velocity is not blowing inward
-                sedgex(i,j,k,icomp) = amrex::max(0._rt,sedgex(i,j,k,icomp));
-            }
-            return;
-        }
-
-        //local variables
-        Array1D<Real, 1, 3> del;
-        Array1D<Real, 1, 3> p1;
-        Array1D<Real, 1, 3> p2;
-        Array1D<Real, 1, 3> p3;
-        Array1D<Real, 1, 3> p4;
-
-        Array1D<Real, 1, 7> slope_tmp;
-
-        int ioff, joff, koff;
-
-        Real isign,jsign,ksign;
-        Real val1,val2,val3,val4,val5;
-        Real u;
-        Real uu,vv,ww;
-        Real gamma,gamma2;
-
-        // Since faces of xbx can overlap between tileboxes, need a temporary
-        // to hold intermediate edgestate value
-        Real xedge_tmp;
-
-        ////////////////////////////////////////////////
-        // compute sedgex without transverse corrections
-        ////////////////////////////////////////////////
-
-        if (umac(i,j,k) > 0.0) {
-           isign = 1.0;
-           ioff = -1;
-        } else {
-           isign = -1.0;
-           ioff = 0;
-        }
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j,k,n-1);
-        }
+    GpuArray<Array4<Real const>,3> const vel{umac, vmac, wmac};
+    GpuArray<Array4<Real const>,3> const divc{ux, vy, wz};
+    GpuArray<Array4<Real      >,3> const sedge{sedgex, sedgey, sedgez};
 
+    for (int d = 0; d < AMREX_SPACEDIM; ++d)
+    {
+        Box const& fbx = amrex::surroundingNodes(bx,d);
 
-        // centroid of rectangular volume
-        del(1) = isign*0.5*hx - 0.5*umac(i,j,k)*dt;
-        del(2) = 0.0;
-        del(3) = 0.0;
-        xedge_tmp = eval(s(i+ioff,j,k,icomp),slope_tmp,del);
+        Real* p = tmpfab.dataPtr(3);
+        Array4<Real> geo = makeArray4(p, fbx, ngeom);
+        p += geo.size();
+        Array4<Real> edge = makeArray4(p, fbx, ncomp);
+        Array4<int> off = makeArray4(offfab.dataPtr(), fbx, 3);
 
-        // source term
-        if (iconserv[icomp]) {
-            xedge_tmp = xedge_tmp*(1. - dt2*ux(i+ioff,j,k));
-        } else {
-            xedge_tmp = xedge_tmp*(1. + dt2*(vy(i+ioff,j,k)+wz(i+ioff,j,k)));
-        }
-        if (force) {
-            xedge_tmp += dt2*force(i+ioff,j,k,icomp);
-        }
+        // transverse directions
+        const int t1 = (d == 0) ? 1 : 0;
+        const int t2 = (d == 2) ? 1 : 2;
 
         ////////////////////////////////////////////////
-        // compute \Gamma^{y+} without corner corrections
+        // edge states without transverse corrections
         ////////////////////////////////////////////////
 
-        if (vmac(i+ioff,j+1,k) > 0.0) {
-           jsign = 1.0;
-           joff = 0;
-        } else {
-           jsign = -1.0;
-           joff = 1;
-        }
-
-
-        u = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k) > 0.0) {
-           u = umac(i,j+joff,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = 0.0;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = 0.0;
-
-        p3(1) = isign*0.5*hx - u*dt;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k)*dt;
-        p3(3) = 0.0;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k,n-1);
-        }
+        ParallelFor(fbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp)
+        {
+            IntVect const f(i,j,k);
+            Real const un = vel[d](f);
 
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
+            // centroid of rectangular volume
+            IntVect cA = f;
+            Real del;
+            if (un > 0.0) {
+                cA[d] -= 1;
+                del = 0.5*h[d] - 0.5*un*dt;
+            } else {
+                del = -0.5*h[d] - 0.5*un*dt;
+            }
 
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
+            Real val = s(cA,icomp) + del*slopes(cA,7*icomp+d);
 
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
+            // source term
+            if (iconserv[icomp]) {
+                val = val*(1. - dt2*divc[d](cA));
+            } else {
+                val = val*(1. + dt2*(divc[t1](cA)+divc[t2](cA)));
+            }
+            if (force) {
+                val += dt2*force(cA,icomp);
+            }
 
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
+            edge(i,j,k,icomp) = val;
+        });
+
+        ////////////////////////////////////////////////
+        // transverse corrections \Gamma^{T+} and \Gamma^{T-},
+        // each corrected with \Gamma^{T,R+} and \Gamma^{T,R-}
+        ////////////////////////////////////////////////
+
+        for (int side = 0; side < 4; ++side)
+        {
+            const int T  = (side < 2) ? t1 : t2;
+            const int R  = (side < 2) ? t2 : t1;
+            const int sT = (side % 2 == 0) ? 1 : -1;
+
+            // trace geometry, shared by all components
+            if        (d == 0 && T == 1) {
+                trace_geometry<0,1,2>(fbx, sT, vel, h, dt, geo, off);
+            } else if (d == 0 && T == 2) {
+                trace_geometry<0,2,1>(fbx, sT, vel, h, dt, geo, off);
+            } else if (d == 1 && T == 0) {
+                trace_geometry<1,0,2>(fbx, sT, vel, h, dt, geo, off);
+            } else if (d == 1 && T == 2) {
+                trace_geometry<1,2,0>(fbx, sT, vel, h, dt, geo, off);
+            } else if (d == 2 && T == 0) {
+                trace_geometry<2,0,1>(fbx, sT, vel, h, dt, geo, off);
+            } else {
+                trace_geometry<2,1,0>(fbx, sT, vel, h, dt, geo, off);
+            }
 
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(ux(i+ioff,j+joff,k)+vy(i+ioff,j+joff,k)));
-        } else {
-            gamma = gamma*(1. + dt3*wz(i+ioff,j+joff,k));
+            // evaluate the interpolants of every component and accumulate
+            ParallelFor(fbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp)
+            {
+                Real sum = 0.0;
+                for (int e = 0; e < 3; ++e)
+                {
+                    const int code = off(i,j,k,e);
+                    IntVect const c(i + code%3 - 1, j + (code/3)%3 - 1, k + code/9 - 1);
+
+                    Real val = s(c,icomp);
+                    for (int n = 0; n < 7; ++n) {
+                        val += geo(i,j,k,8*e+n)*slopes(c,7*icomp+n);
+                    }
+
+                    // source term
+                    Real coef = geo(i,j,k,8*e+7);
+                    if (e == 0) {
+                        if (iconserv[icomp]) {
+                            coef = coef*(1. - dt3*(divc[d](c)+divc[T](c)));
+                        } else {
+                            coef = coef*(1. + dt3*divc[R](c));
+                        }
+                    } else if (iconserv[icomp]) {
+                        coef = coef*(1. - dt4*divu(c));
+                    }
+
+                    sum += coef*val;
+                }
+                edge(i,j,k,icomp) += sum;
+            });
         }
 
         ////////////////////////////////////////////////
-        // correct \Gamma^{y+} with \Gamma^{y+,z+}
+        // store edge states, imposing physical boundaries
         ////////////////////////////////////////////////
 
-        if (wmac(i+ioff,j+joff,k+1) > 0.0) {
-           ksign = 1.0;
-           koff = 0;
-        } else {
-           ksign = -1.0;
-           koff = 1;
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        vv = 0.0;
-        if (vmac(i+ioff,j+1,k)*vmac(i+ioff,j+1,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j+1,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz;
+        ParallelFor(fbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int icomp)
+        {
+            IntVect const f(i,j,k);
 
-        p3(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k)*dt;
-        p3(3) = ksign*0.5*hz;
+            auto const bc = pbc[icomp];
+            bool lo_physbc = (bc.lo(d) == BCType::foextrap || bc.lo(d) == BCType::hoextrap || bc.lo(d) == BCType::ext_dir) ? true : false;
+            bool hi_physbc = (bc.hi(d) == BCType::foextrap || bc.hi(d) == BCType::hoextrap || bc.hi(d) == BCType::ext_dir) ? true : false;
 
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - wmac(i+ioff,j+joff,k+1)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * wmac(i+ioff,j+joff,k+1);
-
-        gamma = gamma - dt*gamma2/(3.0*hz);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{y+} with \Gamma^{y+,z-}
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j+joff,k) > 0.0) {
-           ksign = 1.0;
-           koff = -1;
-        } else {
-           ksign = -1.0;
-           koff = 0;
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        vv = 0.0;
-        if (vmac(i+ioff,j+1,k)*vmac(i+ioff,j+1,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j+1,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k)*dt;
-        p3(3) = ksign*0.5*hz;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - wmac(i+ioff,j+joff,k)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * wmac(i+ioff,j+joff,k);
-
-        gamma = gamma + dt*gamma2/(3.0*hz);
-
-        ////////////////////////////////////////////////
-        // correct sedgex with \Gamma^{y+}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * vmac(i+ioff,j+1,k);
-        xedge_tmp = xedge_tmp - dt*gamma/(2.0*hy);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{y-} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j,k) > 0.0) {
-           jsign = 1.0;
-           joff = -1;
-        } else {
-           jsign = -1.0;
-           joff = 0;
-        }
-
-        u = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k) > 0.0) {
-           u = umac(i,j+joff,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = 0.0;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = 0.0;
-
-        p3(1) = isign*0.5*hx - u*dt;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j,k)*dt;
-        p3(3) = 0.0;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(ux(i+ioff,j+joff,k)+vy(i+ioff,j+joff,k)));
-        } else {
-            gamma = gamma*(1. + dt3*wz(i+ioff,j+joff,k));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{y-} with \Gamma^{y-,z+}
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j+joff,k+1) > 0.0) {
-           ksign = 1.0;
-           koff = 0;
-        } else {
-           ksign = -1.0;
-           koff = 1;
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        vv = 0.0;
-        if (vmac(i+ioff,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j,k)*dt;
-        p3(3) = ksign*0.5*hz;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - wmac(i+ioff,j+joff,k+1)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * wmac(i+ioff,j+joff,k+1);
-
-        gamma = gamma - dt*gamma2/(3.0*hz);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{y-} with \Gamma^{y-,z-}
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j+joff,k) > 0.0) {
-           ksign = 1.0;
-           koff = -1;
-        } else {
-           ksign = -1.0;
-           koff = 0;
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        vv = 0.0;
-        if (vmac(i+ioff,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j,k)*dt;
-        p3(3) = ksign*0.5*hz;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - wmac(i+ioff,j+joff,k)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * wmac(i+ioff,j+joff,k);
-
-        gamma = gamma + dt*gamma2/(3.0*hz);
-
-        ////////////////////////////////////////////////
-        // correct sedgex with \Gamma^{y-}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * vmac(i+ioff,j,k);
-        xedge_tmp = xedge_tmp + dt*gamma/(2.0*hy);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{z+} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j,k+1) > 0.0) {
-           ksign = 1.0;
-           koff = 0;
-        } else {
-           ksign = -1.0;
-           koff = 1;
-        }
-
-        u = 0.0;
-        if (umac(i,j,k)*umac(i,j,k+koff) > 0.0) {
-           u = umac(i,j,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = 0.0;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = 0.0;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - u*dt;
-        p3(2) = 0.0;
-        p3(3) = ksign*0.5*hz - wmac(i+ioff,j,k+1)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(ux(i+ioff,j,k+koff)+wz(i+ioff,j,k+koff)));
-        } else {
-            gamma = gamma*(1. + dt3*vy(i+ioff,j,k+koff));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{z+} with \Gamma^{z+,y+}
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j+1,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = 0;
-        } else {
-           jsign = -1.0;
-           joff = 1;
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        ww = 0.0;
-        if (wmac(i+ioff,j,k+1)*wmac(i+ioff,j+joff,k+1) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k+1);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p3(2) = jsign*0.5*hy;
-        p3(3) = ksign*0.5*hz - wmac(i+ioff,j,k+1)*dt;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k+koff)*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * vmac(i+ioff,j+1,k+koff);
-
-        gamma = gamma - dt*gamma2/(3.0*hy);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{z+} with \Gamma^{z+,y-}
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = -1;
-        } else {
-           jsign = -1.0;
-           joff = 0;
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        ww = 0.0;
-        if (wmac(i+ioff,j,k+1)*wmac(i+ioff,j+joff,k+1) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k+1);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p3(2) = jsign*0.5*hy;
-        p3(3) = ksign*0.5*hz - wmac(i+ioff,j,k+1)*dt;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vmac(i+ioff,j,k+koff)*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * vmac(i+ioff,j,k+koff);
-
-        gamma = gamma + dt*gamma2/(3.0*hy);
-
-        ////////////////////////////////////////////////
-        // correct sedgex with \Gamma^{z+}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * wmac(i+ioff,j,k+1);
-        xedge_tmp = xedge_tmp - dt*gamma/(2.0*hz);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{z-} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j,k) > 0.0) {
-           ksign = 1.0;
-           koff = -1;
-        } else {
-           ksign = -1.0;
-           koff = 0;
-        }
-
-        u = 0.0;
-        if (umac(i,j,k)*umac(i,j,k+koff) > 0.0) {
-           u = umac(i,j,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = 0.0;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = 0.0;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - u*dt;
-        p3(2) = 0.0;
-        p3(3) = ksign*0.5*hz - wmac(i+ioff,j,k)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(ux(i+ioff,j,k+koff)+wz(i+ioff,j,k+koff)));
-        } else {
-            gamma = gamma*(1. + dt3*vy(i+ioff,j,k+koff));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{z-} with \Gamma^{z-,y+}
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j+1,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = 0;
-        } else {
-           jsign = -1.0;
-           joff = 1;
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        ww = 0.0;
-        if (wmac(i+ioff,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p3(2) = jsign*0.5*hy;
-        p3(3) = ksign*0.5*hz - wmac(i+ioff,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k+koff)*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * vmac(i+ioff,j+1,k+koff);
-
-        gamma = gamma - dt*gamma2/(3.0*hy);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{z-} with \Gamma^{z-,y-}
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = -1;
-        } else {
-           jsign = -1.0;
-           joff = 0;
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        ww = 0.0;
-        if (wmac(i+ioff,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j,k)*dt;
-        p3(2) = jsign*0.5*hy;
-        p3(3) = ksign*0.5*hz - wmac(i+ioff,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vmac(i+ioff,j,k+koff)*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * vmac(i+ioff,j,k+koff);
-
-        gamma = gamma + dt*gamma2/(3.0*hy);
-
-        ////////////////////////////////////////////////
-        // correct sedgex with \Gamma^{z-}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * wmac(i+ioff,j,k);
-        sedgex(i,j,k,icomp) = xedge_tmp + dt*gamma/(2.0*hz);
-    });
-
-    // compute sedgey on y-faces
-    Box const& ybx = amrex::surroundingNodes(bx,1);
-    ParallelFor(ybx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
-
-        // set edge values equal to the ghost cell value since they store the physical condition on the boundary
-        if ( j==dlo.y && lo_y_physbc ) {
-            sedgey(i,j,k,icomp) = s(i,j-1,k,icomp);
-            if (is_velocity && icomp == YVEL && (bc.lo(1) == BCType::foextrap ||  bc.lo(1) == BCType::hoextrap) ) {
-                // make sure velocity is not blowing inward
-                sedgey(i,j,k,icomp) = amrex::min(0._rt,sedgey(i,j,k,icomp));
-            }
-            return;
-        }
-        if ( j==dhi.y+1 && hi_y_physbc ) {
-            sedgey(i,j,k,icomp) = s(i,j,k,icomp);
-            if (is_velocity && icomp == YVEL && (bc.hi(1) == BCType::foextrap ||  bc.hi(1) == BCType::hoextrap) ) {
-                // make sure velocity is not blowing inward
-                sedgey(i,j,k,icomp) = amrex::max(0._rt,sedgey(i,j,k,icomp));
-            }
-            return;
-        }
-
-        //local variables
-        Array1D<Real, 1, 3> del;
-        Array1D<Real, 1, 3> p1;
-        Array1D<Real, 1, 3> p2;
-        Array1D<Real, 1, 3> p3;
-        Array1D<Real, 1, 3> p4;
-
-        Array1D<Real, 1, 7> slope_tmp;
-
-        int ioff, joff, koff;
-
-        Real isign,jsign,ksign;
-        Real val1,val2,val3,val4,val5;
-        Real v;
-        Real uu,vv,ww;
-        Real gamma,gamma2;
-
-        // Hold intermediate edgestate value
-        Real yedge_tmp;
-
-        ////////////////////////////////////////////////
-        // compute sedgey without transverse corrections
-        ////////////////////////////////////////////////
-
-        // centroid of rectangular volume
-        if (vmac(i,j,k) > 0.0) {
-           jsign = 1.0;
-           joff = -1;
-        } else {
-           jsign = -1.0;
-           joff = 0;
-        }
-
-        del(1) = 0.0;
-        del(2) = jsign*0.5*hy - 0.5*vmac(i,j,k)*dt;
-        del(3) = 0.0;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i,j+joff,k,n-1);
-        }
-
-        yedge_tmp = eval(s(i,j+joff,k,icomp),slope_tmp,del);
-
-        // source term
-        if (iconserv[icomp]) {
-            yedge_tmp = yedge_tmp*(1. - dt2*vy(i,j+joff,k));
-        } else {
-            yedge_tmp = yedge_tmp*(1. + dt2*(ux(i,j+joff,k)+wz(i,j+joff,k)));
-        }
-        if (force) {
-            yedge_tmp += dt2*force(i,j+joff,k,icomp);
-        }
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{x+} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (umac(i+1,j+joff,k) > 0.0) {
-           isign = 1.0;
-           ioff = 0;
-        } else {
-           isign = -1.0;
-           ioff = 1;
-        }
-
-        v = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k) > 0.0) {
-           v = vmac(i+ioff,j,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = 0.0;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = 0.0;
-
-        p3(1) = isign*0.5*hx - umac(i+1,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy - v*dt;
-        p3(3) = 0.0;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(vy(i+ioff,j+joff,k)+ux(i+ioff,j+joff,k)));
-        } else {
-            gamma = gamma*(1. + dt3*wz(i+ioff,j+joff,k));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{x+} with \Gamma^{x+,z+}
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j+joff,k+1) > 0.0) {
-           ksign = 1.0;
-           koff = 0;
-        } else {
-           ksign = -1.0;
-           koff = 1;
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        uu = 0.0;
-        if (umac(i+1,j+joff,k)*umac(i+1,j+joff,k+koff) > 0.0) {
-           uu = umac(i+1,j+joff,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i+1,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p3(3) = ksign*0.5*hz;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - wmac(i+ioff,j+joff,k+1)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * wmac(i+ioff,j+joff,k+1);
-
-        gamma = gamma - dt*gamma2/(3.0*hz);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{x+} with \Gamma^{x+,z-}
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j+joff,k) > 0.0) {
-           ksign = 1.0;
-           koff = -1;
-        } else {
-           ksign = -1.0;
-           koff = 0;
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        uu = 0.0;
-        if (umac(i+1,j+joff,k)*umac(i+1,j+joff,k+koff) > 0.0) {
-           uu = umac(i+1,j+joff,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i+1,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p3(3) = ksign*0.5*hz;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - wmac(i+ioff,j+joff,k)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * wmac(i+ioff,j+joff,k);
-
-        gamma = gamma + dt*gamma2/(3.0*hz);
-
-        ////////////////////////////////////////////////
-        // correct sedgey with \Gamma^{x+}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * umac(i+1,j+joff,k);
-        yedge_tmp = yedge_tmp - dt*gamma/(2.0*hx);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{x-} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (umac(i,j+joff,k) > 0.0) {
-           isign = 1.0;
-           ioff = -1;
-        } else {
-           isign = -1.0;
-           ioff = 0;
-        }
-
-        v = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k) > 0.0) {
-           v = vmac(i+ioff,j,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = 0.0;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = 0.0;
-
-        p3(1) = isign*0.5*hx - umac(i,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy - v*dt;
-        p3(3) = 0.0;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i+ioff,j+joff,k,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(vy(i+ioff,j+joff,k)+ux(i+ioff,j+joff,k)));
-        } else {
-            gamma = gamma*(1. + dt3*wz(i+ioff,j+joff,k));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{x-} with \Gamma^{x-,z+}
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j+joff,k+1) > 0.0) {
-           ksign = 1.0;
-           koff = 0;
-        } else {
-           ksign = -1.0;
-           koff = 1;
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        uu = 0.0;
-        if (umac(i,j+joff,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p3(3) = ksign*0.5*hz;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - wmac(i+ioff,j+joff,k+1)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * wmac(i+ioff,j+joff,k+1);
-
-        gamma = gamma - dt*gamma2/(3.0*hz);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{x-} with \Gamma^{x-,z-}
-        ////////////////////////////////////////////////
-
-        if (wmac(i+ioff,j+joff,k) > 0.0) {
-           ksign = 1.0;
-           koff = -1;
-        } else {
-           ksign = -1.0;
-           koff = 0;
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        uu = 0.0;
-        if (umac(i,j+joff,k)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx - umac(i,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p3(3) = ksign*0.5*hz;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - wmac(i+ioff,j+joff,k)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * wmac(i+ioff,j+joff,k);
-
-        gamma = gamma + dt*gamma2/(3.0*hz);
-
-        ////////////////////////////////////////////////
-        // correct sedgey with \Gamma^{x-}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * umac(i,j+joff,k);
-        yedge_tmp = yedge_tmp + dt*gamma/(2.0*hx);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{z+} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (wmac(i,j+joff,k+1) > 0.0) {
-           ksign = 1.0;
-           koff = 0;
-        } else {
-           ksign = -1.0;
-           koff = 1;
-        }
-
-        v = 0.0;
-        if (vmac(i,j,k)*vmac(i,j,k+koff) > 0.0) {
-           v = vmac(i,j,k+koff);
-        }
-
-        p1(1) = 0.0;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = 0.0;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = 0.0;
-        p3(2) = jsign*0.5*hy - v*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j+joff,k+1)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(vy(i,j+joff,k+koff)+wz(i,j+joff,k+koff)));
-        } else {
-            gamma = gamma*(1. + dt3*ux(i,j+joff,k+koff));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{z+} with \Gamma^{z+,x+}
-        ////////////////////////////////////////////////
-
-        if (umac(i+1,j+joff,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = 0;
-        } else {
-           isign = -1.0;
-           ioff = 1;
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        ww = 0.0;
-        if (wmac(i,j+joff,k+1)*wmac(i+ioff,j+joff,k+1) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k+1);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j+joff,k+1)*dt;
-
-        p4(1) = isign*0.5*hx - umac(i+1,j+joff,k+koff)*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * umac(i+1,j+joff,k+koff);
-
-        gamma = gamma - dt*gamma2/(3.0*hx);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{z+} with \Gamma^{z+,x-}
-        ////////////////////////////////////////////////
-
-        if (umac(i,j+joff,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = -1;
-        } else {
-           isign = -1.0;
-           ioff = 0;
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        ww = 0.0;
-        if (wmac(i,j+joff,k+1)*wmac(i+ioff,j+joff,k+1) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k+1);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j+joff,k+1)*dt;
-
-        p4(1) = isign*0.5*hx - umac(i,j+joff,k+koff)*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * umac(i,j+joff,k+koff);
-
-        gamma = gamma + dt*gamma2/(3.0*hx);
-
-        ////////////////////////////////////////////////
-        // correct sedgey with \Gamma^{z+}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * wmac(i,j+joff,k+1);
-        yedge_tmp = yedge_tmp - dt*gamma/(2.0*hz);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{z-} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (wmac(i,j+joff,k) > 0.0) {
-           ksign = 1.0;
-           koff = -1;
-        } else {
-           ksign = -1.0;
-           koff = 0;
-        }
-
-        v = 0.0;
-        if (vmac(i,j,k)*vmac(i,j,k+koff) > 0.0) {
-           v = vmac(i,j,k+koff);
-        }
-
-        p1(1) = 0.0;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = 0.0;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = 0.0;
-        p3(2) = jsign*0.5*hy - v*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j+joff,k)*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(vy(i,j+joff,k+koff)+wz(i,j+joff,k+koff)));
-        } else {
-            gamma = gamma*(1. + dt3*ux(i,j+joff,k+koff));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{z-} with \Gamma^{z-,x+}
-        ////////////////////////////////////////////////
-
-        if (umac(i+1,j+joff,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = 0;
-        } else {
-           isign = -1.0;
-           ioff = 1;
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        ww = 0.0;
-        if (wmac(i,j+joff,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j+joff,k)*dt;
-
-        p4(1) = isign*0.5*hx - umac(i+1,j+joff,k+koff)*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * umac(i+1,j+joff,k+koff);
-
-        gamma = gamma - dt*gamma2/(3.0*hx);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{z-} with \Gamma^{z-,x-}
-        ////////////////////////////////////////////////
-
-        if (umac(i,j+joff,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = -1;
-        } else {
-           isign = -1.0;
-           ioff = 0;
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        ww = 0.0;
-        if (wmac(i,j+joff,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p2(3) = ksign*0.5*hz;
-
-        p3(1) = isign*0.5*hx;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k)*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j+joff,k)*dt;
-
-        p4(1) = isign*0.5*hx - umac(i,j+joff,k+koff)*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * umac(i,j+joff,k+koff);
-
-        gamma = gamma + dt*gamma2/(3.0*hx);
-
-        ////////////////////////////////////////////////
-        // correct sedgey with \Gamma^{z-}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * wmac(i,j+joff,k);
-        sedgey(i,j,k,icomp) = yedge_tmp + dt*gamma/(2.0*hz);
-    });
-
-    // compute sedgez on z-faces
-    Box const& zbx = amrex::surroundingNodes(bx,2);
-    ParallelFor(zbx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
-
-        // set edge values equal to the ghost cell value since they store the physical condition on the boundary
-        if ( k==dlo.z && lo_z_physbc ) {
-            sedgez(i,j,k,icomp) = s(i,j,k-1,icomp);
-            if (is_velocity && icomp == ZVEL && (bc.lo(2) == BCType::foextrap ||  bc.lo(2) == BCType::hoextrap) ) {
-                // make sure velocity is not blowing inward
-                sedgez(i,j,k,icomp) = amrex::min(0._rt,sedgez(i,j,k,icomp));
-            }
-            return;
-        }
-        if ( k==dhi.z+1 && hi_z_physbc ) {
-            sedgez(i,j,k,icomp) = s(i,j,k,icomp);
-            if (is_velocity && icomp == ZVEL && (bc.hi(2) == BCType::foextrap ||  bc.hi(2) == BCType::hoextrap) ) {
-                // make sure velocity is not blowing inward
-                sedgez(i,j,k,icomp) = amrex::max(0._rt,sedgez(i,j,k,icomp));
-            }
-            return;
-        }
-
-        //local variables
-        Array1D<Real, 1, 3> del;
-        Array1D<Real, 1, 3> p1;
-        Array1D<Real, 1, 3> p2;
-        Array1D<Real, 1, 3> p3;
-        Array1D<Real, 1, 3> p4;
-
-        Array1D<Real, 1, 7> slope_tmp;
-
-        int ioff, joff, koff;
-
-        Real isign,jsign,ksign;
-        Real val1,val2,val3,val4,val5;
-        Real w;
-        Real uu,vv,ww;
-        Real gamma,gamma2;
-
-        // Hold intermediate edgestate value
-        Real zedge_tmp;
-
-        ////////////////////////////////////////////////
-        // compute sedgez without transverse corrections
-        ////////////////////////////////////////////////
-
-        // centroid of rectangular volume
-        if (wmac(i,j,k) > 0.0) {
-           ksign = 1.0;
-           koff = -1;
-        } else {
-           ksign = -1.0;
-           koff = 0;
-        }
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i,j,k+koff,n-1);
-        }
-
-        del(1) = 0.0;
-        del(2) = 0.0;
-        del(3) = ksign*0.5*hz - 0.5*wmac(i,j,k)*dt;
-        zedge_tmp = eval(s(i,j,k+koff,icomp),slope_tmp,del);
-
-
-        // source term
-        if (iconserv[icomp]) {
-            zedge_tmp = zedge_tmp*(1. - dt2*wz(i,j,k+koff));
-        } else {
-            zedge_tmp = zedge_tmp*(1. + dt2*(ux(i,j,k+koff)+vy(i,j,k+koff)));
-        }
-        if (force) {
-            zedge_tmp += dt2*force(i,j,k+koff,icomp);
-        }
-
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{x+} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (umac(i+1,j,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = 0;
-        } else {
-           isign = -1.0;
-           ioff = 1;
-        }
-
-        w = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j,k) > 0.0) {
-           w = wmac(i+ioff,j,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = 0.0;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = 0.0;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx - umac(i+1,j,k+koff)*dt;
-        p3(2) = 0.0;
-        p3(3) = ksign*0.5*hz - w*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(wz(i+ioff,j,k+koff)+ux(i+ioff,j,k+koff)));
-        } else {
-            gamma = gamma*(1. + dt3*vy(i+ioff,j,k+koff));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{x+} with \Gamma^{x+,y+}
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j+1,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = 0;
-        } else {
-           jsign = -1.0;
-           joff = 1;
-        }
-
-        ww = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        uu = 0.0;
-        if (umac(i+1,j,k+koff)*umac(i+1,j+joff,k+koff) > 0.0) {
-           uu = umac(i+1,j+joff,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx - umac(i+1,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy;
-        p3(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k+koff)*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * vmac(i+ioff,j+1,k+koff);
-
-        gamma = gamma - dt*gamma2/(3.0*hy);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{x+} with \Gamma^{x+,y-}
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = -1;
-        } else {
-           jsign = -1.0;
-           joff = 0;
-        }
-
-        ww = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        uu = 0.0;
-        if (umac(i+1,j,k+koff)*umac(i+1,j+joff,k+koff) > 0) {
-           uu = umac(i+1,j+joff,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx - umac(i+1,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy;
-        p3(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vmac(i+ioff,j,k+koff)*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * vmac(i+ioff,j,k+koff);
-
-        gamma = gamma + dt*gamma2/(3.0*hy);
-
-        ////////////////////////////////////////////////
-        // correct sedgez with \Gamma^{x+}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * umac(i+1,j,k+koff);
-        zedge_tmp = zedge_tmp - dt*gamma/(2.0*hx);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{x-} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (umac(i,j,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = -1;
-        } else {
-           isign = -1.0;
-           ioff = 0;
-        }
-
-        w = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j,k) > 0.0) {
-           w = wmac(i+ioff,j,k);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = 0.0;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = 0.0;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx - umac(i,j,k+koff)*dt;
-        p3(2) = 0.0;
-        p3(3) = ksign*0.5*hz - w*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i+ioff,j,k+koff,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(wz(i+ioff,j,k+koff)+ux(i+ioff,j,k+koff)));
-        } else {
-            gamma = gamma*(1. + dt3*vy(i+ioff,j,k+koff));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{x-} with \Gamma^{x-,y+}
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j+1,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = 0;
-        } else {
-           jsign = -1.0;
-           joff = 1;
-        }
-
-        ww = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k+koff)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx - umac(i,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy;
-        p3(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k+koff)*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * vmac(i+ioff,j+1,k+koff);
-
-        gamma = gamma - dt*gamma2/(3.0*hy);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{x-} with \Gamma^{x-,y-}
-        ////////////////////////////////////////////////
-
-        if (vmac(i+ioff,j,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = -1;
-        } else {
-           jsign = -1.0;
-           joff = 0;
-        }
-
-        ww = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        uu = 0.0;
-        if (umac(i,j,k+koff)*umac(i,j+joff,k+koff) > 0.0) {
-           uu = umac(i,j+joff,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx - umac(i,j+joff,k)*dt;
-        p3(2) = jsign*0.5*hy;
-        p3(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - uu*dt;
-        p4(2) = jsign*0.5*hy - vmac(i+ioff,j,k+koff)*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * vmac(i+ioff,j,k+koff);
-
-        gamma = gamma + dt*gamma2/(3.0*hy);
-
-        ////////////////////////////////////////////////
-        // correct sedgez with \Gamma^{x-}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * umac(i,j,k+koff);
-        zedge_tmp = zedge_tmp + dt*gamma/(2.0*hx);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{y+} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (vmac(i,j+1,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = 0;
-        } else {
-           jsign = -1.0;
-           joff = 1;
-        }
-
-        w = 0.0;
-        if (wmac(i,j,k)*wmac(i,j+joff,k) > 0.0) {
-           w = wmac(i,j+joff,k);
-        }
-
-        p1(1) = 0.0;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = 0.0;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = 0.0;
-        p3(2) = jsign*0.5*hy - vmac(i,j+1,k+koff)*dt;
-        p3(3) = ksign*0.5*hz - w*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(wz(i,j+joff,k+koff)+vy(i,j+joff,k+koff)));
-        } else {
-            gamma = gamma*(1. + dt3*ux(i,j+joff,k+koff));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{y+} with \Gamma^{y+,x+}
-        ////////////////////////////////////////////////
-
-        if (umac(i+1,j+joff,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = 0;
-        } else {
-           isign = -1.0;
-           ioff = 1;
-        }
-
-        ww = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        vv = 0.0;
-        if (vmac(i,j+1,k+koff)*vmac(i+ioff,j+1,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j+1,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k)*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - umac(i+1,j+joff,k+koff)*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * umac(i+1,j+joff,k+koff);
-
-        gamma = gamma - dt*gamma2/(3.0*hx);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{y+} with \Gamma^{y+,x-}
-        ////////////////////////////////////////////////
-
-        if (umac(i,j+joff,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = -1;
-        } else {
-           isign = -1.0;
-           ioff = 0;
-        }
-
-        ww = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        vv = 0.0;
-        if (vmac(i,j+1,k+koff)*vmac(i+ioff,j+1,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j+1,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j+1,k)*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - umac(i,j+joff,k+koff)*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * umac(i,j+joff,k+koff);
-
-        gamma = gamma + dt*gamma2/(3.0*hx);
-
-        ////////////////////////////////////////////////
-        // correct sedgez with \Gamma^{y+}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * vmac(i,j+1,k+koff);
-        zedge_tmp = zedge_tmp - dt*gamma/(2.0*hy);
-
-        ////////////////////////////////////////////////
-        // compute \Gamma^{y-} without corner corrections
-        ////////////////////////////////////////////////
-
-        if (vmac(i,j,k+koff) > 0.0) {
-           jsign = 1.0;
-           joff = -1;
-        } else {
-           jsign = -1.0;
-           joff = 0;
-        }
-
-        w = 0.0;
-        if (wmac(i,j,k)*wmac(i,j+joff,k) > 0.0) {
-           w = wmac(i,j+joff,k);
-        }
-
-        p1(1) = 0.0;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = 0.0;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = 0.0;
-        p3(2) = jsign*0.5*hy - vmac(i,j,k+koff)*dt;
-        p3(3) = ksign*0.5*hz - w*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p2(ll)+p3(ll))/2.0;
-        }
-        val1 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p3(ll))/2.0;
-        }
-        val2 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll))/2.0;
-        }
-        val3 = eval(s(i,j+joff,k+koff,icomp),slope_tmp,del);
-
-        // average these centroid values to get the average value
-        gamma = (val1+val2+val3)/3.0;
-
-        // source term
-        if (iconserv[icomp]) {
-            gamma = gamma*(1. - dt3*(wz(i,j+joff,k+koff)+vy(i,j+joff,k+koff)));
-        } else {
-            gamma = gamma*(1. + dt3*ux(i,j+joff,k+koff));
-        }
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{y-} with \Gamma^{y-,x+};
-        ////////////////////////////////////////////////
-
-        if (umac(i+1,j+joff,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = 0;
-        } else {
-           isign = -1.0;
-           ioff = 1;
-        }
-
-        ww = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k+koff)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j,k)*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - umac(i+1,j+joff,k+koff)*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * umac(i+1,j+joff,k+koff);
-
-        gamma = gamma - dt*gamma2/(3.0*hx);
-
-        ////////////////////////////////////////////////
-        // correct \Gamma^{y-} with \Gamma^{y-,x-}
-        ////////////////////////////////////////////////
-
-        if (umac(i,j+joff,k+koff) > 0.0) {
-           isign = 1.0;
-           ioff = -1;
-        } else {
-           isign = -1.0;
-           ioff = 0;
-        }
-
-        ww = 0.0;
-        if (wmac(i,j,k)*wmac(i+ioff,j+joff,k) > 0.0) {
-           ww = wmac(i+ioff,j+joff,k);
-        }
-
-        vv = 0.0;
-        if (vmac(i,j,k+koff)*vmac(i+ioff,j,k+koff) > 0.0) {
-           vv = vmac(i+ioff,j,k+koff);
-        }
-
-        p1(1) = isign*0.5*hx;
-        p1(2) = jsign*0.5*hy;
-        p1(3) = ksign*0.5*hz;
-
-        p2(1) = isign*0.5*hx;
-        p2(2) = jsign*0.5*hy;
-        p2(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p3(1) = isign*0.5*hx;
-        p3(2) = jsign*0.5*hy - vmac(i+ioff,j,k)*dt;
-        p3(3) = ksign*0.5*hz - wmac(i,j,k)*dt;
-
-        p4(1) = isign*0.5*hx - umac(i,j+joff,k+koff)*dt;
-        p4(2) = jsign*0.5*hy - vv*dt;
-        p4(3) = ksign*0.5*hz - ww*dt;
-
-        for(int n=1; n<=7; ++n){
-            slope_tmp(n) = slopes(i+ioff,j+joff,k+koff,n-1);
-        }
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = (p1(ll)+p2(ll)+p3(ll)+p4(ll))/4.0;
-        }
-        val1 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p1(ll) + sixth*(p2(ll)+p3(ll)+p4(ll));
-        }
-        val2 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p2(ll) + sixth*(p1(ll)+p3(ll)+p4(ll));
-        }
-        val3 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p3(ll) + sixth*(p2(ll)+p1(ll)+p4(ll));
-        }
-        val4 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        for(int ll=1; ll<=3; ++ll ){
-           del(ll) = 0.5*p4(ll) + sixth*(p2(ll)+p3(ll)+p1(ll));
-        }
-        val5 = eval(s(i+ioff,j+joff,k+koff,icomp),slope_tmp,del);
-
-        gamma2 = -0.8*val1 + 0.45*(val2+val3+val4+val5);
-
-        // divu source term
-        if (iconserv[icomp]) {
-            gamma2 = gamma2*(1. - dt4*divu(i+ioff,j+joff,k+koff));
-        }
-
-        gamma2 = gamma2 * umac(i,j+joff,k+koff);
-
-        gamma = gamma + dt*gamma2/(3.0*hx);
-
-        ////////////////////////////////////////////////
-        // correct sedgez with \Gamma^{y-}
-        ////////////////////////////////////////////////
-
-        gamma = gamma * vmac(i,j,k+koff);
-        sedgez(i,j,k,icomp) = zedge_tmp + dt*gamma/(2.0*hy);
-    });
+            // set edge values equal to the ghost cell value since they store the physical condition on the boundary
+            if ( f[d]==dlo[d] && lo_physbc ) {
+                IntVect g = f;
+                g[d] -= 1;
+                sedge[d](f,icomp) = s(g,icomp);
+                if (is_velocity && icomp == XVEL+d && (bc.lo(d) == BCType::foextrap ||  bc.lo(d) == BCType::hoextrap) ) {
+                    // make sure velocity is not blowing inward
+                    sedge[d](f,icomp) = amrex::min(0._rt,sedge[d](f,icomp));
+                }
+            } else if ( f[d]==dhi[d]+1 && hi_physbc ) {
+                sedge[d](f,icomp) = s(f,icomp);
+                if (is_velocity && icomp == XVEL+d && (bc.hi(d) == BCType::foextrap ||  bc.hi(d) == BCType::hoextrap) ) {
+                    // make sure velocity is not blowing inward
+                    sedge[d](f,icomp) = amrex::max(0._rt,sedge[d](f,icomp));
+                }
+            } else {
+                sedge[d](f,icomp) = edge(i,j,k,icomp);
+            }
+        });
+    }
 }
 
 /** @} */
-
@@ -9,8 +9,11 @@
 #include <hydro_godunov.H>
 #include <hydro_redistribution.H>
 #include <hydro_utils.H>
+#include <hydro_utils_K.H>
 #include <hydro_constants.H>
 
+#include <AMReX_MFParallelFor.H>
+
 using namespace amrex;
 
 
@@ -38,12 +41,24 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                          Vector<int>& iconserv,
                          const Real dt,
                          const bool is_velocity,
-                         std::string redistribution_type)
+                         std::string const& redistribution_type,
+                         HydroUtils::AdvectionDiagnostics* diagnostics,
+                         const bool fuse_boxes)
 {
     BL_PROFILE("EBGodunov::ComputeAofs()");
 
+    // Resolve the redistribution scheme once rather than on every tile
+    const auto redist_type = HydroUtils::RedistTypeFromString(redistribution_type);
+
     bool fluxes_are_area_weighted = true;
 
+    // Optional diagnostics, reduced in the kernels that finish aofs on each tile
+    std::unique_ptr<HydroUtils::AdvectionDiagnosticsReduction> diag_reduction;
+    if (diagnostics) {
+        diag_reduction = std::make_unique<HydroUtils::AdvectionDiagnosticsReduction>(
+            ncomp, geom, fluxes_are_area_weighted);
+    }
+
     // Make a device copy of the iconserv vector for use in kernels
     Gpu::DeviceVector<int> iconserv_d(iconserv.size());
     Gpu::copy(Gpu::hostToDevice, iconserv.begin(), iconserv.end(), iconserv_d.begin());
@@ -62,37 +77,102 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
     MultiFab advc(state.boxArray(),state.DistributionMap(),ncomp,3,MFInfo(),ebfact);
     advc.setVal(0.);
 
-    // if we need convective form, we must also compute
-    // div(u_mac)
-    MultiFab divu_mac(state.boxArray(),state.DistributionMap(),1,0, MFInfo(), ebfact);
-    for (Long i = 0; i < iconserv.size(); ++i)
-    {
-        if (!iconserv[i])
-        {
-            Array<MultiFab const*,AMREX_SPACEDIM> u;
-            AMREX_D_TERM(u[0] = &umac;,
-                         u[1] = &vmac;,
-                         u[2] = &wmac;);
-
-            if (!ebfact.isAllRegular())
-                amrex::EB_computeDivergence(divu_mac,u,geom,true);
-            else
-                amrex::computeDivergence(divu_mac,u,geom);
-
-            break;
-        }
-    }
+    // if we need convective form, we also need div(u_mac). It is computed
+    // inline from the face velocities and area fractions of each tile.
+    const auto dxinv  = geom.InvCellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const bool is_rz  = geom.IsRZ();
 
     // Compute -div instead of computing div -- this is just for consistency
     // with the way we HAVE to do it for EB (because redistribution operates on
     // -div rather than div
     Real mult = -1.0;
 
+    //
+    // With fuse_boxes on the GPU, the boxes that are regular with 3 ghost
+    // cells (see below) go through plain Godunov in one launch per step over
+    // the level, and are skipped by the tile loop
+    //
+    const bool fuse_regular = fuse_boxes && Gpu::inLaunchRegion();
+    Vector<int> fused_box(aofs.local_size(), 0);
+    Gpu::DeviceVector<int> fused_box_d;
+    if (fuse_regular)
+    {
+        for (MFIter mfi(aofs); mfi.isValid(); ++mfi)
+        {
+            fused_box[mfi.LocalIndex()] =
+                (flags[mfi].getType(amrex::grow(mfi.validbox(),3)) == FabType::regular);
+        }
+        fused_box_d.resize(fused_box.size());
+        Gpu::copy(Gpu::hostToDevice, fused_box.begin(), fused_box.end(), fused_box_d.begin());
+        int const* box_mask = fused_box_d.data();
+
+        if (!known_edgestate)
+        {
+            Godunov::ComputeEdgeState( ncomp, state, state_comp,
+                                       AMREX_D_DECL( xedge, yedge, zedge ), edge_comp,
+                                       AMREX_D_DECL( umac, vmac, wmac ),
+                                       divu, fq, fq_comp,
+                                       geom, dt, d_bc,
+                                       iconserv_ptr,
+                                       false,
+                                       false,
+                                       is_velocity,
+                                       fused_box.data() );
+        }
+
+        HydroUtils::ComputeFluxes( AMREX_D_DECL( xfluxes, yfluxes, zfluxes ), fluxes_comp,
+                                   AMREX_D_DECL( umac, vmac, wmac ),
+                                   AMREX_D_DECL( xedge, yedge, zedge ), edge_comp,
+                                   geom, ncomp, IntVect(0), box_mask );
+
+        const auto dx   = geom.CellSizeArray();
+        const Real qvol = AMREX_D_TERM(dxinv[0],*dxinv[1],*dxinv[2]);
+
+        AMREX_D_TERM( auto const& ma_u = umac.const_arrays();,
+                      auto const& ma_v = vmac.const_arrays();,
+                      auto const& ma_w = wmac.const_arrays(););
+        AMREX_D_TERM( auto const& ma_xed = xedge.const_arrays();,
+                      auto const& ma_yed = yedge.const_arrays();,
+                      auto const& ma_zed = zedge.const_arrays(););
+        AMREX_D_TERM( auto const& ma_fx = xfluxes.const_arrays();,
+                      auto const& ma_fy = yfluxes.const_arrays();,
+                      auto const& ma_fz = zfluxes.const_arrays(););
+        auto const& ma_advc = advc.arrays();
+
+        // -div(F), plus q div(umac) for the convective components
+        amrex::ParallelFor(advc, IntVect(0), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            if (!box_mask[box]) { return; }
+
+            Real d = mult * HydroUtils::flux_divergence(i, j, k, n + fluxes_comp,
+                                                        AMREX_D_DECL(ma_fx[box], ma_fy[box], ma_fz[box]),
+                                                        qvol, dx, problo, is_rz);
+            if (!iconserv_ptr[n])
+            {
+                const int ne = n + edge_comp;
+                Real q = ma_xed[box](i,j,k,ne) + ma_xed[box](i+1,j,k,ne)
+                       + ma_yed[box](i,j,k,ne) + ma_yed[box](i,j+1,k,ne);
+#if (AMREX_SPACEDIM == 2)
+                q *= 0.25;
+#else
+                q += ma_zed[box](i,j,k,ne) + ma_zed[box](i,j,k+1,ne);
+                q /= 6.0;
+#endif
+                d += q*HydroUtils::umac_divergence(i,j,k,AMREX_D_DECL(ma_u[box],ma_v[box],ma_w[box]),
+                                                   dxinv,problo,is_rz);
+            }
+            ma_advc[box](i,j,k,n) = d;
+        });
+    }
+
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
     for (MFIter mfi(aofs, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
+        if (fused_box[mfi.LocalIndex()]) { continue; }
 
         const Box& bx   = mfi.tilebox();
 
@@ -174,7 +254,6 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                                            mult, fluxes_are_area_weighted);
 
             // Compute the convective form if needed by accounting for extra term
-            auto const& divu_arr  = divu_mac.array(mfi);
             amrex::ParallelFor(bx, ncomp, [=]
             AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
             {
@@ -188,7 +267,8 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                     q += zed(i,j,k,n) + zed(i,j,k+1,n);
                     q /= 6.0;
 #endif
-                    advc_arr(i,j,k,n) += q*divu_arr(i,j,k);
+                    advc_arr(i,j,k,n) += q*HydroUtils::umac_divergence(i,j,k,AMREX_D_DECL(u,v,w),
+                                                                        dxinv,problo,is_rz);
                 }
             });
 
@@ -210,7 +290,7 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
         //FIXME - compare to HydroUtils which hard codes 4 ghost cells for all
             int ngrow = 4;
 
-            if (redistribution_type=="StateRedist")
+            if (redist_type == HydroUtils::RedistType::StateRedist)
                 ++ngrow;
 
             FArrayBox tmpfab(amrex::grow(bx,ngrow),  (4*AMREX_SPACEDIM + 2)*ncomp);
@@ -252,7 +332,6 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                                               mult, fluxes_are_area_weighted);
 
             // Compute the convective form if needed by accounting for extra term
-            auto const& divu_arr  = divu_mac.array(mfi);
             amrex::ParallelFor(bx, ncomp, [=]
             AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
             {
@@ -268,7 +347,11 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                     q += zed(i,j,k,n)*apz(i,j,k) + zed(i,j,k+1,n)*apz(i,j,k+1);
                     q /= (apx(i,j,k)+apx(i+1,j,k)+apy(i,j,k)+apy(i,j+1,k)+apz(i,j,k)+apz(i,j,k+1));
 #endif
-                    advc_arr(i,j,k,n) += q*divu_arr(i,j,k);
+                    Real divu_c = ( AMREX_D_TERM(  dxinv[0] * (apx(i+1,j,k)*u(i+1,j,k) - apx(i,j,k)*u(i,j,k)),
+                                                 + dxinv[1] * (apy(i,j+1,k)*v(i,j+1,k) - apy(i,j,k)*v(i,j,k)),
+                                                 + dxinv[2] * (apz(i,j,k+1)*w(i,j,k+1) - apz(i,j,k)*w(i,j,k))) )
+                                  / vfrac_arr(i,j,k);
+                    advc_arr(i,j,k,n) += q*divu_c;
           }
                  }
             });
@@ -276,7 +359,24 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
     }
     }
 
-    advc.FillBoundary(geom.periodicity());
+    //
+    // Only the redistribution that reaches into the ghost cells of advc has to
+    // wait for the halo exchange. Pass 0 runs while it is in flight: tiles whose
+    // grow(bx,4) is regular only use advc in their own cells, and cut tiles
+    // redistribute the cells whose stencil stays inside the valid box. Pass 1
+    // finishes the strips of the cut tiles along the box boundary.
+    //
+    advc.FillBoundary_nowait(geom.periodicity());
+
+    // Reach of the redistribution stencil into advc, see the scratch box below
+    const int redist_halo = (redist_type == HydroUtils::RedistType::StateRedist) ? 3 :
+                            (redist_type == HydroUtils::RedistType::FluxRedist)  ? 2 : 0;
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      if (pass == 1) {
+        advc.FillBoundary_finish();
+      }
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -290,12 +390,33 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
     auto const& aofs_arr = aofs.array(mfi, aofs_comp);
     auto const& advc_arr = advc.array(mfi);
 
+        // Read by the diagnostics, if any, in the kernels that flip the sign
+        HydroUtils::AdvectionDiagnosticsTile const diag_tile{
+            {AMREX_D_DECL(umac.const_array(mfi), vmac.const_array(mfi), wmac.const_array(mfi))},
+            {AMREX_D_DECL(xfluxes.const_array(mfi,fluxes_comp),
+                          yfluxes.const_array(mfi,fluxes_comp),
+                          zfluxes.const_array(mfi,fluxes_comp))},
+            vfrac.const_array(mfi)};
+
         if (flagfab.getType(bx) != FabType::covered )
     {
       // FIXME? not sure if 4 is really needed or if 3 could do
       // But this is a safe choice
       if (flagfab.getType(grow(bx,4)) != FabType::regular)
       {
+        const Box interior = bx & amrex::grow(mfi.validbox(),-redist_halo);
+
+        BoxList bl;
+        if (pass == 0) {
+          if (interior.ok()) { bl.push_back(interior); }
+        } else {
+          if (interior.ok()) {
+            bl = amrex::boxDiff(bx, interior);
+          } else {
+            bl.push_back(bx);
+          }
+        }
+
         //
         // Redistribute
         //
@@ -308,53 +429,60 @@ EBGodunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
               Array4<Real const> fcz = ebfact.getFaceCent()[2]->const_array(mfi););
 
         Array4<Real const> ccc = ebfact.getCentroid().const_array(mfi);
-            Array4<Real const> const& vfrac_arr = vfrac.const_array(mfi);
-
-        // This is scratch space if calling StateRedistribute,
-            //  but is used as the weights (here set to 1) if calling
-            //  FluxRedistribute
-        Box gbx = bx;
-
-        if (redistribution_type == "StateRedist")
-          gbx.grow(3);
-        else if (redistribution_type == "FluxRedist")
-          gbx.grow(2);
+        Array4<Real const> const& vfrac_arr = vfrac.const_array(mfi);
 
-        FArrayBox tmpfab(gbx, ncomp);
-        Elixir eli = tmpfab.elixir();
-            Array4<Real> scratch = tmpfab.array(0);
-            if (redistribution_type == "FluxRedist")
-            {
-                amrex::ParallelFor(Box(scratch),
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                { scratch(i,j,k) = 1.;});
-            }
+        for (Box const& b : bl)
+        {
+          // This is scratch space if calling StateRedistribute,
+          //  but is used as the weights (here set to 1) if calling
+          //  FluxRedistribute
+          Box gbx = b;
+
+          if (redist_type == HydroUtils::RedistType::StateRedist)
+            gbx.grow(3);
+          else if (redist_type == HydroUtils::RedistType::FluxRedist)
+            gbx.grow(2);
+
+          FArrayBox tmpfab(gbx, ncomp);
+          Elixir eli = tmpfab.elixir();
+          Array4<Real> scratch = tmpfab.array(0);
+          if (redist_type == HydroUtils::RedistType::FluxRedist)
+          {
+            amrex::ParallelFor(Box(scratch),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            { scratch(i,j,k) = 1.;});
+          }
 
-        Redistribution::Apply( bx, ncomp, aofs_arr, advc.array(mfi),
-                   state.const_array(mfi, state_comp), scratch, flag,
-                   AMREX_D_DECL(apx,apy,apz), vfrac_arr,
+          Redistribution::Apply( b, ncomp, aofs_arr, advc_arr,
+                     state.const_array(mfi, state_comp), scratch, flag,
+                     AMREX_D_DECL(apx,apy,apz), vfrac_arr,
 #ifdef AMREX_USE_MOVING_EB
-                   AMREX_D_DECL(apx,apy,apz), vfrac_arr,
+                     AMREX_D_DECL(apx,apy,apz), vfrac_arr,
 #endif
-                   AMREX_D_DECL(fcx,fcy,fcz), ccc, d_bc,
-                                   geom, dt, redistribution_type );
+                     AMREX_D_DECL(fcx,fcy,fcz), ccc, d_bc,
+                     geom, dt, redist_type );
 
-        // Change sign because we computed -div for all cases
-        amrex::ParallelFor(bx, ncomp, [aofs_arr]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        { aofs_arr( i, j, k, n ) *=  - 1.0; });
+          // Change sign because we computed -div for all cases
+          HydroUtils::ParallelForWithDiagnostics(diag_reduction.get(), b, ncomp, aofs_arr, diag_tile,
+          [aofs_arr] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+          { aofs_arr( i, j, k, n ) *=  - 1.0; });
+        }
       }
-      else
+      else if (pass == 0)
       {
-        // Change sign because for EB we computed -div
-            amrex::ParallelFor(bx, ncomp, [aofs_arr, advc_arr]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        { aofs_arr( i, j, k, n ) =  -advc_arr(i,j,k,n); });
+        // Change sign because we computed -div for all cases
+        HydroUtils::ParallelForWithDiagnostics(diag_reduction.get(), bx, ncomp, aofs_arr, diag_tile,
+        [aofs_arr, advc_arr] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        { aofs_arr( i, j, k, n ) =  - advc_arr(i,j,k,n); });
       }
     }
     }
-}
+    }
 
+    if (diag_reduction) {
+        diag_reduction->finalize(*diagnostics);
+    }
+}
 
 void
 EBGodunov::ComputeSyncAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
@@ -383,10 +511,13 @@ EBGodunov::ComputeSyncAofs ( MultiFab& aofs, const int aofs_comp, const int ncom
                              Gpu::DeviceVector<int>& iconserv,
                              const Real dt,
                              const bool is_velocity,
-                             std::string redistribution_type )
+                             std::string const& redistribution_type )
 {
     BL_PROFILE("EBGodunov::ComputeSyncAofs()");
 
+    // Resolve the redistribution scheme once rather than on every tile
+    const auto redist_type = HydroUtils::RedistTypeFromString(redistribution_type);
+
     bool fluxes_are_area_weighted = true;
 
     AMREX_ALWAYS_ASSERT(state.hasEBFabFactory());
@@ -560,7 +691,7 @@ EBGodunov::ComputeSyncAofs ( MultiFab& aofs, const int aofs_comp, const int ncom
 
     MultiFab sstate_tmp;
     MultiFab* sstate;
-    if (redistribution_type == "StateRedist")
+    if (redist_type == HydroUtils::RedistType::StateRedist)
     {
       // Create temporary holder for sync "state" passed in via aofs
       // Do this so we're not overwriting the "state" as we go through the redistribution
@@ -614,15 +745,15 @@ EBGodunov::ComputeSyncAofs ( MultiFab& aofs, const int aofs_comp, const int ncom
             //  FluxRedistribute
         Box gbx = bx;
 
-        if (redistribution_type == "StateRedist")
+        if (redist_type == HydroUtils::RedistType::StateRedist)
           gbx.grow(3);
-        else if (redistribution_type == "FluxRedist")
+        else if (redist_type == HydroUtils::RedistType::FluxRedist)
           gbx.grow(2);
 
         FArrayBox tmpfab(gbx, ncomp*2);
         Elixir eli = tmpfab.elixir();
             Array4<Real> scratch = tmpfab.array(0);
-            if (redistribution_type == "FluxRedist")
+            if (redist_type == HydroUtils::RedistType::FluxRedist)
             {
                 amrex::ParallelFor(Box(scratch),
                 [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -642,7 +773,7 @@ EBGodunov::ComputeSyncAofs ( MultiFab& aofs, const int aofs_comp, const int ncom
                                    AMREX_D_DECL(apx,apy,apz), vfrac_arr,
 #endif
                                    AMREX_D_DECL(fcx,fcy,fcz), ccent_arr, d_bc,
-                                   geom, dt, redistribution_type );
+                                   geom, dt, redist_type );
 
             // Subtract contribution to sync aofs -- sign of divergence is aofs is opposite
             // of sign to div computed by EB_ComputeDivergence, thus it must be subtracted.
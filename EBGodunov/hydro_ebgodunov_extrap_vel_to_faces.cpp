@@ -52,11 +52,12 @@ EBGodunov::ExtrapVelToFaces ( MultiFab const& vel,
     auto const& vfrac = ebfact.getVolFrac();
     auto const& areafrac = ebfact.getAreaFrac();
 
-    // Since we don't fill all the ghost cells in the mac vel arrays
-    // we need to initialize to something which won't make the code crash
-    AMREX_D_TERM( u_mac.setVal(1.e40);,
-                  v_mac.setVal(1.e40);,
-                  w_mac.setVal(1.e40););
+    // Since we don't fill the ghost cells in the mac vel arrays
+    // we need to initialize them to something which won't make the code crash.
+    // The valid faces are all written below, except on covered tiles.
+    AMREX_D_TERM( u_mac.setBndry(1.e40);,
+                  v_mac.setBndry(1.e40);,
+                  w_mac.setBndry(1.e40););
 
     const int ncomp = AMREX_SPACEDIM;
 #ifdef _OPENMP
@@ -78,80 +79,92 @@ EBGodunov::ExtrapVelToFaces ( MultiFab const& vel,
             Array4<Real const> const& a_vel = vel.const_array(mfi);
             Array4<Real const> const& a_f = vel_forces.const_array(mfi);
 
-        // In 2-d:
-        //  8*ncomp are:  Imx, Ipx, Imy, Ipy, xlo/xhi, ylo/yhi
-        //  2       are:  u_ad, v_ad
-        // In 3-d:
-        // 12*ncomp are:  Imx, Ipx, Imy, Ipy, Imz, Ipz, xlo/xhi, ylo/yhi, zlo/zhi
-        //  3       are:  u_ad, v_ad, w_ad
-        //
-        // This over-allots for EB regular boxes, which need grow(bx,1)
-        // vs. grow(bx,2) here. EB needs the 2nd ghost cell for creating
-        // the transverse terms.
-        Box const& bxg2 = amrex::grow(bx,2);
-        scratch.resize(bxg2, (4*ncomp + 1)*AMREX_SPACEDIM);
-        Real* p  = scratch.dataPtr();
-
             AMREX_D_TERM(Box const& xbx = mfi.nodaltilebox(0);,
                          Box const& ybx = mfi.nodaltilebox(1);,
                          Box const& zbx = mfi.nodaltilebox(2));;
 
+            // This tests on covered cells just in the box itself.
+            // Nothing is computed on covered tiles; give their faces the
+            // value the ghost faces get.
+            if (flagfab.getType(bx) == FabType::covered)
+            {
+                AMREX_D_TERM(
+                amrex::ParallelFor(xbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                { a_umac(i,j,k) = 1.e40; });,
+                amrex::ParallelFor(ybx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                { a_vmac(i,j,k) = 1.e40; });,
+                amrex::ParallelFor(zbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                { a_wmac(i,j,k) = 1.e40; }););
+                continue;
+            }
+
+            // Test includes 3 rows of ghost cells.
+            // Godunov::ExtrapVelToFacesOnBox is callled on bx => need u_ad on
+            // xebx_g1 (not xebx_g2 as in EB). Then need PredictVelOnXFace on
+            // xebx_g1, which will call slopes on cell (i-1), slopes uses cell (i-1)-2
+            // => check regular on grow 3
+            const bool regular = (flagfab.getType(amrex::grow(bx,3)) == FabType::regular);
+
 #if (AMREX_SPACEDIM == 2)
+        Box xebx_g1(Box(bx).grow(1,1).surroundingNodes(0));
+        Box yebx_g1(Box(bx).grow(0,1).surroundingNodes(1));
         Box xebx_g2(Box(bx).grow(1).grow(1,1).surroundingNodes(0));
         Box yebx_g2(Box(bx).grow(1).grow(0,1).surroundingNodes(1));
 #else
+        Box xebx_g1(Box(bx).grow(1,1).grow(2,1).surroundingNodes(0));
+        Box yebx_g1(Box(bx).grow(0,1).grow(2,1).surroundingNodes(1));
+        Box zebx_g1(Box(bx).grow(0,1).grow(1,1).surroundingNodes(2));
         Box xebx_g2(Box(bx).grow(1).grow(1,1).grow(2,1).surroundingNodes(0));
         Box yebx_g2(Box(bx).grow(1).grow(0,1).grow(2,1).surroundingNodes(1));
         Box zebx_g2(Box(bx).grow(1).grow(0,1).grow(1,1).surroundingNodes(2));
 #endif
 
-        Array4<Real> Imx = makeArray4(p,bxg2,ncomp);
+        // The scratch is sized for what the tile type needs. Regular tiles
+        // use the Godunov path on grow(bx,1):
+        //  2*AMREX_SPACEDIM*ncomp are:  Imx, Ipx, Imy, Ipy(, Imz, Ipz),
+        //                               overwritten by xlo/xhi, ylo/yhi(, zlo/zhi)
+        //  AMREX_SPACEDIM         are:  u_ad, v_ad(, w_ad)
+        //  AMREX_SPACEDIM-1       are:  the corner-coupled states
+        // EB tiles need the 2nd ghost cell for creating the transverse terms
+        // and use grow(bx,2):
+        //  4*AMREX_SPACEDIM*ncomp are:  Imx, Ipx, Imy, Ipy(, Imz, Ipz),
+        //                               xlo/xhi, ylo/yhi(, zlo/zhi)
+        //  AMREX_SPACEDIM         are:  u_ad, v_ad(, w_ad)
+        Box const& bxg = amrex::grow(bx, regular ? 1 : 2);
+        scratch.resize(bxg, regular ? (2*ncomp + 1)*AMREX_SPACEDIM + AMREX_SPACEDIM-1
+                                    : (4*ncomp + 1)*AMREX_SPACEDIM);
+        Real* p  = scratch.dataPtr();
+
+        AMREX_D_TERM(Box const& xebx = regular ? xebx_g1 : xebx_g2;,
+                     Box const& yebx = regular ? yebx_g1 : yebx_g2;,
+                     Box const& zebx = regular ? zebx_g1 : zebx_g2;);
+
+        Array4<Real> Imx = makeArray4(p,bxg,ncomp);
         p +=         Imx.size();
-        Array4<Real> Ipx = makeArray4(p,bxg2,ncomp);
+        Array4<Real> Ipx = makeArray4(p,bxg,ncomp);
         p +=         Ipx.size();
-        Array4<Real> Imy = makeArray4(p,bxg2,ncomp);
+        Array4<Real> Imy = makeArray4(p,bxg,ncomp);
         p +=         Imy.size();
-        Array4<Real> Ipy = makeArray4(p,bxg2,ncomp);
+        Array4<Real> Ipy = makeArray4(p,bxg,ncomp);
         p +=         Ipy.size();
 
-        Array4<Real> u_ad = makeArray4(p,xebx_g2,1);
+        Array4<Real> u_ad = makeArray4(p,xebx,1);
         p +=         u_ad.size();
-        Array4<Real> v_ad = makeArray4(p,yebx_g2,1);
+        Array4<Real> v_ad = makeArray4(p,yebx,1);
         p +=         v_ad.size();
 
 #if (AMREX_SPACEDIM == 3)
-        Array4<Real> Imz = makeArray4(p,bxg2,ncomp);
+        Array4<Real> Imz = makeArray4(p,bxg,ncomp);
         p +=         Imz.size();
-        Array4<Real> Ipz = makeArray4(p,bxg2,ncomp);
+        Array4<Real> Ipz = makeArray4(p,bxg,ncomp);
         p +=         Ipz.size();
 
-        Array4<Real> w_ad = makeArray4(p,zebx_g2,1);
+        Array4<Real> w_ad = makeArray4(p,zebx,1);
         p +=         w_ad.size();
 #endif
 
-            // This tests on covered cells just in the box itself
-            if (flagfab.getType(bx) == FabType::covered)
-            {
-                // We shouldn't need to zero these
-
-            }
-            // Test includes 3 rows of ghost cells.
-        // Godunov::ExtrapVelToFacesOnBox is callled on bx => need u_ad on
-        // xebx_g1 (not xebx_g2 as in EB). Then need PredictVelOnXFace on
-        // xebx_g1, which will call slopes on cell (i-1), slopes uses cell (i-1)-2
-        // => check regular on grow 3
-            else if (flagfab.getType(amrex::grow(bx,3)) == FabType::regular)
+            if (regular)
             {
-
-#if (AMREX_SPACEDIM == 2)
-        Box xebx_g1(Box(bx).grow(1,1).surroundingNodes(0));
-        Box yebx_g1(Box(bx).grow(0,1).surroundingNodes(1));
-#else
-        Box xebx_g1(Box(bx).grow(1,1).grow(2,1).surroundingNodes(0));
-        Box yebx_g1(Box(bx).grow(0,1).grow(2,1).surroundingNodes(1));
-        Box zebx_g1(Box(bx).grow(0,1).grow(1,1).surroundingNodes(2));
-#endif
-
             PLM::PredictVelOnXFace( xebx_g1, AMREX_SPACEDIM, Imx, Ipx, a_vel, a_vel,
                     geom, l_dt, h_bcrec, d_bcrec);
 
@@ -164,14 +177,8 @@ EBGodunov::ExtrapVelToFaces ( MultiFab const& vel,
 #endif
 
 
+                // ExtrapVelToFacesOnBox also computes u_ad, v_ad and w_ad
                 bool local_use_forces_in_trans = false;
-                Godunov::ComputeAdvectiveVel( AMREX_D_DECL(xebx_g1, yebx_g1, zebx_g1),
-                                              AMREX_D_DECL(u_ad, v_ad, w_ad),
-                                              AMREX_D_DECL(Imx, Imy, Imz),
-                                              AMREX_D_DECL(Ipx, Ipy, Ipz),
-                                              a_vel, a_f, domain, l_dt, d_bcrec,
-                                              local_use_forces_in_trans);
-
                 Godunov::ExtrapVelToFacesOnBox( bx, ncomp,
                                                 AMREX_D_DECL(xbx, ybx, zbx),
                                                 AMREX_D_DECL(a_umac, a_vmac, a_wmac),
@@ -184,7 +184,31 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
         yzlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_yzhi + l_yzlo);
     });
-    //
+
+    // The transverse terms of each cell are shared by its low and high x-faces,
+    // so compute them once per cell
+    Array4<Real> xtrans = makeArray4(Ipx.dataPtr() + divu.size(), xbxtmp, 1);
+    amrex::ParallelFor(xbxtmp, [=] AMREX_GPU_DEVICE (int ic, int j, int k) noexcept
+    {
+        if (flag(ic,j,k).isRegular())
+        {
+            xtrans(ic,j,k) = - (0.25*l_dt/dy)*(v_ad(ic,j+1,k  )+v_ad(ic,j,k))*
+                                              (yzlo(ic,j+1,k  )-yzlo(ic,j,k))
+                             - (0.25*l_dt/dz)*(w_ad(ic,j  ,k+1)+w_ad(ic,j,k))*
+                                              (zylo(ic,j  ,k+1)-zylo(ic,j,k));
+        }
+        else if (apy(ic,j+1,k) > 0. && apy(ic,j,k) > 0. &&
+                 apz(ic,j,k+1) > 0. && apz(ic,j,k) > 0.)
+        {
+            Real trans_y, trans_z;
+            create_transverse_terms_for_xface(ic, j, k, v_ad, w_ad, yzlo, zylo,
+                                              apy, apz, fcy, fcz, trans_y, trans_z,
+                                              dy, dz);
+
+            xtrans(ic,j,k) = -0.5 * l_dt * (trans_y + trans_z);
+        }
+    });
+
     amrex::ParallelFor(xbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
         if (flag(i,j,k).isConnected(-1,0,0))
@@ -197,8 +221,6 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         Real stl = xlo(i,j,k,n);
         Real sth = xhi(i,j,k,n);
 
-        Real trans_y, trans_z;
-
         //
         // Left side of interface
         //
@@ -210,22 +232,14 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         int ic = i-1;
         if (flag(ic,j,k).isRegular() &&  no_eb_flow_xlo)
         {
-            stl += - (0.25*l_dt/dy)*(v_ad(ic,j+1,k  )+v_ad(ic,j,k))*
-                                    (yzlo(ic,j+1,k  )-yzlo(ic,j,k))
-                   - (0.25*l_dt/dz)*(w_ad(ic,j  ,k+1)+w_ad(ic,j,k))*
-                                    (zylo(ic,j  ,k+1)-zylo(ic,j,k))
-                   + 0.5 * l_dt * f(ic,j,k,n);
+            stl += xtrans(ic,j,k) + 0.5 * l_dt * f(ic,j,k,n);
 
         // Only add dt-based terms if we can construct all transverse terms
         //    using non-covered faces
         } else if (apy(ic,j+1,k) > 0. && apy(ic,j,k) > 0. &&
                    apz(ic,j,k+1) > 0. && apz(ic,j,k) > 0. && no_eb_flow_xlo)
         {
-            create_transverse_terms_for_xface(ic, j, k, v_ad, w_ad, yzlo, zylo,
-                                              apy, apz, fcy, fcz, trans_y, trans_z,
-                                              dy, dz);
-
-            stl += -0.5 * l_dt * (trans_y + trans_z);
+            stl += xtrans(ic,j,k);
             stl +=  0.5 * l_dt * f(ic,j,k,n);
         }
         }
@@ -241,22 +255,14 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         int ic = i;
         if (flag(ic,j,k).isRegular() && no_eb_flow_xhi)
         {
-             sth += - (0.25*l_dt/dy)*(v_ad(ic,j+1,k  )+v_ad(ic,j,k))*
-                                     (yzlo(ic,j+1,k  )-yzlo(ic,j,k))
-                    - (0.25*l_dt/dz)*(w_ad(ic,j  ,k+1)+w_ad(ic,j,k))*
-                                     (zylo(ic,j  ,k+1)-zylo(ic,j,k))
-                 + 0.5 * l_dt * f(ic,j,k,n);
+            sth += xtrans(ic,j,k) + 0.5 * l_dt * f(ic,j,k,n);
 
         // Only add dt-based terms if we can construct all transverse terms
         //    using non-covered faces
         } else if (apy(ic,j+1,k) > 0. && apy(ic,j,k) > 0. &&
                    apz(ic,j,k+1) > 0. && apz(ic,j,k) > 0. && no_eb_flow_xhi)
         {
-            create_transverse_terms_for_xface(ic, j, k, v_ad, w_ad, yzlo, zylo,
-                                              apy, apz, fcy, fcz, trans_y, trans_z,
-                                              dy, dz);
-
-            sth += -0.5 * l_dt * (trans_y + trans_z);
+            sth += xtrans(ic,j,k);
             sth +=  0.5 * l_dt * f(ic,j,k,n);
         }
         }
@@ -336,7 +342,31 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
         zxlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_zxhi + l_zxlo);
     });
-    //
+
+    // The transverse terms of each cell are shared by its low and high y-faces,
+    // so compute them once per cell
+    Array4<Real> ytrans = makeArray4(Ipx.dataPtr() + divu.size(), ybxtmp, 1);
+    amrex::ParallelFor(ybxtmp, [=] AMREX_GPU_DEVICE (int i, int jc, int k) noexcept
+    {
+        if (flag(i,jc,k).isRegular())
+        {
+            ytrans(i,jc,k) = - (0.25*l_dt/dx)*(u_ad(i+1,jc,k  )+u_ad(i,jc,k))*
+                                              (xzlo(i+1,jc,k  )-xzlo(i,jc,k))
+                             - (0.25*l_dt/dz)*(w_ad(i  ,jc,k+1)+w_ad(i,jc,k))*
+                                              (zxlo(i  ,jc,k+1)-zxlo(i,jc,k));
+        }
+        else if (apx(i+1,jc,k  ) > 0. && apx(i,jc,k) > 0. &&
+                 apz(i  ,jc,k+1) > 0. && apz(i,jc,k) > 0.)
+        {
+            Real trans_x, trans_z;
+            create_transverse_terms_for_yface(i, jc, k, u_ad, w_ad, xzlo, zxlo,
+                                              apx, apz, fcx, fcz, trans_x, trans_z,
+                                              dx, dz);
+
+            ytrans(i,jc,k) = -0.5 * l_dt * (trans_x + trans_z);
+        }
+    });
+
     amrex::ParallelFor(ybx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
         if (flag(i,j,k).isConnected(0,-1,0))
@@ -349,8 +379,6 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         Real stl = ylo(i,j,k,n);
         Real sth = yhi(i,j,k,n);
 
-        Real trans_x, trans_z;
-
         //
         // Left side of interface
         //
@@ -362,10 +390,7 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         int jc = j-1;
         if (flag(i,jc,k).isRegular() && no_eb_flow_ylo)
         {
-            stl += - (0.25*l_dt/dx)*(u_ad(i+1,jc,k  )+u_ad(i,jc,k))*
-                                    (xzlo(i+1,jc,k  )-xzlo(i,jc,k))
-                   - (0.25*l_dt/dz)*(w_ad(i  ,jc,k+1)+w_ad(i,jc,k))*
-                                    (zxlo(i  ,jc,k+1)-zxlo(i,jc,k));
+            stl += ytrans(i,jc,k);
             stl +=  0.5 * l_dt * f(i,jc,k,n);
 
         // Only add dt-based terms if we can construct all transverse terms
@@ -373,11 +398,7 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         } else if (apx(i+1,jc,k  ) > 0. && apx(i,jc,k) > 0. &&
                    apz(i  ,jc,k+1) > 0. && apz(i,jc,k) > 0. && no_eb_flow_ylo)
         {
-            create_transverse_terms_for_yface(i, jc, k, u_ad, w_ad, xzlo, zxlo,
-                                              apx, apz, fcx, fcz, trans_x, trans_z,
-                                              dx, dz);
-
-            stl += -0.5 * l_dt * (trans_x + trans_z);
+            stl += ytrans(i,jc,k);
             stl +=  0.5 * l_dt * f(i,jc,k,n);
         }
         }
@@ -393,10 +414,7 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         int jc = j;
         if (flag(i,jc,k).isRegular() && no_eb_flow_yhi)
         {
-            sth += - (0.25*l_dt/dx)*(u_ad(i+1,jc,k  )+u_ad(i,jc,k))*
-                                    (xzlo(i+1,jc,k  )-xzlo(i,jc,k))
-                   - (0.25*l_dt/dz)*(w_ad(i  ,jc,k+1)+w_ad(i,jc,k))*
-                                    (zxlo(i  ,jc,k+1)-zxlo(i,jc,k));
+            sth += ytrans(i,jc,k);
             sth +=  0.5 * l_dt * f(i,jc,k,n);
 
         // Only add dt-based terms if we can construct all transverse terms
@@ -404,11 +422,7 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         } else if (apx(i+1,jc,k  ) > 0. && apx(i,jc,k) > 0. &&
                    apz(i  ,jc,k+1) > 0. && apz(i,jc,k) > 0. && no_eb_flow_yhi)
         {
-            create_transverse_terms_for_yface(i, jc, k, u_ad, w_ad, xzlo, zxlo,
-                                              apx, apz, fcx, fcz, trans_x, trans_z,
-                                              dx, dz);
-
-            sth += -0.5 * l_dt * (trans_x + trans_z);
+            sth += ytrans(i,jc,k);
             sth +=  0.5 * l_dt * f(i,jc,k,n);
         }
         }
@@ -492,7 +506,31 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
         yxlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_yxhi + l_yxlo);
     });
-    //
+
+    // The transverse terms of each cell are shared by its low and high z-faces,
+    // so compute them once per cell
+    Array4<Real> ztrans = makeArray4(Ipx.dataPtr() + divu.size(), zbxtmp, 1);
+    amrex::ParallelFor(zbxtmp, [=] AMREX_GPU_DEVICE (int i, int j, int kc) noexcept
+    {
+        if (flag(i,j,kc).isRegular())
+        {
+            ztrans(i,j,kc) = - (0.25*l_dt/dx)*(u_ad(i+1,j  ,kc)+u_ad(i,j,kc))*
+                                              (xylo(i+1,j  ,kc)-xylo(i,j,kc))
+                             - (0.25*l_dt/dy)*(v_ad(i  ,j+1,kc)+v_ad(i,j,kc))*
+                                              (yxlo(i  ,j+1,kc)-yxlo(i,j,kc));
+        }
+        else if (apx(i+1,j  ,kc) > 0. && apx(i,j,kc) > 0. &&
+                 apy(i  ,j+1,kc) > 0. && apy(i,j,kc) > 0.)
+        {
+            Real trans_x, trans_y;
+            create_transverse_terms_for_zface(i, j, kc, u_ad, v_ad, xylo, yxlo,
+                                              apx, apy, fcx, fcy, trans_x, trans_y,
+                                              dx, dy);
+
+            ztrans(i,j,kc) = -0.5 * l_dt * (trans_x + trans_y);
+        }
+    });
+
     amrex::ParallelFor(zbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
         if (flag(i,j,k).isConnected(0,0,-1))
@@ -505,8 +543,6 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         Real stl = zlo(i,j,k,n);
         Real sth = zhi(i,j,k,n);
 
-        Real trans_x, trans_y;
-
         //
         // Lo side of interface
         //
@@ -518,10 +554,7 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         int kc = k-1;
         if (flag(i,j,kc).isRegular() && no_eb_flow_zlo)
         {
-            stl += - (0.25*l_dt/dx)*(u_ad(i+1,j  ,kc)+u_ad(i,j,kc))*
-                                    (xylo(i+1,j  ,kc)-xylo(i,j,kc))
-                   - (0.25*l_dt/dy)*(v_ad(i  ,j+1,kc)+v_ad(i,j,kc))*
-                                    (yxlo(i  ,j+1,kc)-yxlo(i,j,kc));
+            stl += ztrans(i,j,kc);
             stl +=  0.5 * l_dt * f(i,j,kc,n);
 
         // Only add dt-based terms if we can construct all transverse terms
@@ -529,11 +562,7 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         } else if (apx(i+1,j  ,kc) > 0. && apx(i,j,kc) > 0. &&
                    apy(i  ,j+1,kc) > 0. && apy(i,j,kc) > 0. && no_eb_flow_zlo)
         {
-            create_transverse_terms_for_zface(i, j, kc, u_ad, v_ad, xylo, yxlo,
-                                              apx, apy, fcx, fcy, trans_x, trans_y,
-                                              dx, dy);
-
-            stl += -0.5 * l_dt * (trans_x + trans_y);
+            stl += ztrans(i,j,kc);
             stl +=  0.5 * l_dt * f(i,j,kc,n);
         }
         }
@@ -549,21 +578,14 @@ EBGodunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
         int kc = k;
         if (flag(i,j,kc).isRegular() && no_eb_flow_zhi)
         {
-            sth += - (0.25*l_dt/dx)*(u_ad(i+1,j  ,kc)+u_ad(i,j,kc))*
-                                    (xylo(i+1,j  ,kc)-xylo(i,j,kc))
-                   - (0.25*l_dt/dy)*(v_ad(i  ,j+1,kc)+v_ad(i,j,kc))*
-                                    (yxlo(i  ,j+1,kc)-yxlo(i,j,kc));
+            sth += ztrans(i,j,kc);
             sth +=  0.5 * l_dt * f(i,j,kc,n);
         // Only add dt-based terms if we can construct all transverse terms
         //    using non-covered faces
         } else if (apx(i+1,j  ,kc) > 0. && apx(i,j,kc) > 0. &&
                    apy(i  ,j+1,kc) > 0. && apy(i,j,kc) > 0. && no_eb_flow_zhi)
         {
-            create_transverse_terms_for_zface(i, j, kc, u_ad, v_ad, xylo, yxlo,
-                                              apx, apy, fcx, fcy, trans_x, trans_y,
-                                              dx, dy);
-
-            sth += -0.5 * l_dt * (trans_x + trans_y);
+            sth += ztrans(i,j,kc);
             sth +=  0.5 * l_dt * f(i,j,kc,n);
         }
         }
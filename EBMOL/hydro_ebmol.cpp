@@ -37,12 +37,23 @@ EBMOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
                      Geometry const&  geom,
                      const Real dt,
                      const bool is_velocity,
-                     std::string redistribution_type )
+                     std::string const& redistribution_type,
+                     HydroUtils::AdvectionDiagnostics* diagnostics )
 {
     BL_PROFILE("EBMOL::ComputeAofs()");
 
+    // Resolve the redistribution scheme once rather than on every tile
+    const auto redist_type = HydroUtils::RedistTypeFromString(redistribution_type);
+
     bool fluxes_are_area_weighted = true;
 
+    // Optional diagnostics, reduced in the kernels that finish aofs on each tile
+    std::unique_ptr<HydroUtils::AdvectionDiagnosticsReduction> diag_reduction;
+    if (diagnostics) {
+        diag_reduction = std::make_unique<HydroUtils::AdvectionDiagnosticsReduction>(
+            ncomp, geom, fluxes_are_area_weighted);
+    }
+
     int const* iconserv_ptr = iconserv.data();
 
     AMREX_ALWAYS_ASSERT(aofs.nComp()  >= aofs_comp  + ncomp);
@@ -58,17 +69,24 @@ EBMOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
                   AMREX_ALWAYS_ASSERT(yfluxes.nGrow() == yedge.nGrow());,
                   AMREX_ALWAYS_ASSERT(zfluxes.nGrow() == zedge.nGrow()););
 
-    // To compute edge states, need at least 2 ghost cells in state
-    if ( !known_edgestate )
-        AMREX_ALWAYS_ASSERT(state.nGrow() >= 2);
+    AMREX_ALWAYS_ASSERT(state.hasEBFabFactory());
+    auto const& ebfactory = dynamic_cast<EBFArrayBoxFactory const&>(state.Factory());
+    const bool eb = !ebfactory.isAllRegular();
+
+    // To compute edge states, need at least 2 ghost cells in state, and 3 for
+    //  the state redistribution
+    if ( !known_edgestate ) {
+        AMREX_ALWAYS_ASSERT(state.nGrow() >=
+                            HydroUtils::RequiredGhostCells(HydroUtils::AdvectionScheme::MOL, false, eb, redist_type,
+                                                           known_edgestate).state);
+    }
 
     // If !known_edgestate, need 2 additional cells in state to compute
     //  the slopes needed to compute the edge state, since MOL uses slope
     //  order==2.
-    int halo = known_edgestate ? 0 : 2;
-
-    AMREX_ALWAYS_ASSERT(state.hasEBFabFactory());
-    auto const& ebfactory = dynamic_cast<EBFArrayBoxFactory const&>(state.Factory());
+    int halo = HydroUtils::RequiredGhostCells(HydroUtils::AdvectionScheme::MOL, false, eb,
+                                              HydroUtils::RedistType::NoRedist,
+                                              known_edgestate).state;
 
     // Create temporary holder for advection term. Needed so we can call FillBoundary.
     MultiFab advc(state.boxArray(),state.DistributionMap(),ncomp,3,MFInfo(),ebfactory);
@@ -229,7 +247,24 @@ EBMOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
         }
     }
 
-    advc.FillBoundary(geom.periodicity());
+    //
+    // Only the redistribution that reaches into the ghost cells of advc has to
+    // wait for the halo exchange. Pass 0 runs while it is in flight: tiles whose
+    // grow(bx,4) is regular only use advc in their own cells, and cut tiles
+    // redistribute the cells whose stencil stays inside the valid box. Pass 1
+    // finishes the strips of the cut tiles along the box boundary.
+    //
+    advc.FillBoundary_nowait(geom.periodicity());
+
+    // Reach of the redistribution stencil into advc, see the scratch box below
+    const int redist_halo = (redist_type == HydroUtils::RedistType::StateRedist) ? 3 :
+                            (redist_type == HydroUtils::RedistType::FluxRedist)  ? 2 : 0;
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      if (pass == 1) {
+        advc.FillBoundary_finish();
+      }
 
     if (Gpu::notInLaunchRegion())  mfi_info.EnableTiling().SetDynamic(true);
 #ifdef _OPENMP
@@ -242,6 +277,15 @@ EBMOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
         auto const& flagfab = ebfactory.getMultiEBCellFlagFab()[mfi];
         auto const& flag    = flagfab.const_array();
     auto const& aofs_arr = aofs.array(mfi, aofs_comp);
+    auto const& advc_arr = advc.array(mfi);
+
+        // Read by the diagnostics, if any, in the kernels that flip the sign
+        HydroUtils::AdvectionDiagnosticsTile const diag_tile{
+            {AMREX_D_DECL(umac.const_array(mfi), vmac.const_array(mfi), wmac.const_array(mfi))},
+            {AMREX_D_DECL(xfluxes.const_array(mfi,fluxes_comp),
+                          yfluxes.const_array(mfi,fluxes_comp),
+                          zfluxes.const_array(mfi,fluxes_comp))},
+            ebfactory.getVolFrac().const_array(mfi)};
 
         if (flagfab.getType(bx) != FabType::covered )
     {
@@ -249,6 +293,19 @@ EBMOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
       // But this is a safe choice
       if (flagfab.getType(grow(bx,4)) != FabType::regular)
       {
+        const Box interior = bx & amrex::grow(mfi.validbox(),-redist_halo);
+
+        BoxList bl;
+        if (pass == 0) {
+          if (interior.ok()) { bl.push_back(interior); }
+        } else {
+          if (interior.ok()) {
+            bl = amrex::boxDiff(bx, interior);
+          } else {
+            bl.push_back(bx);
+          }
+        }
+
         //
         // Redistribute
         //
@@ -263,50 +320,57 @@ EBMOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
         Array4<Real const> ccc = ebfactory.getCentroid().const_array(mfi);
         auto vfrac = ebfactory.getVolFrac().const_array(mfi);
 
-        // This is scratch space if calling StateRedistribute,
-            //  but is used as the weights (here set to 1) if calling
-            //  FluxRedistribute
-        Box gbx = bx;
-
-        if (redistribution_type == "StateRedist")
-          gbx.grow(3);
-        else if (redistribution_type == "FluxRedist")
-          gbx.grow(2);
-
-        FArrayBox tmpfab(gbx, ncomp);
-        Elixir eli = tmpfab.elixir();
-        Array4<Real> scratch = tmpfab.array(0);
-        if (redistribution_type == "FluxRedist")
+        for (Box const& b : bl)
         {
-          amrex::ParallelFor(Box(scratch),
-              [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-              { scratch(i,j,k) = 1.;});
-            }
-
-        Redistribution::Apply( bx, ncomp, aofs_arr, advc.array(mfi),
-                   state.const_array(mfi, state_comp), scratch, flag,
-                   AMREX_D_DECL(apx,apy,apz), vfrac,
+          // This is scratch space if calling StateRedistribute,
+          //  but is used as the weights (here set to 1) if calling
+          //  FluxRedistribute
+          Box gbx = b;
+
+          if (redist_type == HydroUtils::RedistType::StateRedist)
+            gbx.grow(3);
+          else if (redist_type == HydroUtils::RedistType::FluxRedist)
+            gbx.grow(2);
+
+          FArrayBox tmpfab(gbx, ncomp);
+          Elixir eli = tmpfab.elixir();
+          Array4<Real> scratch = tmpfab.array(0);
+          if (redist_type == HydroUtils::RedistType::FluxRedist)
+          {
+            amrex::ParallelFor(Box(scratch),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            { scratch(i,j,k) = 1.;});
+          }
+
+          Redistribution::Apply( b, ncomp, aofs_arr, advc_arr,
+                     state.const_array(mfi, state_comp), scratch, flag,
+                     AMREX_D_DECL(apx,apy,apz), vfrac,
 #ifdef AMREX_USE_MOVING_EB
-                   AMREX_D_DECL(apx,apy,apz), vfrac,
+                     AMREX_D_DECL(apx,apy,apz), vfrac,
 #endif
-                   AMREX_D_DECL(fcx,fcy,fcz), ccc, d_bcrec_ptr,
-                   geom, dt, redistribution_type );
+                     AMREX_D_DECL(fcx,fcy,fcz), ccc, d_bcrec_ptr,
+                     geom, dt, redist_type );
 
-        // Change sign because we computed -div for all cases
-        amrex::ParallelFor(bx, ncomp, [aofs_arr]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        { aofs_arr( i, j, k, n ) *=  - 1.0; });
+          // Change sign because we computed -div for all cases
+          HydroUtils::ParallelForWithDiagnostics(diag_reduction.get(), b, ncomp, aofs_arr, diag_tile,
+          [aofs_arr] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+          { aofs_arr( i, j, k, n ) *=  - 1.0; });
+        }
       }
-      else
+      else if (pass == 0)
       {
         // Change sign because we computed -div for all cases
-        auto const& advc_arr = advc.array(mfi);
-        amrex::ParallelFor(bx, ncomp, [aofs_arr, advc_arr]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        HydroUtils::ParallelForWithDiagnostics(diag_reduction.get(), bx, ncomp, aofs_arr, diag_tile,
+        [aofs_arr, advc_arr] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         { aofs_arr( i, j, k, n ) =  - advc_arr(i,j,k,n); });
       }
     }
     }
+    }
+
+    if (diag_reduction) {
+        diag_reduction->finalize(*diagnostics);
+    }
 }
 
 void
@@ -332,10 +396,13 @@ EBMOL::ComputeSyncAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
                          Geometry const&  geom,
                          const Real dt,
                          const bool is_velocity,
-                         std::string redistribution_type )
+                         std::string const& redistribution_type )
 {
     BL_PROFILE("EBMOL::ComputeSyncAofs()");
 
+    // Resolve the redistribution scheme once rather than on every tile
+    const auto redist_type = HydroUtils::RedistTypeFromString(redistribution_type);
+
     bool fluxes_are_area_weighted = true;
 
     AMREX_ALWAYS_ASSERT(state.nComp() >= state_comp + ncomp);
@@ -351,15 +418,22 @@ EBMOL::ComputeSyncAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
                   AMREX_ALWAYS_ASSERT(zfluxes.nGrow() == zedge.nGrow()););
 
 
-    // To compute edge states, need at least 2 ghost cells in state
-    if ( !known_edgestate )
-        AMREX_ALWAYS_ASSERT(state.nGrow() >= 2);
-
     AMREX_ALWAYS_ASSERT(state.hasEBFabFactory());
     auto const& ebfactory = dynamic_cast<EBFArrayBoxFactory const&>(state.Factory());
+    const bool eb = !ebfactory.isAllRegular();
+
+    // To compute edge states, need at least 2 ghost cells in state, and 3 for
+    //  the state redistribution
+    if ( !known_edgestate ) {
+        AMREX_ALWAYS_ASSERT(state.nGrow() >=
+                            HydroUtils::RequiredGhostCells(HydroUtils::AdvectionScheme::MOL, false, eb, redist_type,
+                                                           known_edgestate).state);
+    }
 
     // Need 2 grow cells in state to compute the slopes needed to compute the edge state.
-    int halo = known_edgestate ? 0 : 2;
+    int halo = HydroUtils::RequiredGhostCells(HydroUtils::AdvectionScheme::MOL, false, eb,
+                                              HydroUtils::RedistType::NoRedist,
+                                              known_edgestate).state;
 
     // Create temporary holder for advection term. Needed to fill ghost cells.
     MultiFab advc(state.boxArray(),state.DistributionMap(),ncomp,3,MFInfo(),ebfactory);
@@ -511,7 +585,7 @@ EBMOL::ComputeSyncAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
 
     MultiFab sstate_tmp;
     MultiFab* sstate;
-    if (redistribution_type == "StateRedist")
+    if (redist_type == HydroUtils::RedistType::StateRedist)
     {
       // Create temporary holder for sync "state" passed in via aofs
       // Do this so we're not overwriting the "state" as we go through the redistribution
@@ -563,14 +637,14 @@ EBMOL::ComputeSyncAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
             //  FluxRedistribute
         Box gbx = bx;
 
-        if (redistribution_type == "StateRedist")
+        if (redist_type == HydroUtils::RedistType::StateRedist)
           gbx.grow(3);
-        else if (redistribution_type == "FluxRedist")
+        else if (redist_type == HydroUtils::RedistType::FluxRedist)
           gbx.grow(2);
         FArrayBox tmpfab(gbx, ncomp*2);
         Elixir eli = tmpfab.elixir();
         Array4<Real> scratch = tmpfab.array(0);
-        if (redistribution_type == "FluxRedist")
+        if (redist_type == HydroUtils::RedistType::FluxRedist)
         {
           amrex::ParallelFor(Box(scratch),
               [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -590,7 +664,7 @@ EBMOL::ComputeSyncAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
                    AMREX_D_DECL(apx,apy,apz), vfrac,
 #endif
                    AMREX_D_DECL(fcx,fcy,fcz), ccc, d_bcrec_ptr,
-                   geom, dt, redistribution_type );
+                   geom, dt, redist_type );
 
         // Subtract contribution to sync aofs -- sign of divergence in aofs is opposite
         // of sign of div as computed by EB_ComputeDivergence, thus it must be subtracted.
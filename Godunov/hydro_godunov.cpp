@@ -7,60 +7,67 @@
 
 #include <hydro_godunov.H>
 #include <hydro_utils.H>
+#include <hydro_utils_K.H>
+
+#include <AMReX_MFParallelFor.H>
 
 using namespace amrex;
 
 
+namespace {
+
+// Shared by both ComputeAofs overloads. If fluxes[0] is null the fluxes only
+// live in tile scratch, which is handed to the flux registers (if any) before
+// it is released.
 void
-Godunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
-                       MultiFab const& state, const int state_comp,
-                       AMREX_D_DECL( MultiFab const& umac,
-                                     MultiFab const& vmac,
-                                     MultiFab const& wmac),
-                       AMREX_D_DECL( MultiFab& xedge,
-                                     MultiFab& yedge,
-                                     MultiFab& zedge),
-                       const int  edge_comp,
-                       const bool known_edgestate,
-                       AMREX_D_DECL( MultiFab& xfluxes,
-                                     MultiFab& yfluxes,
-                                     MultiFab& zfluxes),
-                       int fluxes_comp,
-                       MultiFab const& fq,
-                       const int fq_comp,
-                       MultiFab const& divu,
-                       BCRec const* d_bc,
-                       Geometry const& geom,
-                       Vector<int>& iconserv,
-                       const Real dt,
-                       const bool use_ppm,
-                       const bool use_forces_in_trans,
-                       const bool is_velocity  )
+compute_aofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
+               MultiFab const& state, const int state_comp,
+               AMREX_D_DECL( MultiFab const& umac,
+                             MultiFab const& vmac,
+                             MultiFab const& wmac),
+               AMREX_D_DECL( MultiFab& xedge,
+                             MultiFab& yedge,
+                             MultiFab& zedge),
+               const int  edge_comp,
+               const bool known_edgestate,
+               Array<MultiFab*,AMREX_SPACEDIM> const& fluxes,
+               int fluxes_comp,
+               const bool fluxes_are_area_weighted,
+               YAFluxRegister* fr_as_crse,
+               YAFluxRegister* fr_as_fine,
+               const int fr_comp,
+               MultiFab const& fq,
+               const int fq_comp,
+               MultiFab const& divu,
+               BCRec const* d_bc,
+               Geometry const& geom,
+               Vector<int>& iconserv,
+               const Real dt,
+               const bool use_ppm,
+               const bool use_forces_in_trans,
+               const bool is_velocity,
+               HydroUtils::AdvectionDiagnostics* diagnostics )
 {
-    BL_PROFILE("Godunov::ComputeAofs()");
-
-    bool fluxes_are_area_weighted = true;
+    // Optional diagnostics, reduced in the kernel that finishes aofs on each tile
+    std::unique_ptr<HydroUtils::AdvectionDiagnosticsReduction> diag_reduction;
+    if (diagnostics) {
+        diag_reduction = std::make_unique<HydroUtils::AdvectionDiagnosticsReduction>(
+            ncomp, geom, fluxes_are_area_weighted);
+    }
 
     // Make a device copy of the iconserv vector for use in kernels
     Gpu::DeviceVector<int> iconserv_d(iconserv.size());
     Gpu::copy(Gpu::hostToDevice, iconserv.begin(), iconserv.end(), iconserv_d.begin());
     int const* iconserv_ptr = iconserv_d.data();
 
-    // If we need convective form, we must also compute div(u_mac)
-    MultiFab divu_mac(state.boxArray(),state.DistributionMap(),1,0);;
-    for (Long i = 0; i < iconserv.size(); ++i)
-    {
-        if (!iconserv[i])
-        {
-            Array<MultiFab const*,AMREX_SPACEDIM> u;
-            AMREX_D_TERM(u[0] = &umac;,
-                         u[1] = &vmac;,
-                         u[2] = &wmac;);
-            amrex::computeDivergence(divu_mac,u,geom);
+    // If we need convective form, we also need div(u_mac). It is computed
+    // inline from the face velocities of each tile.
+    const auto dxinv  = geom.InvCellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const bool is_rz  = geom.IsRZ();
+    const Real* dx    = geom.CellSize();
 
-            break;
-        }
-    }
+    const bool has_flux_mf = (fluxes[0] != nullptr);
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -70,12 +77,31 @@ Godunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
 
         const Box& bx   = mfi.tilebox();
 
+        //
+        // Fluxes go either to the caller's MultiFabs or to tile scratch
+        //
+        Array<FArrayBox,AMREX_SPACEDIM> flux_tile;
+        Array<FArrayBox const*,AMREX_SPACEDIM> flux_fab;
+        Array<Array4<Real>,AMREX_SPACEDIM> flux_arr;
+        const int flux_comp = has_flux_mf ? fluxes_comp : 0;
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
+        {
+            if (has_flux_mf) {
+                flux_fab[dir] = &(*fluxes[dir])[mfi];
+                flux_arr[dir] = fluxes[dir]->array(mfi,fluxes_comp);
+            } else {
+                flux_tile[dir].resize(amrex::surroundingNodes(bx,dir), ncomp, The_Async_Arena());
+                flux_fab[dir] = &flux_tile[dir];
+                flux_arr[dir] = flux_tile[dir].array();
+            }
+        }
+
         //
         // Get handlers to Array4
         //
-        AMREX_D_TERM( const auto& fx = xfluxes.array(mfi,fluxes_comp);,
-                      const auto& fy = yfluxes.array(mfi,fluxes_comp);,
-                      const auto& fz = zfluxes.array(mfi,fluxes_comp););
+        AMREX_D_TERM( const auto& fx = flux_arr[0];,
+                      const auto& fy = flux_arr[1];,
+                      const auto& fz = flux_arr[2];);
 
         AMREX_D_TERM( const auto& xed = xedge.array(mfi,edge_comp);,
                       const auto& yed = yedge.array(mfi,edge_comp);,
@@ -87,17 +113,17 @@ Godunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
 
         if (!known_edgestate)
         {
-            ComputeEdgeState( bx, ncomp,
-                              state.array(mfi,state_comp),
-                              AMREX_D_DECL( xed, yed, zed ),
-                              AMREX_D_DECL( u, v, w ),
-                              divu.array(mfi),
-                              fq.array(mfi,fq_comp),
-                              geom, dt, d_bc,
-                              iconserv_ptr,
-                              use_ppm,
-                              use_forces_in_trans,
-                              is_velocity );
+            Godunov::ComputeEdgeState( bx, ncomp,
+                                       state.array(mfi,state_comp),
+                                       AMREX_D_DECL( xed, yed, zed ),
+                                       AMREX_D_DECL( u, v, w ),
+                                       divu.array(mfi),
+                                       fq.array(mfi,fq_comp),
+                                       geom, dt, d_bc,
+                                       iconserv_ptr,
+                                       use_ppm,
+                                       use_forces_in_trans,
+                                       is_velocity );
         }
 
         // Compute -div instead of computing div -- this is just for consistency
@@ -117,12 +143,22 @@ Godunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                                        ncomp, geom,
                                        mult, fluxes_are_area_weighted);
 
+        // Only the faces on the coarse/fine boundary are touched; tiles away
+        // from it return immediately.
+        const RunOn run_on = Gpu::inLaunchRegion() ? RunOn::Gpu : RunOn::Cpu;
+        if (fr_as_crse) {
+            fr_as_crse->CrseAdd(mfi, flux_fab, dx, dt, flux_comp, fr_comp, ncomp, run_on);
+        }
+        if (fr_as_fine) {
+            fr_as_fine->FineAdd(mfi, flux_fab, dx, dt, flux_comp, fr_comp, ncomp, run_on);
+        }
+
         // Compute the convective form if needed and
         // flip the sign to return div
         auto const& aofs_arr  = aofs.array(mfi, aofs_comp);
-        auto const& divu_arr  = divu_mac.array(mfi);
-        amrex::ParallelFor(bx, ncomp, [=]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        HydroUtils::ParallelForWithDiagnostics(diag_reduction.get(), bx, ncomp, aofs_arr,
+                                               {{AMREX_D_DECL(u,v,w)}, {AMREX_D_DECL(fx,fy,fz)}, {}},
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         {
             if (!iconserv_ptr[n])
             {
@@ -134,7 +170,8 @@ Godunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                 q += zed(i,j,k,n) + zed(i,j,k+1,n);
                 q /= 6.0;
 #endif
-                aofs_arr(i,j,k,n) += q*divu_arr(i,j,k);
+                aofs_arr(i,j,k,n) += q*HydroUtils::umac_divergence(i,j,k,AMREX_D_DECL(u,v,w),
+                                                                    dxinv,problo,is_rz);
             }
 
             aofs_arr( i, j, k, n ) *=  - 1.0;
@@ -149,6 +186,235 @@ Godunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
         Gpu::streamSynchronize();  // otherwise we might be using too much memory
     }
 
+    if (diag_reduction) {
+        diag_reduction->finalize(*diagnostics);
+    }
+}
+
+// Same result as compute_aofs with level-wide flux MultiFabs, up to round-off,
+// but each step is computed in a single launch over many boxes, so that small
+// boxes do not pay one launch per kernel per tile: the face states over
+// batches of boxes with bounded scratch, the fluxes and the convective
+// divergence over all boxes of the level. Only used on the GPU.
+void
+compute_aofs_fused ( MultiFab& aofs, const int aofs_comp, const int ncomp,
+                     MultiFab const& state, const int state_comp,
+                     AMREX_D_DECL( MultiFab const& umac,
+                                   MultiFab const& vmac,
+                                   MultiFab const& wmac),
+                     AMREX_D_DECL( MultiFab& xedge,
+                                   MultiFab& yedge,
+                                   MultiFab& zedge),
+                     const int  edge_comp,
+                     const bool known_edgestate,
+                     AMREX_D_DECL( MultiFab& xfluxes,
+                                   MultiFab& yfluxes,
+                                   MultiFab& zfluxes),
+                     int fluxes_comp,
+                     MultiFab const& fq,
+                     const int fq_comp,
+                     MultiFab const& divu,
+                     BCRec const* d_bc,
+                     Geometry const& geom,
+                     Vector<int>& iconserv,
+                     const Real dt,
+                     const bool use_ppm,
+                     const bool use_forces_in_trans,
+                     const bool is_velocity,
+                     HydroUtils::AdvectionDiagnostics* diagnostics )
+{
+    // Make a device copy of the iconserv vector for use in kernels
+    Gpu::DeviceVector<int> iconserv_d(iconserv.size());
+    Gpu::copy(Gpu::hostToDevice, iconserv.begin(), iconserv.end(), iconserv_d.begin());
+    int const* iconserv_ptr = iconserv_d.data();
+
+    if (!known_edgestate)
+    {
+        Godunov::ComputeEdgeState( ncomp, state, state_comp,
+                                   AMREX_D_DECL( xedge, yedge, zedge ), edge_comp,
+                                   AMREX_D_DECL( umac, vmac, wmac ),
+                                   divu, fq, fq_comp,
+                                   geom, dt, d_bc,
+                                   iconserv_ptr,
+                                   use_ppm,
+                                   use_forces_in_trans,
+                                   is_velocity );
+    }
+
+    HydroUtils::ComputeFluxes( AMREX_D_DECL( xfluxes, yfluxes, zfluxes ), fluxes_comp,
+                               AMREX_D_DECL( umac, vmac, wmac ),
+                               AMREX_D_DECL( xedge, yedge, zedge ), edge_comp,
+                               geom, ncomp );
+
+    const auto dx     = geom.CellSizeArray();
+    const auto dxinv  = geom.InvCellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const bool is_rz  = geom.IsRZ();
+    const Real qvol   = AMREX_D_TERM(dxinv[0],*dxinv[1],*dxinv[2]);
+
+    AMREX_D_TERM( auto const& ma_u = umac.const_arrays();,
+                  auto const& ma_v = vmac.const_arrays();,
+                  auto const& ma_w = wmac.const_arrays(););
+
+    AMREX_D_TERM( auto const& ma_xed = xedge.const_arrays();,
+                  auto const& ma_yed = yedge.const_arrays();,
+                  auto const& ma_zed = zedge.const_arrays(););
+
+    AMREX_D_TERM( auto const& ma_fx = xfluxes.const_arrays();,
+                  auto const& ma_fy = yfluxes.const_arrays();,
+                  auto const& ma_fz = zfluxes.const_arrays(););
+
+    //
+    // div(F), minus q div(umac) for the convective components, in one launch
+    //
+    auto const& ma_aofs = aofs.arrays();
+    auto finish_aofs = [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+    {
+        AMREX_D_TERM( auto const& u = ma_u[box];,
+                      auto const& v = ma_v[box];,
+                      auto const& w = ma_w[box];);
+
+        Real div = HydroUtils::flux_divergence(i, j, k, n + fluxes_comp,
+                                               AMREX_D_DECL(ma_fx[box], ma_fy[box], ma_fz[box]),
+                                               qvol, dx, problo, is_rz);
+
+        if (!iconserv_ptr[n])
+        {
+            AMREX_D_TERM( auto const& xed = ma_xed[box];,
+                          auto const& yed = ma_yed[box];,
+                          auto const& zed = ma_zed[box];);
+            const int ne = n + edge_comp;
+            Real q = xed(i,j,k,ne) + xed(i+1,j,k,ne)
+                   + yed(i,j,k,ne) + yed(i,j+1,k,ne);
+#if (AMREX_SPACEDIM == 2)
+            q *= 0.25;
+#else
+            q += zed(i,j,k,ne) + zed(i,j,k+1,ne);
+            q /= 6.0;
+#endif
+            div -= q*HydroUtils::umac_divergence(i,j,k,AMREX_D_DECL(u,v,w),
+                                                 dxinv,problo,is_rz);
+        }
+
+        ma_aofs[box](i,j,k,n+aofs_comp) = div;
+    };
+
+    if (diagnostics)
+    {
+        HydroUtils::AdvectionDiagnosticsReduction diag_reduction(ncomp, geom, true);
+        diag_reduction.ParallelFor(aofs, aofs_comp, ncomp,
+                                   {{AMREX_D_DECL(ma_u, ma_v, ma_w)},
+                                    {AMREX_D_DECL(ma_fx, ma_fy, ma_fz)},
+                                    fluxes_comp},
+                                   finish_aofs);
+        diag_reduction.finalize(*diagnostics);
+    }
+    else
+    {
+        amrex::ParallelFor(aofs, IntVect(0), ncomp, finish_aofs);
+    }
+
+    // iconserv_d goes out of scope
+    Gpu::streamSynchronize();
+}
+
+}
+
+
+void
+Godunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
+                       MultiFab const& state, const int state_comp,
+                       AMREX_D_DECL( MultiFab const& umac,
+                                     MultiFab const& vmac,
+                                     MultiFab const& wmac),
+                       AMREX_D_DECL( MultiFab& xedge,
+                                     MultiFab& yedge,
+                                     MultiFab& zedge),
+                       const int  edge_comp,
+                       const bool known_edgestate,
+                       AMREX_D_DECL( MultiFab& xfluxes,
+                                     MultiFab& yfluxes,
+                                     MultiFab& zfluxes),
+                       int fluxes_comp,
+                       MultiFab const& fq,
+                       const int fq_comp,
+                       MultiFab const& divu,
+                       BCRec const* d_bc,
+                       Geometry const& geom,
+                       Vector<int>& iconserv,
+                       const Real dt,
+                       const bool use_ppm,
+                       const bool use_forces_in_trans,
+                       const bool is_velocity,
+                       HydroUtils::AdvectionDiagnostics* diagnostics,
+                       const bool fuse_boxes )
+{
+    BL_PROFILE("Godunov::ComputeAofs()");
+
+    if (fuse_boxes && Gpu::inLaunchRegion())
+    {
+        compute_aofs_fused(aofs, aofs_comp, ncomp, state, state_comp,
+                           AMREX_D_DECL(umac, vmac, wmac),
+                           AMREX_D_DECL(xedge, yedge, zedge), edge_comp, known_edgestate,
+                           AMREX_D_DECL(xfluxes, yfluxes, zfluxes), fluxes_comp,
+                           fq, fq_comp, divu, d_bc, geom, iconserv, dt,
+                           use_ppm, use_forces_in_trans, is_velocity, diagnostics);
+        return;
+    }
+
+    bool fluxes_are_area_weighted = true;
+
+    compute_aofs(aofs, aofs_comp, ncomp, state, state_comp,
+                 AMREX_D_DECL(umac, vmac, wmac),
+                 AMREX_D_DECL(xedge, yedge, zedge), edge_comp, known_edgestate,
+                 {AMREX_D_DECL(&xfluxes, &yfluxes, &zfluxes)}, fluxes_comp,
+                 fluxes_are_area_weighted, nullptr, nullptr, 0,
+                 fq, fq_comp, divu, d_bc, geom, iconserv, dt,
+                 use_ppm, use_forces_in_trans, is_velocity, diagnostics);
+}
+
+
+
+void
+Godunov::ComputeAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
+                       MultiFab const& state, const int state_comp,
+                       AMREX_D_DECL( MultiFab const& umac,
+                                     MultiFab const& vmac,
+                                     MultiFab const& wmac),
+                       AMREX_D_DECL( MultiFab& xedge,
+                                     MultiFab& yedge,
+                                     MultiFab& zedge),
+                       const int  edge_comp,
+                       const bool known_edgestate,
+                       YAFluxRegister* fr_as_crse,
+                       YAFluxRegister* fr_as_fine,
+                       const int fr_comp,
+                       MultiFab const& fq,
+                       const int fq_comp,
+                       MultiFab const& divu,
+                       BCRec const* d_bc,
+                       Geometry const& geom,
+                       Vector<int>& iconserv,
+                       const Real dt,
+                       const bool use_ppm,
+                       const bool use_forces_in_trans,
+                       const bool is_velocity,
+                       HydroUtils::AdvectionDiagnostics* diagnostics )
+{
+    BL_PROFILE("Godunov::ComputeAofs(YAFluxRegister)");
+
+    // YAFluxRegister scales by dt and area itself, with the Cartesian face
+    // areas, so the RZ fluxes would come out wrong
+    AMREX_ALWAYS_ASSERT(!geom.IsRZ());
+    bool fluxes_are_area_weighted = false;
+
+    compute_aofs(aofs, aofs_comp, ncomp, state, state_comp,
+                 AMREX_D_DECL(umac, vmac, wmac),
+                 AMREX_D_DECL(xedge, yedge, zedge), edge_comp, known_edgestate,
+                 {AMREX_D_DECL(nullptr, nullptr, nullptr)}, 0,
+                 fluxes_are_area_weighted, fr_as_crse, fr_as_fine, fr_comp,
+                 fq, fq_comp, divu, d_bc, geom, iconserv, dt,
+                 use_ppm, use_forces_in_trans, is_velocity, diagnostics);
 }
 
 
@@ -229,14 +495,8 @@ Godunov::ComputeSyncAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                               is_velocity );
         }
 
-        // Temporary divergence
-        Box tmpbox = amrex::surroundingNodes(bx);
-        int tmpcomp = ncomp*AMREX_SPACEDIM;
-        FArrayBox tmpfab(tmpbox, tmpcomp);
-        Elixir eli = tmpfab.elixir();
-        Array4<Real> divtmp_arr = tmpfab.array();
-
-        Real mult = -1.0;
+        // The sync contribution is +div, added straight into aofs
+        Real mult = 1.0;
 
         HydroUtils::ComputeFluxes( bx,
                                    AMREX_D_DECL( fx, fy, fz ),
@@ -244,17 +504,11 @@ Godunov::ComputeSyncAofs ( MultiFab& aofs, const int aofs_comp, const int ncomp,
                                    AMREX_D_DECL( xed, yed, zed ),
                                    geom, ncomp, fluxes_are_area_weighted );
 
-        HydroUtils::ComputeDivergence( bx, divtmp_arr,
+        HydroUtils::ComputeDivergence( bx, aofs.array(mfi, aofs_comp),
                                        AMREX_D_DECL( fx, fy, fz ),
                                        ncomp, geom,
-                                       mult, fluxes_are_area_weighted);
-
-        // Sum contribution to sync aofs
-        auto const& aofs_arr = aofs.array(mfi, aofs_comp);
-
-        amrex::ParallelFor(bx, ncomp, [aofs_arr, divtmp_arr]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        { aofs_arr( i, j, k, n ) += - divtmp_arr( i, j, k, n ); });
+                                       mult, fluxes_are_area_weighted,
+                                       /*accumulate=*/true);
 
         Gpu::streamSynchronize();  // otherwise we might be using too much memory
     }
@@ -8,39 +8,28 @@
 #include <hydro_godunov_plm.H>
 #include <hydro_godunov_ppm.H>
 #include <hydro_godunov.H>
+#include <hydro_godunov_edge_state.H>
 #include <hydro_godunov_K.H>
 #include <hydro_bcs_K.H>
 
 
 using namespace amrex;
 
+namespace {
+
+// The steps of the edge state prediction, run by the launcher L on a tile or
+// on all boxes of a level (see hydro_godunov_edge_state.H)
+template <typename Launcher>
 void
-Godunov::ComputeEdgeState (Box const& bx, int ncomp,
-                           Array4<Real const> const& q,
-                           Array4<Real> const& xedge,
-                           Array4<Real> const& yedge,
-                           Array4<Real const> const& umac,
-                           Array4<Real const> const& vmac,
-                           Array4<Real const> const& divu,
-                           Array4<Real const> const& fq,
-                           Geometry geom,
-                           Real l_dt,
-                           BCRec const* pbc, int const* iconserv,
-                           bool use_ppm,
-                           bool use_forces_in_trans,
-                           bool is_velocity)
+edge_state (Launcher const& L, int ncomp,
+            Geometry const& geom,
+            Real l_dt,
+            BCRec const* pbc, int const* iconserv,
+            bool use_ppm,
+            bool use_forces_in_trans,
+            bool is_velocity)
 {
-    Box const& xbx = amrex::surroundingNodes(bx,0);
-    Box const& ybx = amrex::surroundingNodes(bx,1);
-
-    Box const& bxg1 = amrex::grow(bx,1);
-
-    FArrayBox tmpfab(amrex::grow(bx,1),  (4*AMREX_SPACEDIM + 2)*ncomp);
-    Elixir tmpeli = tmpfab.elixir();
-    Real* p   = tmpfab.dataPtr();
-
-    Box xebox = Box(xbx).grow(1,1);
-    Box yebox = Box(ybx).grow(0,1);
+    using namespace GodunovEdgeState;
 
     const Real dx = geom.CellSize(0);
     const Real dy = geom.CellSize(1);
@@ -53,66 +42,62 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
     const auto dlo = amrex::lbound(domain);
     const auto dhi = amrex::ubound(domain);
 
-    Array4<Real> Imx = makeArray4(p, bxg1, ncomp);
-    p +=         Imx.size();
-    Array4<Real> Ipx = makeArray4(p, bxg1, ncomp);
-    p +=         Ipx.size();
-    Array4<Real> Imy = makeArray4(p, bxg1, ncomp);
-    p +=         Imy.size();
-    Array4<Real> Ipy = makeArray4(p, bxg1, ncomp);
-    p +=         Ipy.size();
-    Array4<Real> xlo = makeArray4(p, xebox, ncomp);
-    p +=         xlo.size();
-    Array4<Real> xhi = makeArray4(p, xebox, ncomp);
-    p +=         xhi.size();
-    Array4<Real> ylo = makeArray4(p, yebox, ncomp);
-    p +=         ylo.size();
-    Array4<Real> yhi = makeArray4(p, yebox, ncomp);
-    p +=         yhi.size();
-    Array4<Real> xyzlo = makeArray4(p, bxg1, ncomp);
-    p +=         xyzlo.size();
-    Array4<Real> xyzhi = makeArray4(p, bxg1, ncomp);
-    p +=         xyzhi.size();
+    const Region xebox = FaceRegion(0, IntVect(0,1));
+    const Region yebox = FaceRegion(1, IntVect(1,0));
 
     // Use PPM to generate Im and Ip */
     if (use_ppm)
     {
-        amrex::ParallelFor(bxg1, ncomp,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        if constexpr (Launcher::tiled)
         {
-            PPM::PredictStateOnXFace(i, j, k, n, l_dt, dx, Imx(i,j,k,n), Ipx(i,j,k,n),
-                                   q, umac, pbc[n], dlo.x, dhi.x);
-            PPM::PredictStateOnYFace(i, j, k, n, l_dt, dy, Imy(i,j,k,n), Ipy(i,j,k,n),
-                                   q, vmac, pbc[n], dlo.y, dhi.y);
-        });
+            auto const& a = L.arrays(0);
+            PPM::PredictStateOnFaces(amrex::grow(a.bx,1), ncomp, a.Im(0), a.Im(1), a.Ip(0), a.Ip(1),
+                                     a.q, a.mac[0], a.mac[1], geom, l_dt, pbc);
+        }
+        else
+        {
+            L.ParallelFor(CellRegion(1), ncomp,
+            [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+            {
+                auto const& a = L.arrays(box);
+                PPM::PredictStateOnXFace(i, j, k, n, l_dt, dx, a.Im(0)(i,j,k,n), a.Ip(0)(i,j,k,n),
+                                         a.q, a.mac[0], pbc[n], dlo.x, dhi.x);
+                PPM::PredictStateOnYFace(i, j, k, n, l_dt, dy, a.Im(1)(i,j,k,n), a.Ip(1)(i,j,k,n),
+                                         a.q, a.mac[1], pbc[n], dlo.y, dhi.y);
+            });
+        }
     // Use PLM to generate Im and Ip */
     }
     else
     {
 
-        amrex::ParallelFor(xebox, ncomp,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        L.ParallelFor(xebox, ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
         {
-            PLM::PredictStateOnXFace(i, j, k, n, l_dt, dx, Imx(i,j,k,n), Ipx(i-1,j,k,n),
-                                     q, umac(i,j,k), pbc[n], dlo.x, dhi.x, is_velocity);
+            auto const& a = L.arrays(box);
+            PLM::PredictStateOnXFace(i, j, k, n, l_dt, dx, a.Im(0)(i,j,k,n), a.Ip(0)(i-1,j,k,n),
+                                     a.q, a.mac[0](i,j,k), pbc[n], dlo.x, dhi.x, is_velocity);
         });
 
-        amrex::ParallelFor(yebox, ncomp,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        L.ParallelFor(yebox, ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
         {
-            PLM::PredictStateOnYFace(i, j, k, n, l_dt, dy, Imy(i,j,k,n), Ipy(i,j-1,k,n),
-                                     q, vmac(i,j,k), pbc[n], dlo.y, dhi.y, is_velocity);
+            auto const& a = L.arrays(box);
+            PLM::PredictStateOnYFace(i, j, k, n, l_dt, dy, a.Im(1)(i,j,k,n), a.Ip(1)(i,j-1,k,n),
+                                     a.q, a.mac[1](i,j,k), pbc[n], dlo.y, dhi.y, is_velocity);
         });
     }
 
 
-    amrex::ParallelFor(
-    xebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    L.ParallelFor(
+    xebox, ncomp, [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
-        Real uad = umac(i,j,k);
-        Real fux = (amrex::Math::abs(uad) < small_vel)? 0. : 1.;
-        Real lo = Ipx(i-1,j,k,n);
-        Real hi = Imx(i  ,j,k,n);
+        auto const& a = L.arrays(box);
+        auto const& q  = a.q;
+        auto const& fq = a.fq;
+
+        Real lo = a.Ip(0)(i-1,j,k,n);
+        Real hi = a.Im(0)(i  ,j,k,n);
 
         if (use_forces_in_trans && fq)
         {
@@ -123,18 +108,17 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
         auto bc = pbc[n];
 
         GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, lo, hi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, is_velocity);
-        xlo(i,j,k,n) = lo;
-        xhi(i,j,k,n) = hi;
-        Real st = (uad >= 0.) ? lo : hi;
-        Imx(i,j,k,n) = fux*st + (1. - fux)*0.5*(hi + lo);
-
+        a.lo(0)(i,j,k,n) = lo;
+        a.hi(0)(i,j,k,n) = hi;
     },
-    yebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    yebox, ncomp, [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
-        Real vad = vmac(i,j,k);
-        Real fuy = (amrex::Math::abs(vad) < small_vel)? 0. : 1.;
-        Real lo = Ipy(i,j-1,k,n);
-        Real hi = Imy(i,j  ,k,n);
+        auto const& a = L.arrays(box);
+        auto const& q  = a.q;
+        auto const& fq = a.fq;
+
+        Real lo = a.Ip(1)(i,j-1,k,n);
+        Real hi = a.Im(1)(i,j  ,k,n);
 
         if (use_forces_in_trans && fq)
         {
@@ -146,45 +130,50 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
 
         GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, lo, hi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, is_velocity);
 
-        ylo(i,j,k,n) = lo;
-        yhi(i,j,k,n) = hi;
-        Real st = (vad >= 0.) ? lo : hi;
-        Imy(i,j,k,n) = fuy*st + (1. - fuy)*0.5*(hi + lo);
+        a.lo(1)(i,j,k,n) = lo;
+        a.hi(1)(i,j,k,n) = hi;
     }
     );
 
-    // We can reuse the space in Ipx, Ipy and Ipz.
-
     //
     // x-direction
     //
-    Box const& xbxtmp = amrex::grow(bx,0,1);
-    Array4<Real> yzlo = makeArray4(xyzlo.dataPtr(), amrex::surroundingNodes(xbxtmp,1), ncomp);
-    amrex::ParallelFor(
-    Box(yzlo), ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    // yzlo lives on the y-faces of grow(bx,0,1)
+    L.ParallelFor(
+    FaceRegion(1, IntVect(1,0)), ncomp,
+    [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
+        auto const& a = L.arrays(box);
+        auto const& q = a.q;
         const auto bc = pbc[n];
         Real l_yzlo, l_yzhi;
 
-        l_yzlo = ylo(i,j,k,n);
-        l_yzhi = yhi(i,j,k,n);
-        Real vad = vmac(i,j,k);
+        l_yzlo = a.lo(1)(i,j,k,n);
+        l_yzhi = a.hi(1)(i,j,k,n);
+        Real vad = a.mac[1](i,j,k);
         GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yzlo, l_yzhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, is_velocity);
 
         Real st = (vad >= 0.) ? l_yzlo : l_yzhi;
         Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
-        yzlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_yzhi + l_yzlo);
+        a.trans(0,0,1)(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_yzhi + l_yzlo);
     });
 
     //
-    amrex::ParallelFor(xbx, ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    L.ParallelFor(FaceRegion(0), ncomp,
+    [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
+        auto const& a = L.arrays(box);
+        auto const& q    = a.q;
+        auto const& fq   = a.fq;
+        auto const& divu = a.divu;
+        auto const& umac = a.mac[0];
+        auto const& vmac = a.mac[1];
+        auto const  yzlo = a.trans(0,0,1);
+
         Real stl, sth;
 
-        stl = xlo(i,j,k,n);
-        sth = xhi(i,j,k,n);
+        stl = a.lo(0)(i,j,k,n);
+        sth = a.hi(0)(i,j,k,n);
         // To match EBGodunov
         // Here we add  dt/2 (-q u_x - (v q)_y) to the term that is already
         //     q + dx/2 q_x + dt/2 (-u q_x) to get
@@ -234,40 +223,49 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
 
         Real temp = (umac(i,j,k) >= 0.) ? stl : sth;
         temp = (amrex::Math::abs(umac(i,j,k)) < small_vel) ? 0.5*(stl + sth) : temp;
-        xedge(i,j,k,n) = temp;
+        a.edge[0](i,j,k,n) = temp;
     });
 
     //
     // y-direction
     //
-    Box const& ybxtmp = amrex::grow(bx,1,1);
-    Array4<Real> xzlo = makeArray4(xyzlo.dataPtr(), amrex::surroundingNodes(ybxtmp,0), ncomp);
-    amrex::ParallelFor(
-    Box(xzlo), ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    // xzlo lives on the x-faces of grow(bx,1,1)
+    L.ParallelFor(
+    FaceRegion(0, IntVect(0,1)), ncomp,
+    [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
+        auto const& a = L.arrays(box);
+        auto const& q = a.q;
         const auto bc = pbc[n];
         Real l_xzlo, l_xzhi;
 
-        l_xzlo = xlo(i,j,k,n);
-        l_xzhi = xhi(i,j,k,n);
+        l_xzlo = a.lo(0)(i,j,k,n);
+        l_xzhi = a.hi(0)(i,j,k,n);
 
-        Real uad = umac(i,j,k);
+        Real uad = a.mac[0](i,j,k);
         GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xzlo, l_xzhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, is_velocity);
 
         Real st = (uad >= 0.) ? l_xzlo : l_xzhi;
         Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
-        xzlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_xzhi + l_xzlo);
+        a.trans(0,1,0)(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_xzhi + l_xzlo);
     });
 
     //
-    amrex::ParallelFor(ybx, ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    L.ParallelFor(FaceRegion(1), ncomp,
+    [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
+        auto const& a = L.arrays(box);
+        auto const& q    = a.q;
+        auto const& fq   = a.fq;
+        auto const& divu = a.divu;
+        auto const& umac = a.mac[0];
+        auto const& vmac = a.mac[1];
+        auto const  xzlo = a.trans(0,1,0);
+
         Real stl, sth;
 
-        stl = ylo(i,j,k,n);
-        sth = yhi(i,j,k,n);
+        stl = a.lo(1)(i,j,k,n);
+        sth = a.hi(1)(i,j,k,n);
 
         // To match EBGodunov
         // Here we add  dt/2 (-q v_y - (u q)_x) to the term that is already
@@ -318,8 +316,96 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
 
         Real temp = (vmac(i,j,k) >= 0.) ? stl : sth;
         temp = (amrex::Math::abs(vmac(i,j,k)) < small_vel) ? 0.5*(stl + sth) : temp;
-        yedge(i,j,k,n) = temp;
+        a.edge[1](i,j,k,n) = temp;
     });
 
 }
+
+}
+
+void
+Godunov::ComputeEdgeState (Box const& bx, int ncomp,
+                           Array4<Real const> const& q,
+                           Array4<Real> const& xedge,
+                           Array4<Real> const& yedge,
+                           Array4<Real const> const& umac,
+                           Array4<Real const> const& vmac,
+                           Array4<Real const> const& divu,
+                           Array4<Real const> const& fq,
+                           Geometry geom,
+                           Real l_dt,
+                           BCRec const* pbc, int const* iconserv,
+                           bool use_ppm,
+                           bool use_forces_in_trans,
+                           bool is_velocity)
+{
+    FArrayBox tmpfab(amrex::grow(bx,1),  GodunovEdgeState::nscratch*ncomp);
+    Elixir tmpeli = tmpfab.elixir();
+
+    GodunovEdgeState::TileLauncher L;
+    L.a.bx    = bx;
+    L.a.ncomp = ncomp;
+    L.a.p     = tmpfab.dataPtr();
+    L.a.q     = q;
+    L.a.edge  = {xedge, yedge};
+    L.a.mac   = {umac, vmac};
+    L.a.divu  = divu;
+    L.a.fq    = fq;
+
+    edge_state(L, ncomp, geom, l_dt, pbc, iconserv, use_ppm, use_forces_in_trans, is_velocity);
+}
+
+void
+Godunov::ComputeEdgeState (int ncomp,
+                           MultiFab const& state, int state_comp,
+                           AMREX_D_DECL(MultiFab& xedge,
+                                        MultiFab& yedge,
+                                        MultiFab& zedge),
+                           int edge_comp,
+                           AMREX_D_DECL(MultiFab const& umac,
+                                        MultiFab const& vmac,
+                                        MultiFab const& wmac),
+                           MultiFab const& divu,
+                           MultiFab const& fq, int fq_comp,
+                           Geometry const& geom,
+                           Real l_dt,
+                           BCRec const* pbc, int const* iconserv,
+                           bool use_ppm,
+                           bool use_forces_in_trans,
+                           bool is_velocity,
+                           int const* box_mask)
+{
+    // On the CPU the tiles keep the PPM pencil sweep
+    if (Gpu::notInLaunchRegion())
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(state,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            if (box_mask && !box_mask[mfi.LocalIndex()]) { continue; }
+
+            Godunov::ComputeEdgeState(mfi.tilebox(), ncomp,
+                                      state.const_array(mfi,state_comp),
+                                      xedge.array(mfi,edge_comp),
+                                      yedge.array(mfi,edge_comp),
+                                      umac.const_array(mfi),
+                                      vmac.const_array(mfi),
+                                      divu.const_array(mfi),
+                                      fq.const_array(mfi,fq_comp),
+                                      geom, l_dt, pbc, iconserv,
+                                      use_ppm, use_forces_in_trans, is_velocity);
+        }
+        return;
+    }
+
+    GodunovEdgeState::ForEachBatch(ncomp, state, state_comp,
+                                   {AMREX_D_DECL(&xedge, &yedge, &zedge)}, edge_comp,
+                                   {AMREX_D_DECL(&umac, &vmac, &wmac)},
+                                   divu, fq, fq_comp, geom.Domain(), box_mask,
+    [&] (GodunovEdgeState::LevelLauncher const& L)
+    {
+        edge_state(L, ncomp, geom, l_dt, pbc, iconserv, use_ppm, use_forces_in_trans, is_velocity);
+    });
+}
 /** @} */
@@ -8,43 +8,32 @@
 #include <hydro_godunov_plm.H>
 #include <hydro_godunov_ppm.H>
 #include <hydro_godunov.H>
+#include <hydro_godunov_edge_state.H>
 #include <hydro_godunov_corner_couple.H>
 #include <hydro_godunov_K.H>
 #include <hydro_bcs_K.H>
 
 using namespace amrex;
 
+namespace {
+
+// The steps of the edge state prediction, run by the launcher L on a tile or
+// on all boxes of a level (see hydro_godunov_edge_state.H)
+template <typename Launcher>
 void
-Godunov::ComputeEdgeState (Box const& bx, int ncomp,
-                           Array4<Real const> const& q,
-                           Array4<Real> const& xedge,
-                           Array4<Real> const& yedge,
-                           Array4<Real> const& zedge,
-                           Array4<Real const> const& umac,
-                           Array4<Real const> const& vmac,
-                           Array4<Real const> const& wmac,
-                           Array4<Real const> const& divu,
-                           Array4<Real const> const& fq,
-                           Geometry geom,
-                           Real l_dt,
-                           BCRec const* pbc, int const* iconserv,
-                           bool use_ppm,
-                           bool use_forces_in_trans,
-                           bool is_velocity)
+edge_state (Launcher const& L, int ncomp,
+            Geometry const& geom,
+            Real l_dt,
+            BCRec const* pbc, int const* iconserv,
+            bool use_ppm,
+            bool use_forces_in_trans,
+            bool is_velocity)
 {
-    Box const& xbx = amrex::surroundingNodes(bx,0);
-    Box const& ybx = amrex::surroundingNodes(bx,1);
-    Box const& zbx = amrex::surroundingNodes(bx,2);
-
-    Box const& bxg1 = amrex::grow(bx,1);
-
-    FArrayBox tmpfab(amrex::grow(bx,1),  (4*AMREX_SPACEDIM + 2)*ncomp);
-    Elixir tmpeli = tmpfab.elixir();
-    Real* p   = tmpfab.dataPtr();
+    using namespace GodunovEdgeState;
 
-    Box xebox = Box(xbx).grow(1,1).grow(2,1);
-    Box yebox = Box(ybx).grow(0,1).grow(2,1);
-    Box zebox = Box(zbx).grow(0,1).grow(1,1);
+    const Region xebox = FaceRegion(0, IntVect(0,1,1));
+    const Region yebox = FaceRegion(1, IntVect(1,0,1));
+    const Region zebox = FaceRegion(2, IntVect(1,1,0));
 
     const Real dx = geom.CellSize(0);
     const Real dy = geom.CellSize(1);
@@ -58,81 +47,86 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
     const auto dlo = amrex::lbound(domain);
     const auto dhi = amrex::ubound(domain);
 
-    Array4<Real> Imx = makeArray4(p, bxg1, ncomp);
-    p +=         Imx.size();
-    Array4<Real> Ipx = makeArray4(p, bxg1, ncomp);
-    p +=         Ipx.size();
-    Array4<Real> Imy = makeArray4(p, bxg1, ncomp);
-    p +=         Imy.size();
-    Array4<Real> Ipy = makeArray4(p, bxg1, ncomp);
-    p +=         Ipy.size();
-    Array4<Real> Imz = makeArray4(p, bxg1, ncomp);
-    p +=         Imz.size();
-    Array4<Real> Ipz = makeArray4(p, bxg1, ncomp);
-    p +=         Ipz.size();
-    Array4<Real> xlo = makeArray4(p, xebox, ncomp);
-    p +=         xlo.size();
-    Array4<Real> xhi = makeArray4(p, xebox, ncomp);
-    p +=         xhi.size();
-    Array4<Real> ylo = makeArray4(p, yebox, ncomp);
-    p +=         ylo.size();
-    Array4<Real> yhi = makeArray4(p, yebox, ncomp);
-    p +=         yhi.size();
-    Array4<Real> zlo = makeArray4(p, zebox, ncomp);
-    p +=         zlo.size();
-    Array4<Real> zhi = makeArray4(p, zebox, ncomp);
-    p +=         zhi.size();
-    Array4<Real> xyzlo = makeArray4(p, bxg1, ncomp);
-    p +=         xyzlo.size();
-    Array4<Real> xyzhi = makeArray4(p, bxg1, ncomp);
-    p +=         xyzhi.size();
-
     // Use PPM to generate Im and Ip */
     if (use_ppm)
     {
-        amrex::ParallelFor(bxg1, ncomp,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        if constexpr (Launcher::tiled)
         {
-            PPM::PredictStateOnXFace(i, j, k, n, l_dt, dx, Imx(i,j,k,n), Ipx(i,j,k,n),
-                                   q, umac, pbc[n], dlo.x, dhi.x);
-            PPM::PredictStateOnYFace(i, j, k, n, l_dt, dy, Imy(i,j,k,n), Ipy(i,j,k,n),
-                                   q, vmac, pbc[n], dlo.y, dhi.y);
-            PPM::PredictStateOnZFace(i, j, k, n, l_dt, dz, Imz(i,j,k,n), Ipz(i,j,k,n),
-                                   q, wmac, pbc[n], dlo.z, dhi.z);
-        });
+            auto const& a = L.arrays(0);
+            PPM::PredictStateOnFaces(amrex::grow(a.bx,1), ncomp,
+                                     a.Im(0), a.Im(1), a.Im(2), a.Ip(0), a.Ip(1), a.Ip(2),
+                                     a.q, a.mac[0], a.mac[1], a.mac[2], geom, l_dt, pbc);
+        }
+        else
+        {
+            L.ParallelFor(CellRegion(1), ncomp,
+            [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+            {
+                auto const& a = L.arrays(box);
+                PPM::PredictStateOnXFace(i, j, k, n, l_dt, dx, a.Im(0)(i,j,k,n), a.Ip(0)(i,j,k,n),
+                                         a.q, a.mac[0], pbc[n], dlo.x, dhi.x);
+                PPM::PredictStateOnYFace(i, j, k, n, l_dt, dy, a.Im(1)(i,j,k,n), a.Ip(1)(i,j,k,n),
+                                         a.q, a.mac[1], pbc[n], dlo.y, dhi.y);
+                PPM::PredictStateOnZFace(i, j, k, n, l_dt, dz, a.Im(2)(i,j,k,n), a.Ip(2)(i,j,k,n),
+                                         a.q, a.mac[2], pbc[n], dlo.z, dhi.z);
+            });
+        }
     // Use PLM to generate Im and Ip */
     }
     else
     {
 
-        amrex::ParallelFor(xebox, ncomp,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        L.ParallelFor(xebox, ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
         {
+            auto const& a = L.arrays(box);
+            auto const& q = a.q;
+            auto const& umac = a.mac[0];
+            auto const Imx = a.Im(0);
+            auto const Ipx = a.Ip(0);
+
             PLM::PredictStateOnXFace(i, j, k, n, l_dt, dx, Imx(i,j,k,n), Ipx(i-1,j,k,n),
                                      q, umac(i,j,k), pbc[n], dlo.x, dhi.x, is_velocity);
         });
 
-        amrex::ParallelFor(yebox, ncomp,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        L.ParallelFor(yebox, ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
         {
+            auto const& a = L.arrays(box);
+            auto const& q = a.q;
+            auto const& vmac = a.mac[1];
+            auto const Imy = a.Im(1);
+            auto const Ipy = a.Ip(1);
+
             PLM::PredictStateOnYFace(i, j, k, n, l_dt, dy, Imy(i,j,k,n), Ipy(i,j-1,k,n),
                                      q, vmac(i,j,k), pbc[n], dlo.y, dhi.y, is_velocity);
         });
-        amrex::ParallelFor(zebox, ncomp,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        L.ParallelFor(zebox, ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
         {
+            auto const& a = L.arrays(box);
+            auto const& q = a.q;
+            auto const& wmac = a.mac[2];
+            auto const Imz = a.Im(2);
+            auto const Ipz = a.Ip(2);
+
             PLM::PredictStateOnZFace(i, j, k, n, l_dt, dz, Imz(i,j,k,n), Ipz(i,j,k-1,n),
                                      q, wmac(i,j,k), pbc[n], dlo.z, dhi.z, is_velocity);
         });
     }
 
 
-    amrex::ParallelFor(
-    xebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    L.ParallelFor(
+    xebox, ncomp, [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
-        Real uad = umac(i,j,k);
-        Real fux = (amrex::Math::abs(uad) < small_vel)? 0. : 1.;
-        bool uval = uad >= 0.;
+        auto const& a = L.arrays(box);
+        auto const& q = a.q;
+        auto const& fq = a.fq;
+        auto const Imx = a.Im(0);
+        auto const Ipx = a.Ip(0);
+        auto const xlo = a.lo(0);
+        auto const xhi = a.hi(0);
+
         Real lo = Ipx(i-1,j,k,n);
         Real hi = Imx(i  ,j,k,n);
 
@@ -147,15 +141,17 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
         GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, lo, hi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, is_velocity);
         xlo(i,j,k,n) = lo;
         xhi(i,j,k,n) = hi;
-        Real st = (uval) ? lo : hi;
-        Imx(i,j,k,n) = fux*st + (1. - fux)*0.5*(hi + lo);
-
     },
-    yebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    yebox, ncomp, [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
-        Real vad = vmac(i,j,k);
-        Real fuy = (amrex::Math::abs(vad) < small_vel)? 0. : 1.;
-        bool vval = vad >= 0.;
+        auto const& a = L.arrays(box);
+        auto const& q = a.q;
+        auto const& fq = a.fq;
+        auto const Imy = a.Im(1);
+        auto const Ipy = a.Ip(1);
+        auto const ylo = a.lo(1);
+        auto const yhi = a.hi(1);
+
         Real lo = Ipy(i,j-1,k,n);
         Real hi = Imy(i,j  ,k,n);
 
@@ -171,14 +167,17 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
 
         ylo(i,j,k,n) = lo;
         yhi(i,j,k,n) = hi;
-        Real st = (vval) ? lo : hi;
-        Imy(i,j,k,n) = fuy*st + (1. - fuy)*0.5*(hi + lo);
     },
-    zebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    zebox, ncomp, [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
-        Real wad = wmac(i,j,k);
-        Real fuz = (amrex::Math::abs(wad) < small_vel) ? 0. : 1.;
-        bool wval = wad >= 0.;
+        auto const& a = L.arrays(box);
+        auto const& q = a.q;
+        auto const& fq = a.fq;
+        auto const Imz = a.Im(2);
+        auto const Ipz = a.Ip(2);
+        auto const zlo = a.lo(2);
+        auto const zhi = a.hi(2);
+
         Real lo = Ipz(i,j,k-1,n);
         Real hi = Imz(i,j,k  ,n);
 
@@ -194,60 +193,142 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
 
         zlo(i,j,k,n) = lo;
         zhi(i,j,k,n) = hi;
-        Real st = (wval) ? lo : hi;
-        Imz(i,j,k,n) = fuz*st + (1. - fuz)*0.5*(hi + lo);
     }
     );
 
+    // On the boxes whose faces are all away from the domain boundary the
+    // transverse boundary conditions are no-ops, so the corner coupling
+    // skips them there and vectorizes along i
+    const auto Li = L.part(true, domain);
+    const auto Lb = L.part(false, domain);
 
+    // The upwind states on the faces for the corner coupling (xup, yup, zup)
+    // are formed from the states on either side instead of being stored
 
     //
     // x-direction
     //
-    Box const& xbxtmp = amrex::grow(bx,0,1);
-    Array4<Real> yzlo = makeArray4(xyzlo.dataPtr(), amrex::surroundingNodes(xbxtmp,1), ncomp);
-    Array4<Real> zylo = makeArray4(xyzhi.dataPtr(), amrex::surroundingNodes(xbxtmp,2), ncomp);
-    amrex::ParallelFor(
-    Box(zylo), ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    if (!Li.empty())
     {
-        const auto bc = pbc[n];
-        Real l_zylo, l_zyhi;
-        GodunovCornerCouple::AddCornerCoupleTermZY(l_zylo, l_zyhi,
-                              i, j, k, n, l_dt, dy, iconserv[n],
-                              zlo(i,j,k,n), zhi(i,j,k,n),
-                              q, divu, vmac, Imy);
-
-        Real wad = wmac(i,j,k);
-        GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, l_zylo, l_zyhi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, is_velocity);
-
-        Real st = (wad >= 0.) ? l_zylo : l_zyhi;
-        Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
-        zylo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_zyhi + l_zylo);
-    },
-    Box(yzlo), ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        Li.ParallelFor(
+        FaceRegion(2, IntVect(1,0,0)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Li.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& vmac = a.mac[1];
+            auto const& wmac = a.mac[2];
+            auto const zlo = a.lo(2);
+            auto const zhi = a.hi(2);
+            auto const zylo = a.trans(1,0,2);
+            const GodunovCornerCouple::UpwindState yup{a.lo(1), a.hi(1), a.mac[1]};
+
+            Real l_zylo, l_zyhi;
+            GodunovCornerCouple::AddCornerCoupleTermZY(l_zylo, l_zyhi,
+                                  i, j, k, n, l_dt, dy, iconserv[n],
+                                  zlo(i,j,k,n), zhi(i,j,k,n),
+                                  q, divu, vmac, yup);
+            zylo(i,j,k,n) = GodunovCornerCouple::UpwindFaceState(l_zylo, l_zyhi, wmac(i,j,k));
+        },
+        FaceRegion(1, IntVect(1,0,0)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Li.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& vmac = a.mac[1];
+            auto const& wmac = a.mac[2];
+            auto const ylo = a.lo(1);
+            auto const yhi = a.hi(1);
+            auto const yzlo = a.trans(0,0,1);
+            const GodunovCornerCouple::UpwindState zup{a.lo(2), a.hi(2), a.mac[2]};
+
+            Real l_yzlo, l_yzhi;
+            GodunovCornerCouple::AddCornerCoupleTermYZ(l_yzlo, l_yzhi,
+                                  i, j, k, n, l_dt, dz, iconserv[n],
+                                  ylo(i,j,k,n), yhi(i,j,k,n),
+                                  q, divu, wmac, zup);
+            yzlo(i,j,k,n) = GodunovCornerCouple::UpwindFaceState(l_yzlo, l_yzhi, vmac(i,j,k));
+        });
+    }
+    if (!Lb.empty())
     {
-        const auto bc = pbc[n];
-        Real l_yzlo, l_yzhi;
-        GodunovCornerCouple::AddCornerCoupleTermYZ(l_yzlo, l_yzhi,
-                              i, j, k, n, l_dt, dz, iconserv[n],
-                              ylo(i,j,k,n), yhi(i,j,k,n),
-                              q, divu, wmac, Imz);
-
-        Real vad = vmac(i,j,k);
-        GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yzlo, l_yzhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, is_velocity);
-
-        Real st = (vad >= 0.) ? l_yzlo : l_yzhi;
-        Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
-        yzlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_yzhi + l_yzlo);
-    });
+        Lb.ParallelFor(
+        FaceRegion(2, IntVect(1,0,0)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Lb.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& vmac = a.mac[1];
+            auto const& wmac = a.mac[2];
+            auto const zlo = a.lo(2);
+            auto const zhi = a.hi(2);
+            auto const zylo = a.trans(1,0,2);
+            const GodunovCornerCouple::UpwindState yup{a.lo(1), a.hi(1), a.mac[1]};
+
+            const auto bc = pbc[n];
+            Real l_zylo, l_zyhi;
+            GodunovCornerCouple::AddCornerCoupleTermZY(l_zylo, l_zyhi,
+                                  i, j, k, n, l_dt, dy, iconserv[n],
+                                  zlo(i,j,k,n), zhi(i,j,k,n),
+                                  q, divu, vmac, yup);
+
+            Real wad = wmac(i,j,k);
+            GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, l_zylo, l_zyhi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, is_velocity);
+
+            Real st = (wad >= 0.) ? l_zylo : l_zyhi;
+            Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
+            zylo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_zyhi + l_zylo);
+        },
+        FaceRegion(1, IntVect(1,0,0)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Lb.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& vmac = a.mac[1];
+            auto const& wmac = a.mac[2];
+            auto const ylo = a.lo(1);
+            auto const yhi = a.hi(1);
+            auto const yzlo = a.trans(0,0,1);
+            const GodunovCornerCouple::UpwindState zup{a.lo(2), a.hi(2), a.mac[2]};
+
+            const auto bc = pbc[n];
+            Real l_yzlo, l_yzhi;
+            GodunovCornerCouple::AddCornerCoupleTermYZ(l_yzlo, l_yzhi,
+                                  i, j, k, n, l_dt, dz, iconserv[n],
+                                  ylo(i,j,k,n), yhi(i,j,k,n),
+                                  q, divu, wmac, zup);
+
+            Real vad = vmac(i,j,k);
+            GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yzlo, l_yzhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, is_velocity);
+
+            Real st = (vad >= 0.) ? l_yzlo : l_yzhi;
+            Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
+            yzlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_yzhi + l_yzlo);
+        });
+    }
 
 
     //
-    amrex::ParallelFor(xbx, ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    L.ParallelFor(FaceRegion(0), ncomp,
+    [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
+        auto const& a = L.arrays(box);
+        auto const& q = a.q;
+        auto const& fq = a.fq;
+        auto const& divu = a.divu;
+        auto const& umac = a.mac[0];
+        auto const& vmac = a.mac[1];
+        auto const& wmac = a.mac[2];
+        auto const xlo = a.lo(0);
+        auto const xhi = a.hi(0);
+        auto const yzlo = a.trans(0,0,1);
+        auto const zylo = a.trans(1,0,2);
+        auto const& xedge = a.edge[0];
+
     Real stl = xlo(i,j,k,n);
     Real sth = xhi(i,j,k,n);
 
@@ -305,49 +386,126 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
     //
     // y-direction
     //
-    Box const& ybxtmp = amrex::grow(bx,1,1);
-    Array4<Real> xzlo = makeArray4(xyzlo.dataPtr(), amrex::surroundingNodes(ybxtmp,0), ncomp);
-    Array4<Real> zxlo = makeArray4(xyzhi.dataPtr(), amrex::surroundingNodes(ybxtmp,2), ncomp);
-    amrex::ParallelFor(
-    Box(xzlo), ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    if (!Li.empty())
     {
-        const auto bc = pbc[n];
-        Real l_xzlo, l_xzhi;
-        GodunovCornerCouple::AddCornerCoupleTermXZ(l_xzlo, l_xzhi,
-                              i, j, k, n, l_dt, dz, iconserv[n],
-                              xlo(i,j,k,n),  xhi(i,j,k,n),
-                              q, divu, wmac, Imz);
-
-        Real uad = umac(i,j,k);
-        GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xzlo, l_xzhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, is_velocity);
-
-        Real st = (uad >= 0.) ? l_xzlo : l_xzhi;
-        Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
-        xzlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_xzhi + l_xzlo);
-    },
-    Box(zxlo), ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        Li.ParallelFor(
+        FaceRegion(0, IntVect(0,1,0)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Li.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& umac = a.mac[0];
+            auto const& wmac = a.mac[2];
+            auto const xlo = a.lo(0);
+            auto const xhi = a.hi(0);
+            auto const xzlo = a.trans(0,1,0);
+            const GodunovCornerCouple::UpwindState zup{a.lo(2), a.hi(2), a.mac[2]};
+
+            Real l_xzlo, l_xzhi;
+            GodunovCornerCouple::AddCornerCoupleTermXZ(l_xzlo, l_xzhi,
+                                  i, j, k, n, l_dt, dz, iconserv[n],
+                                  xlo(i,j,k,n), xhi(i,j,k,n),
+                                  q, divu, wmac, zup);
+            xzlo(i,j,k,n) = GodunovCornerCouple::UpwindFaceState(l_xzlo, l_xzhi, umac(i,j,k));
+        },
+        FaceRegion(2, IntVect(0,1,0)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Li.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& umac = a.mac[0];
+            auto const& wmac = a.mac[2];
+            auto const zlo = a.lo(2);
+            auto const zhi = a.hi(2);
+            auto const zxlo = a.trans(1,1,2);
+            const GodunovCornerCouple::UpwindState xup{a.lo(0), a.hi(0), a.mac[0]};
+
+            Real l_zxlo, l_zxhi;
+            GodunovCornerCouple::AddCornerCoupleTermZX(l_zxlo, l_zxhi,
+                                  i, j, k, n, l_dt, dx, iconserv[n],
+                                  zlo(i,j,k,n), zhi(i,j,k,n),
+                                  q, divu, umac, xup);
+            zxlo(i,j,k,n) = GodunovCornerCouple::UpwindFaceState(l_zxlo, l_zxhi, wmac(i,j,k));
+        });
+    }
+    if (!Lb.empty())
     {
-        const auto bc = pbc[n];
-        Real l_zxlo, l_zxhi;
-        GodunovCornerCouple::AddCornerCoupleTermZX(l_zxlo, l_zxhi,
-                              i, j, k, n, l_dt, dx, iconserv[n],
-                              zlo(i,j,k,n), zhi(i,j,k,n),
-                              q, divu, umac, Imx);
-
-        Real wad = wmac(i,j,k);
-        GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, l_zxlo, l_zxhi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, is_velocity);
-
-        Real st = (wad >= 0.) ? l_zxlo : l_zxhi;
-        Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
-        zxlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_zxhi + l_zxlo);
-    });
+        Lb.ParallelFor(
+        FaceRegion(0, IntVect(0,1,0)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Lb.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& umac = a.mac[0];
+            auto const& wmac = a.mac[2];
+            auto const xlo = a.lo(0);
+            auto const xhi = a.hi(0);
+            auto const xzlo = a.trans(0,1,0);
+            const GodunovCornerCouple::UpwindState zup{a.lo(2), a.hi(2), a.mac[2]};
+
+            const auto bc = pbc[n];
+            Real l_xzlo, l_xzhi;
+            GodunovCornerCouple::AddCornerCoupleTermXZ(l_xzlo, l_xzhi,
+                                  i, j, k, n, l_dt, dz, iconserv[n],
+                                  xlo(i,j,k,n),  xhi(i,j,k,n),
+                                  q, divu, wmac, zup);
+
+            Real uad = umac(i,j,k);
+            GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xzlo, l_xzhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, is_velocity);
+
+            Real st = (uad >= 0.) ? l_xzlo : l_xzhi;
+            Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
+            xzlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_xzhi + l_xzlo);
+        },
+        FaceRegion(2, IntVect(0,1,0)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Lb.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& umac = a.mac[0];
+            auto const& wmac = a.mac[2];
+            auto const zlo = a.lo(2);
+            auto const zhi = a.hi(2);
+            auto const zxlo = a.trans(1,1,2);
+            const GodunovCornerCouple::UpwindState xup{a.lo(0), a.hi(0), a.mac[0]};
+
+            const auto bc = pbc[n];
+            Real l_zxlo, l_zxhi;
+            GodunovCornerCouple::AddCornerCoupleTermZX(l_zxlo, l_zxhi,
+                                  i, j, k, n, l_dt, dx, iconserv[n],
+                                  zlo(i,j,k,n), zhi(i,j,k,n),
+                                  q, divu, umac, xup);
+
+            Real wad = wmac(i,j,k);
+            GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, l_zxlo, l_zxhi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, is_velocity);
+
+            Real st = (wad >= 0.) ? l_zxlo : l_zxhi;
+            Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
+            zxlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_zxhi + l_zxlo);
+        });
+    }
 
     //
-    amrex::ParallelFor(ybx, ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    L.ParallelFor(FaceRegion(1), ncomp,
+    [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
+        auto const& a = L.arrays(box);
+        auto const& q = a.q;
+        auto const& fq = a.fq;
+        auto const& divu = a.divu;
+        auto const& umac = a.mac[0];
+        auto const& vmac = a.mac[1];
+        auto const& wmac = a.mac[2];
+        auto const ylo = a.lo(1);
+        auto const yhi = a.hi(1);
+        auto const xzlo = a.trans(0,1,0);
+        auto const zxlo = a.trans(1,1,2);
+        auto const& yedge = a.edge[1];
+
     Real stl = ylo(i,j,k,n);
     Real sth = yhi(i,j,k,n);
 
@@ -404,49 +562,126 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
     //
     // z-direcion
     //
-    Box const& zbxtmp = amrex::grow(bx,2,1);
-    Array4<Real> xylo = makeArray4(xyzlo.dataPtr(), amrex::surroundingNodes(zbxtmp,0), ncomp);
-    Array4<Real> yxlo = makeArray4(xyzhi.dataPtr(), amrex::surroundingNodes(zbxtmp,1), ncomp);
-    amrex::ParallelFor(
-    Box(xylo), ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    if (!Li.empty())
     {
-        const auto bc = pbc[n];
-        Real l_xylo, l_xyhi;
-        GodunovCornerCouple::AddCornerCoupleTermXY(l_xylo, l_xyhi,
-                              i, j, k, n, l_dt, dy, iconserv[n],
-                              xlo(i,j,k,n), xhi(i,j,k,n),
-                              q, divu, vmac, Imy);
-
-        Real uad = umac(i,j,k);
-        GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xylo, l_xyhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, is_velocity);
-
-        Real st = (uad >= 0.) ? l_xylo : l_xyhi;
-        Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
-        xylo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_xyhi + l_xylo);
-    },
-    Box(yxlo), ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        Li.ParallelFor(
+        FaceRegion(0, IntVect(0,0,1)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Li.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& umac = a.mac[0];
+            auto const& vmac = a.mac[1];
+            auto const xlo = a.lo(0);
+            auto const xhi = a.hi(0);
+            auto const xylo = a.trans(0,2,0);
+            const GodunovCornerCouple::UpwindState yup{a.lo(1), a.hi(1), a.mac[1]};
+
+            Real l_xylo, l_xyhi;
+            GodunovCornerCouple::AddCornerCoupleTermXY(l_xylo, l_xyhi,
+                                  i, j, k, n, l_dt, dy, iconserv[n],
+                                  xlo(i,j,k,n), xhi(i,j,k,n),
+                                  q, divu, vmac, yup);
+            xylo(i,j,k,n) = GodunovCornerCouple::UpwindFaceState(l_xylo, l_xyhi, umac(i,j,k));
+        },
+        FaceRegion(1, IntVect(0,0,1)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Li.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& umac = a.mac[0];
+            auto const& vmac = a.mac[1];
+            auto const ylo = a.lo(1);
+            auto const yhi = a.hi(1);
+            auto const yxlo = a.trans(1,2,1);
+            const GodunovCornerCouple::UpwindState xup{a.lo(0), a.hi(0), a.mac[0]};
+
+            Real l_yxlo, l_yxhi;
+            GodunovCornerCouple::AddCornerCoupleTermYX(l_yxlo, l_yxhi,
+                                  i, j, k, n, l_dt, dx, iconserv[n],
+                                  ylo(i,j,k,n), yhi(i,j,k,n),
+                                  q, divu, umac, xup);
+            yxlo(i,j,k,n) = GodunovCornerCouple::UpwindFaceState(l_yxlo, l_yxhi, vmac(i,j,k));
+        });
+    }
+    if (!Lb.empty())
     {
-        const auto bc = pbc[n];
-        Real l_yxlo, l_yxhi;
-        GodunovCornerCouple::AddCornerCoupleTermYX(l_yxlo, l_yxhi,
-                              i, j, k, n, l_dt, dx, iconserv[n],
-                              ylo(i,j,k,n), yhi(i,j,k,n),
-                              q, divu, umac, Imx);
-
-        Real vad = vmac(i,j,k);
-        GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yxlo, l_yxhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, is_velocity);
-
-        Real st = (vad >= 0.) ? l_yxlo : l_yxhi;
-        Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
-        yxlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_yxhi + l_yxlo);
-    });
+        Lb.ParallelFor(
+        FaceRegion(0, IntVect(0,0,1)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Lb.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& umac = a.mac[0];
+            auto const& vmac = a.mac[1];
+            auto const xlo = a.lo(0);
+            auto const xhi = a.hi(0);
+            auto const xylo = a.trans(0,2,0);
+            const GodunovCornerCouple::UpwindState yup{a.lo(1), a.hi(1), a.mac[1]};
+
+            const auto bc = pbc[n];
+            Real l_xylo, l_xyhi;
+            GodunovCornerCouple::AddCornerCoupleTermXY(l_xylo, l_xyhi,
+                                  i, j, k, n, l_dt, dy, iconserv[n],
+                                  xlo(i,j,k,n), xhi(i,j,k,n),
+                                  q, divu, vmac, yup);
+
+            Real uad = umac(i,j,k);
+            GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xylo, l_xyhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, is_velocity);
+
+            Real st = (uad >= 0.) ? l_xylo : l_xyhi;
+            Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
+            xylo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_xyhi + l_xylo);
+        },
+        FaceRegion(1, IntVect(0,0,1)), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            auto const& a = Lb.arrays(box);
+            auto const& q = a.q;
+            auto const& divu = a.divu;
+            auto const& umac = a.mac[0];
+            auto const& vmac = a.mac[1];
+            auto const ylo = a.lo(1);
+            auto const yhi = a.hi(1);
+            auto const yxlo = a.trans(1,2,1);
+            const GodunovCornerCouple::UpwindState xup{a.lo(0), a.hi(0), a.mac[0]};
+
+            const auto bc = pbc[n];
+            Real l_yxlo, l_yxhi;
+            GodunovCornerCouple::AddCornerCoupleTermYX(l_yxlo, l_yxhi,
+                                  i, j, k, n, l_dt, dx, iconserv[n],
+                                  ylo(i,j,k,n), yhi(i,j,k,n),
+                                  q, divu, umac, xup);
+
+            Real vad = vmac(i,j,k);
+            GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yxlo, l_yxhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, is_velocity);
+
+            Real st = (vad >= 0.) ? l_yxlo : l_yxhi;
+            Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
+            yxlo(i,j,k,n) = fu*st + (1.0 - fu) * 0.5 * (l_yxhi + l_yxlo);
+        });
+    }
     //
 
-    amrex::ParallelFor(zbx, ncomp,
-    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    L.ParallelFor(FaceRegion(2), ncomp,
+    [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
     {
+        auto const& a = L.arrays(box);
+        auto const& q = a.q;
+        auto const& fq = a.fq;
+        auto const& divu = a.divu;
+        auto const& umac = a.mac[0];
+        auto const& vmac = a.mac[1];
+        auto const& wmac = a.mac[2];
+        auto const zlo = a.lo(2);
+        auto const zhi = a.hi(2);
+        auto const xylo = a.trans(0,2,0);
+        auto const yxlo = a.trans(1,2,1);
+        auto const& zedge = a.edge[2];
+
         Real stl = zlo(i,j,k,n);
     Real sth = zhi(i,j,k,n);
 
@@ -502,4 +737,97 @@ Godunov::ComputeEdgeState (Box const& bx, int ncomp,
     });
 
 }
+
+}
+
+void
+Godunov::ComputeEdgeState (Box const& bx, int ncomp,
+                           Array4<Real const> const& q,
+                           Array4<Real> const& xedge,
+                           Array4<Real> const& yedge,
+                           Array4<Real> const& zedge,
+                           Array4<Real const> const& umac,
+                           Array4<Real const> const& vmac,
+                           Array4<Real const> const& wmac,
+                           Array4<Real const> const& divu,
+                           Array4<Real const> const& fq,
+                           Geometry geom,
+                           Real l_dt,
+                           BCRec const* pbc, int const* iconserv,
+                           bool use_ppm,
+                           bool use_forces_in_trans,
+                           bool is_velocity)
+{
+    FArrayBox tmpfab(amrex::grow(bx,1),  GodunovEdgeState::nscratch*ncomp);
+    Elixir tmpeli = tmpfab.elixir();
+
+    GodunovEdgeState::TileLauncher L;
+    L.a.bx    = bx;
+    L.a.ncomp = ncomp;
+    L.a.p     = tmpfab.dataPtr();
+    L.a.q     = q;
+    L.a.edge  = {xedge, yedge, zedge};
+    L.a.mac   = {umac, vmac, wmac};
+    L.a.divu  = divu;
+    L.a.fq    = fq;
+
+    edge_state(L, ncomp, geom, l_dt, pbc, iconserv, use_ppm, use_forces_in_trans, is_velocity);
+}
+
+void
+Godunov::ComputeEdgeState (int ncomp,
+                           MultiFab const& state, int state_comp,
+                           AMREX_D_DECL(MultiFab& xedge,
+                                        MultiFab& yedge,
+                                        MultiFab& zedge),
+                           int edge_comp,
+                           AMREX_D_DECL(MultiFab const& umac,
+                                        MultiFab const& vmac,
+                                        MultiFab const& wmac),
+                           MultiFab const& divu,
+                           MultiFab const& fq, int fq_comp,
+                           Geometry const& geom,
+                           Real l_dt,
+                           BCRec const* pbc, int const* iconserv,
+                           bool use_ppm,
+                           bool use_forces_in_trans,
+                           bool is_velocity,
+                           int const* box_mask)
+{
+    // On the CPU the tiles keep the PPM pencil sweep and the vectorized
+    // corner coupling
+    if (Gpu::notInLaunchRegion())
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(state,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            if (box_mask && !box_mask[mfi.LocalIndex()]) { continue; }
+
+            Godunov::ComputeEdgeState(mfi.tilebox(), ncomp,
+                                      state.const_array(mfi,state_comp),
+                                      xedge.array(mfi,edge_comp),
+                                      yedge.array(mfi,edge_comp),
+                                      zedge.array(mfi,edge_comp),
+                                      umac.const_array(mfi),
+                                      vmac.const_array(mfi),
+                                      wmac.const_array(mfi),
+                                      divu.const_array(mfi),
+                                      fq.const_array(mfi,fq_comp),
+                                      geom, l_dt, pbc, iconserv,
+                                      use_ppm, use_forces_in_trans, is_velocity);
+        }
+        return;
+    }
+
+    GodunovEdgeState::ForEachBatch(ncomp, state, state_comp,
+                                   {AMREX_D_DECL(&xedge, &yedge, &zedge)}, edge_comp,
+                                   {AMREX_D_DECL(&umac, &vmac, &wmac)},
+                                   divu, fq, fq_comp, geom.Domain(), box_mask,
+    [&] (GodunovEdgeState::LevelLauncher const& L)
+    {
+        edge_state(L, ncomp, geom, l_dt, pbc, iconserv, use_ppm, use_forces_in_trans, is_velocity);
+    });
+}
 /** @} */
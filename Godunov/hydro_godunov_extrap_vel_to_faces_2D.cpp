@@ -47,7 +47,9 @@ Godunov::ExtrapVelToFaces ( MultiFab const& a_vel,
             Array4<Real const> const& vel = a_vel.const_array(mfi);
             Array4<Real const> const& f   = a_forces.const_array(mfi);
 
-            scratch.resize(bxg1, (ncomp*4 + 1)*AMREX_SPACEDIM);
+            // Im/Ip, the advective velocities and the corner-coupled array
+            // used by ExtrapVelToFacesOnBox
+            scratch.resize(bxg1, (ncomp*2 + 1)*AMREX_SPACEDIM + 1);
             Real* p = scratch.dataPtr();
 
             Array4<Real> Imx = makeArray4(p,bxg1,ncomp);
@@ -78,11 +80,6 @@ Godunov::ExtrapVelToFaces ( MultiFab const& a_vel,
                                         geom, l_dt, h_bcrec, d_bcrec);
             }
 
-            ComputeAdvectiveVel( Box(u_ad), Box(v_ad),
-                                 u_ad, v_ad,
-                                 Imx, Imy, Ipx, Ipy,
-                                 vel, f, domain, l_dt, d_bcrec, use_forces_in_trans);
-
             ExtrapVelToFacesOnBox( bx, ncomp, xbx, ybx,
                                    umac, vmac, vel,
                                    u_ad, v_ad,
@@ -166,8 +163,8 @@ Godunov::ExtrapVelToFacesOnBox (Box const& bx, int ncomp,
                                 Array4<Real> const& qx,
                                 Array4<Real> const& qy,
                                 Array4<Real const> const& q,
-                                Array4<Real const> const& u_ad,
-                                Array4<Real const> const& v_ad,
+                                Array4<Real> const& u_ad,
+                                Array4<Real> const& v_ad,
                                 Array4<Real> const& Imx,
                                 Array4<Real> const& Imy,
                                 Array4<Real> const& Ipx,
@@ -190,61 +187,71 @@ Godunov::ExtrapVelToFacesOnBox (Box const& bx, int ncomp,
     Box xebox = Box(bx).grow(1,1).surroundingNodes(0);
     Box yebox = Box(bx).grow(0,1).surroundingNodes(1);
 
-    Array4<Real> xlo = makeArray4(p, xebox, ncomp);
-    p += xlo.size();
-    Array4<Real> xhi = makeArray4(p, xebox, ncomp);
-    p += xhi.size();
-    Array4<Real> ylo = makeArray4(p, yebox, ncomp);
-    p += ylo.size();
-    Array4<Real> yhi = makeArray4(p, yebox, ncomp);
-    p += yhi.size();
-
-    amrex::ParallelFor(
-    xebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-    {
-        Real lo = Ipx(i-1,j,k,n);
-        Real hi = Imx(i  ,j,k,n);
+    // The states on either side of each face overwrite Ip and Im in place:
+    // xlo(i) is Ipx(i-1) and xhi(i) is Imx(i)
+    Array4<Real> xlo = makeArray4(Ipx.dataPtr(), amrex::shift(Box(Ipx),0,1), ncomp);
+    Array4<Real> xhi = Imx;
+    Array4<Real> ylo = makeArray4(Ipy.dataPtr(), amrex::shift(Box(Ipy),1,1), ncomp);
+    Array4<Real> yhi = Imy;
 
-        if (l_use_forces_in_trans)
+    // A single sweep over the faces forms the states on either side for all
+    // components and the advective velocity from the normal component
+    amrex::ParallelFor(xebox, yebox,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        for (int n = 0; n < ncomp; ++n)
         {
-            lo += 0.5*l_dt*f(i-1,j,k,n);
-            hi += 0.5*l_dt*f(i  ,j,k,n);
-        }
+            Real lo = Ipx(i-1,j,k,n);
+            Real hi = Imx(i  ,j,k,n);
 
-        Real uad = u_ad(i,j,k);
-        auto bc = pbc[n];
+            if (l_use_forces_in_trans)
+            {
+                lo += 0.5*l_dt*f(i-1,j,k,n);
+                hi += 0.5*l_dt*f(i  ,j,k,n);
+            }
 
-        GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, lo, hi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, true);
+            auto bc = pbc[n];
+            GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, lo, hi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, true);
 
-        xlo(i,j,k,n) = lo;
-        xhi(i,j,k,n) = hi;
+            xlo(i,j,k,n) = lo;
+            xhi(i,j,k,n) = hi;
 
-        Real st = (uad >= 0.) ? lo : hi;
-        Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
-        Imx(i, j, k, n) = fu*st + (1.0 - fu) *0.5 * (hi + lo); // store xedge
+            // The x-velocity on x-faces is the advective velocity
+            if (n == 0)
+            {
+                Real st = ( (lo+hi) >= 0.) ? lo : hi;
+                bool ltm = ( (lo <= 0. && hi >= 0.) || (amrex::Math::abs(lo+hi) < small_vel) );
+                u_ad(i,j,k) = ltm ? 0. : st;
+            }
+        }
     },
-    yebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-        Real lo = Ipy(i,j-1,k,n);
-        Real hi = Imy(i,j  ,k,n);
-
-        if (l_use_forces_in_trans)
+        for (int n = 0; n < ncomp; ++n)
         {
-            lo += 0.5*l_dt*f(i,j-1,k,n);
-            hi += 0.5*l_dt*f(i,j  ,k,n);
-        }
+            Real lo = Ipy(i,j-1,k,n);
+            Real hi = Imy(i,j  ,k,n);
 
-        Real vad = v_ad(i,j,k);
-        auto bc = pbc[n];
+            if (l_use_forces_in_trans)
+            {
+                lo += 0.5*l_dt*f(i,j-1,k,n);
+                hi += 0.5*l_dt*f(i,j  ,k,n);
+            }
 
-        GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, lo, hi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, true);
+            auto bc = pbc[n];
+            GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, lo, hi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, true);
 
-        ylo(i,j,k,n) = lo;
-        yhi(i,j,k,n) = hi;
+            ylo(i,j,k,n) = lo;
+            yhi(i,j,k,n) = hi;
 
-        Real st = (vad >= 0.) ? lo : hi;
-        Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
-        Imy(i, j, k, n) = fu*st + (1.0 - fu)*0.5*(hi + lo); // store yedge
+            // The y-velocity on y-faces is the advective velocity
+            if (n == 1)
+            {
+                Real st = ( (lo+hi) >= 0.) ? lo : hi;
+                bool ltm = ( (lo <= 0. && hi >= 0.) || (amrex::Math::abs(lo+hi) < small_vel) );
+                v_ad(i,j,k) = ltm ? 0. : st;
+            }
+        }
     }
     );
 
@@ -252,7 +259,7 @@ Godunov::ExtrapVelToFacesOnBox (Box const& bx, int ncomp,
     // X-Flux
     //
     Box const  xbxtmp = Box(xbx).enclosedCells().grow(0,1);
-    Array4<Real> yzlo = makeArray4(Ipy.dataPtr(), amrex::surroundingNodes(xbxtmp,1), 1);
+    Array4<Real> yzlo = makeArray4(p, amrex::surroundingNodes(xbxtmp,1), 1);
 
     amrex::ParallelFor(Box(yzlo),
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -309,7 +316,7 @@ Godunov::ExtrapVelToFacesOnBox (Box const& bx, int ncomp,
     // Y-Flux
     //
     Box const ybxtmp  = Box(ybx).enclosedCells().grow(1,1);
-    Array4<Real> xzlo = makeArray4(Ipy.dataPtr(), amrex::surroundingNodes(ybxtmp,0), 1);
+    Array4<Real> xzlo = makeArray4(p, amrex::surroundingNodes(ybxtmp,0), 1);
     amrex::ParallelFor(Box(xzlo),
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
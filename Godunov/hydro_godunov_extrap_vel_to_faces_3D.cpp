@@ -50,7 +50,9 @@ Godunov::ExtrapVelToFaces ( MultiFab const& a_vel,
             Array4<Real const> const& vel = a_vel.const_array(mfi);
             Array4<Real const> const& f   = a_forces.const_array(mfi);
 
-            scratch.resize(bxg1, (ncomp*4 + 1)*AMREX_SPACEDIM);
+            // Im/Ip, the advective velocities and the two corner-coupled
+            // arrays used by ExtrapVelToFacesOnBox
+            scratch.resize(bxg1, (ncomp*2 + 1)*AMREX_SPACEDIM + 2);
             Real* p = scratch.dataPtr();
 
             Array4<Real> Imx = makeArray4(p,bxg1,ncomp);
@@ -89,11 +91,6 @@ Godunov::ExtrapVelToFaces ( MultiFab const& a_vel,
                                         geom, l_dt, h_bcrec, d_bcrec);
             }
 
-            ComputeAdvectiveVel( Box(u_ad), Box(v_ad), Box(w_ad),
-                                 u_ad, v_ad, w_ad,
-                                 Imx, Imy, Imz, Ipx, Ipy, Ipz,
-                                 vel, f, domain, l_dt, d_bcrec, use_forces_in_trans);
-
             ExtrapVelToFacesOnBox( bx, ncomp,
                                    xbx, ybx, zbx,
                                    umac, vmac, wmac, vel,
@@ -205,9 +202,9 @@ Godunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
                                  Array4<Real> const& qy,
                                  Array4<Real> const& qz,
                                  Array4<Real const> const& q,
-                                 Array4<Real const> const& u_ad,
-                                 Array4<Real const> const& v_ad,
-                                 Array4<Real const> const& w_ad,
+                                 Array4<Real> const& u_ad,
+                                 Array4<Real> const& v_ad,
+                                 Array4<Real> const& w_ad,
                                  Array4<Real> const& Imx,
                                  Array4<Real> const& Imy,
                                  Array4<Real> const& Imz,
@@ -234,149 +231,198 @@ Godunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
     Box yebox = Box(bx).grow(0,1).grow(2,1).surroundingNodes(1);
     Box zebox = Box(bx).grow(0,1).grow(1,1).surroundingNodes(2);
 
-    Array4<Real> xlo = makeArray4(p, xebox, ncomp);
-    p += xlo.size();
-    Array4<Real> xhi = makeArray4(p, xebox, ncomp);
-    p += xhi.size();
-    Array4<Real> ylo = makeArray4(p, yebox, ncomp);
-    p += ylo.size();
-    Array4<Real> yhi = makeArray4(p, yebox, ncomp);
-    p += yhi.size();
-    Array4<Real> zlo = makeArray4(p, zebox, ncomp);
-    p += zlo.size();
-    Array4<Real> zhi = makeArray4(p, zebox, ncomp);
-    p += zhi.size();
-
-    amrex::ParallelFor(
-    xebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    // The states on either side of each face overwrite Ip and Im in place:
+    // xlo(i) is Ipx(i-1) and xhi(i) is Imx(i)
+    Array4<Real> xlo = makeArray4(Ipx.dataPtr(), amrex::shift(Box(Ipx),0,1), ncomp);
+    Array4<Real> xhi = Imx;
+    Array4<Real> ylo = makeArray4(Ipy.dataPtr(), amrex::shift(Box(Ipy),1,1), ncomp);
+    Array4<Real> yhi = Imy;
+    Array4<Real> zlo = makeArray4(Ipz.dataPtr(), amrex::shift(Box(Ipz),2,1), ncomp);
+    Array4<Real> zhi = Imz;
+
+    // A single sweep over the faces forms the states on either side for all
+    // components and the advective velocity from the normal component
+    amrex::ParallelFor(xebox, yebox, zebox,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-        Real lo = Ipx(i-1,j,k,n);
-        Real hi = Imx(i  ,j,k,n);
-
-        if (l_use_forces_in_trans)
+        for (int n = 0; n < ncomp; ++n)
         {
-            lo += 0.5*l_dt*f(i-1,j,k,n);
-            hi += 0.5*l_dt*f(i  ,j,k,n);
-        }
+            Real lo = Ipx(i-1,j,k,n);
+            Real hi = Imx(i  ,j,k,n);
 
-        Real uad = u_ad(i,j,k);
-        auto bc = pbc[n];
+            if (l_use_forces_in_trans)
+            {
+                lo += 0.5*l_dt*f(i-1,j,k,n);
+                hi += 0.5*l_dt*f(i  ,j,k,n);
+            }
 
-        GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, lo, hi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, true);
+            auto bc = pbc[n];
+            GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, lo, hi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, true);
 
-        xlo(i,j,k,n) = lo;
-        xhi(i,j,k,n) = hi;
+            xlo(i,j,k,n) = lo;
+            xhi(i,j,k,n) = hi;
 
-        Real st = (uad >= 0.) ? lo : hi;
-        Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
-        Imx(i, j, k, n) = fu*st + (1.0 - fu) *0.5 * (hi + lo); // store xedge
+            // The x-velocity on x-faces is the advective velocity
+            if (n == 0)
+            {
+                Real st = ( (lo+hi) >= 0.) ? lo : hi;
+                bool ltm = ( (lo <= 0. && hi >= 0.) || (amrex::Math::abs(lo+hi) < small_vel) );
+                u_ad(i,j,k) = ltm ? 0. : st;
+            }
+        }
     },
-    yebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-        Real lo = Ipy(i,j-1,k,n);
-        Real hi = Imy(i,j  ,k,n);
-
-        if (l_use_forces_in_trans)
+        for (int n = 0; n < ncomp; ++n)
         {
-            lo += 0.5*l_dt*f(i,j-1,k,n);
-            hi += 0.5*l_dt*f(i,j  ,k,n);
-        }
+            Real lo = Ipy(i,j-1,k,n);
+            Real hi = Imy(i,j  ,k,n);
 
-        Real vad = v_ad(i,j,k);
-        auto bc = pbc[n];
+            if (l_use_forces_in_trans)
+            {
+                lo += 0.5*l_dt*f(i,j-1,k,n);
+                hi += 0.5*l_dt*f(i,j  ,k,n);
+            }
 
-        GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, lo, hi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, true);
+            auto bc = pbc[n];
+            GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, lo, hi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, true);
 
-        ylo(i,j,k,n) = lo;
-        yhi(i,j,k,n) = hi;
+            ylo(i,j,k,n) = lo;
+            yhi(i,j,k,n) = hi;
 
-        Real st = (vad >= 0.) ? lo : hi;
-        Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
-        Imy(i, j, k, n) = fu*st + (1.0 - fu)*0.5*(hi + lo); // store yedge
+            // The y-velocity on y-faces is the advective velocity
+            if (n == 1)
+            {
+                Real st = ( (lo+hi) >= 0.) ? lo : hi;
+                bool ltm = ( (lo <= 0. && hi >= 0.) || (amrex::Math::abs(lo+hi) < small_vel) );
+                v_ad(i,j,k) = ltm ? 0. : st;
+            }
+        }
     },
-    zebox, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-
-        Real lo = Ipz(i,j,k-1,n);
-        Real hi = Imz(i,j,k  ,n);
-
-        if (l_use_forces_in_trans)
+        for (int n = 0; n < ncomp; ++n)
         {
-            lo += 0.5*l_dt*f(i,j,k-1,n);
-            hi += 0.5*l_dt*f(i,j,k  ,n);
-        }
+            Real lo = Ipz(i,j,k-1,n);
+            Real hi = Imz(i,j,k  ,n);
 
-        Real wad = w_ad(i,j,k);
-        auto bc = pbc[n];
+            if (l_use_forces_in_trans)
+            {
+                lo += 0.5*l_dt*f(i,j,k-1,n);
+                hi += 0.5*l_dt*f(i,j,k  ,n);
+            }
 
-        GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, lo, hi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, true);
+            auto bc = pbc[n];
+            GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, lo, hi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, true);
 
-        zlo(i,j,k,n) = lo;
-        zhi(i,j,k,n) = hi;
+            zlo(i,j,k,n) = lo;
+            zhi(i,j,k,n) = hi;
 
-        Real st = (wad >= 0.) ? lo : hi;
-        Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
-        Imz(i, j, k, n) = fu*st + (1.0 - fu)*0.5*(hi + lo); // store zedge
+            // The z-velocity on z-faces is the advective velocity
+            if (n == 2)
+            {
+                Real st = ( (lo+hi) >= 0.) ? lo : hi;
+                bool ltm = ( (lo <= 0. && hi >= 0.) || (amrex::Math::abs(lo+hi) < small_vel) );
+                w_ad(i,j,k) = ltm ? 0. : st;
+            }
+        }
     }
     );
 
+    // On a tile whose faces are all away from the domain boundary the
+    // transverse boundary conditions are no-ops, so the corner coupling
+    // skips them and vectorizes along i
+    const bool interior = domain.contains(amrex::grow(bx,1));
 
-    Array4<Real> xedge = Imx;
-    Array4<Real> yedge = Imy;
-    Array4<Real> zedge = Imz;
+    // Upwind states on the faces for the corner coupling, formed from the
+    // states on either side instead of being stored
+    const GodunovCornerCouple::UpwindState xedge{xlo, xhi, u_ad};
+    const GodunovCornerCouple::UpwindState yedge{ylo, yhi, v_ad};
+    const GodunovCornerCouple::UpwindState zedge{zlo, zhi, w_ad};
 
-    Array4<Real> divu = makeArray4(Ipx.dataPtr(), grow(bx,1), 1);
-    amrex::ParallelFor(Box(divu), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-        divu(i,j,k) = 0.0;
-    });
+    // The velocity is advected in convective form, so the corner coupling
+    // never reads divu
+    Array4<Real const> const divu{};
+
+    // Two single-component arrays for the corner-coupled states, reused by
+    // each direction. Each fits in grow(bx,1).
+    Real* pc1 = p;
+    Real* pc2 = p + amrex::grow(bx,1).numPts();
 
     //
     // X-Flux
     //
     Box const xbxtmp = Box(xbx).enclosedCells().grow(0,1);
-    Array4<Real> yzlo = makeArray4(Ipy.dataPtr(), amrex::surroundingNodes(xbxtmp,1), 1);
-    Array4<Real> zylo = makeArray4(Ipz.dataPtr(), amrex::surroundingNodes(xbxtmp,2), 1);
+    Array4<Real> yzlo = makeArray4(pc1, amrex::surroundingNodes(xbxtmp,1), 1);
+    Array4<Real> zylo = makeArray4(pc2, amrex::surroundingNodes(xbxtmp,2), 1);
 
     // Add d/dy term to z-faces
     // Start with {zlo,zhi} --> {zylo, zyhi} and upwind using w_ad to {zylo}
     // Add d/dz to y-faces
     // Start with {ylo,yhi} --> {yzlo, yzhi} and upwind using v_ad to {yzlo}
-    amrex::ParallelFor(Box(zylo), Box(yzlo),
-    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    if (interior)
     {
-        constexpr int n = 0;
-        const auto bc = pbc[n];
-        Real l_zylo, l_zyhi;
-        GodunovCornerCouple::AddCornerCoupleTermZY(l_zylo, l_zyhi,
-                              i, j, k, n, l_dt, dy, false,
-                              zlo(i,j,k,n), zhi(i,j,k,n),
-                              q, divu, v_ad, yedge);
-
-        Real wad = w_ad(i,j,k);
-        GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, l_zylo, l_zyhi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, true);
-
-
-        Real st = (wad >= 0.) ? l_zylo : l_zyhi;
-        Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
-        zylo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_zyhi + l_zylo);
-    },
-    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        amrex::ParallelFor(Box(zylo), Box(yzlo),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 0;
+            Real l_zylo, l_zyhi;
+            GodunovCornerCouple::AddCornerCoupleTermZY(l_zylo, l_zyhi,
+                                  i, j, k, n, l_dt, dy, false,
+                                  zlo(i,j,k,n), zhi(i,j,k,n),
+                                  q, divu, v_ad, yedge);
+            zylo(i,j,k) = GodunovCornerCouple::UpwindFaceState(l_zylo, l_zyhi, w_ad(i,j,k));
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 0;
+            Real l_yzlo, l_yzhi;
+            GodunovCornerCouple::AddCornerCoupleTermYZ(l_yzlo, l_yzhi,
+                                  i, j, k, n, l_dt, dz, false,
+                                  ylo(i,j,k,n), yhi(i,j,k,n),
+                                  q, divu, w_ad, zedge);
+            yzlo(i,j,k) = GodunovCornerCouple::UpwindFaceState(l_yzlo, l_yzhi, v_ad(i,j,k));
+        });
+    }
+    else
     {
-        constexpr int n = 0;
-        const auto bc = pbc[n];
-        Real l_yzlo, l_yzhi;
-        GodunovCornerCouple::AddCornerCoupleTermYZ(l_yzlo, l_yzhi,
-                              i, j, k, n, l_dt, dz, false,
-                              ylo(i,j,k,n), yhi(i,j,k,n),
-                              q, divu, w_ad, zedge);
-
-        Real vad = v_ad(i,j,k);
-        GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yzlo, l_yzhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, true);
-
-        Real st = (vad >= 0.) ? l_yzlo : l_yzhi;
-        Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
-        yzlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_yzhi + l_yzlo);
-    });
+        amrex::ParallelFor(Box(zylo), Box(yzlo),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 0;
+            const auto bc = pbc[n];
+            Real l_zylo, l_zyhi;
+            GodunovCornerCouple::AddCornerCoupleTermZY(l_zylo, l_zyhi,
+                                  i, j, k, n, l_dt, dy, false,
+                                  zlo(i,j,k,n), zhi(i,j,k,n),
+                                  q, divu, v_ad, yedge);
+
+            Real wad = w_ad(i,j,k);
+            GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, l_zylo, l_zyhi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, true);
+
+
+            Real st = (wad >= 0.) ? l_zylo : l_zyhi;
+            Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
+            zylo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_zyhi + l_zylo);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 0;
+            const auto bc = pbc[n];
+            Real l_yzlo, l_yzhi;
+            GodunovCornerCouple::AddCornerCoupleTermYZ(l_yzlo, l_yzhi,
+                                  i, j, k, n, l_dt, dz, false,
+                                  ylo(i,j,k,n), yhi(i,j,k,n),
+                                  q, divu, w_ad, zedge);
+
+            Real vad = v_ad(i,j,k);
+            GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yzlo, l_yzhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, true);
+
+            Real st = (vad >= 0.) ? l_yzlo : l_yzhi;
+            Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
+            yzlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_yzhi + l_yzlo);
+        });
+    }
 
     //
     amrex::ParallelFor(xbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -421,49 +467,76 @@ Godunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
     // Y-Flux
     //
     Box const ybxtmp = Box(ybx).enclosedCells().grow(1,1);
-    Array4<Real> xzlo = makeArray4(Ipy.dataPtr(), amrex::surroundingNodes(ybxtmp,0), 1);
-    Array4<Real> zxlo = makeArray4(Ipz.dataPtr(), amrex::surroundingNodes(ybxtmp,2), 1);
+    Array4<Real> xzlo = makeArray4(pc1, amrex::surroundingNodes(ybxtmp,0), 1);
+    Array4<Real> zxlo = makeArray4(pc2, amrex::surroundingNodes(ybxtmp,2), 1);
 
     // Add d/dz to x-faces
     // Start with {xlo,xhi} --> {xzlo, xzhi} and upwind using u_ad to {xzlo}
     // Add d/dx term to z-faces
     // Start with {zlo,zhi} --> {zxlo, zxhi} and upwind using w_ad to {zxlo}
-    amrex::ParallelFor(Box(xzlo), Box(zxlo),
-    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    if (interior)
     {
-        constexpr int n = 1;
-        const auto bc = pbc[n];
-        Real l_xzlo, l_xzhi;
-        GodunovCornerCouple::AddCornerCoupleTermXZ(l_xzlo, l_xzhi,
-                              i, j, k, n, l_dt, dz, false,
-                              xlo(i,j,k,n),  xhi(i,j,k,n),
-                              q, divu, w_ad, zedge);
-
-        Real uad = u_ad(i,j,k);
-        GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xzlo, l_xzhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, true);
-
-
-        Real st = (uad >= 0.) ? l_xzlo : l_xzhi;
-        Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
-        xzlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_xzhi + l_xzlo);
-    },
-    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        amrex::ParallelFor(Box(xzlo), Box(zxlo),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 1;
+            Real l_xzlo, l_xzhi;
+            GodunovCornerCouple::AddCornerCoupleTermXZ(l_xzlo, l_xzhi,
+                                  i, j, k, n, l_dt, dz, false,
+                                  xlo(i,j,k,n), xhi(i,j,k,n),
+                                  q, divu, w_ad, zedge);
+            xzlo(i,j,k) = GodunovCornerCouple::UpwindFaceState(l_xzlo, l_xzhi, u_ad(i,j,k));
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 1;
+            Real l_zxlo, l_zxhi;
+            GodunovCornerCouple::AddCornerCoupleTermZX(l_zxlo, l_zxhi,
+                                  i, j, k, n, l_dt, dx, false,
+                                  zlo(i,j,k,n), zhi(i,j,k,n),
+                                  q, divu, u_ad, xedge);
+            zxlo(i,j,k) = GodunovCornerCouple::UpwindFaceState(l_zxlo, l_zxhi, w_ad(i,j,k));
+        });
+    }
+    else
     {
-        constexpr int n = 1;
-        const auto bc = pbc[n];
-        Real l_zxlo, l_zxhi;
-        GodunovCornerCouple::AddCornerCoupleTermZX(l_zxlo, l_zxhi,
-                              i, j, k, n, l_dt, dx, false,
-                              zlo(i,j,k,n), zhi(i,j,k,n),
-                              q, divu, u_ad, xedge);
-
-        Real wad = w_ad(i,j,k);
-        GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, l_zxlo, l_zxhi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, true);
-
-        Real st = (wad >= 0.) ? l_zxlo : l_zxhi;
-        Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
-        zxlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_zxhi + l_zxlo);
-    });
+        amrex::ParallelFor(Box(xzlo), Box(zxlo),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 1;
+            const auto bc = pbc[n];
+            Real l_xzlo, l_xzhi;
+            GodunovCornerCouple::AddCornerCoupleTermXZ(l_xzlo, l_xzhi,
+                                  i, j, k, n, l_dt, dz, false,
+                                  xlo(i,j,k,n),  xhi(i,j,k,n),
+                                  q, divu, w_ad, zedge);
+
+            Real uad = u_ad(i,j,k);
+            GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xzlo, l_xzhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, true);
+
+
+            Real st = (uad >= 0.) ? l_xzlo : l_xzhi;
+            Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
+            xzlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_xzhi + l_xzlo);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 1;
+            const auto bc = pbc[n];
+            Real l_zxlo, l_zxhi;
+            GodunovCornerCouple::AddCornerCoupleTermZX(l_zxlo, l_zxhi,
+                                  i, j, k, n, l_dt, dx, false,
+                                  zlo(i,j,k,n), zhi(i,j,k,n),
+                                  q, divu, u_ad, xedge);
+
+            Real wad = w_ad(i,j,k);
+            GodunovTransBC::SetTransTermZBCs(i, j, k, n, q, l_zxlo, l_zxhi, bc.lo(2), bc.hi(2), dlo.z, dhi.z, true);
+
+            Real st = (wad >= 0.) ? l_zxlo : l_zxhi;
+            Real fu = (amrex::Math::abs(wad) < small_vel) ? 0.0 : 1.0;
+            zxlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_zxhi + l_zxlo);
+        });
+    }
 
     //
     amrex::ParallelFor(ybx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -510,54 +583,81 @@ Godunov::ExtrapVelToFacesOnBox ( Box const& bx, int ncomp,
     // Z-Flux
     //
     Box const zbxtmp = Box(zbx).enclosedCells().grow(2,1);
-    Array4<Real> xylo = makeArray4(Ipy.dataPtr(), amrex::surroundingNodes(zbxtmp,0), 1);
-    Array4<Real> yxlo = makeArray4(Ipz.dataPtr(), amrex::surroundingNodes(zbxtmp,1), 1);
+    Array4<Real> xylo = makeArray4(pc1, amrex::surroundingNodes(zbxtmp,0), 1);
+    Array4<Real> yxlo = makeArray4(pc2, amrex::surroundingNodes(zbxtmp,1), 1);
 
-    amrex::ParallelFor(Box(xylo), Box(yxlo),
-    //
-    // Add d/dy term to x-faces
-    // Start with {xlo,xhi} --> {xylo, xyhi} and upwind using u_ad to {xylo}
-    //
-    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    if (interior)
     {
-        constexpr int n = 2;
-        const auto bc = pbc[n];
-        Real l_xylo, l_xyhi;
-        GodunovCornerCouple::AddCornerCoupleTermXY(l_xylo, l_xyhi,
-                              i, j, k, n, l_dt, dy, false,
-                              xlo(i,j,k,n), xhi(i,j,k,n),
-                              q, divu, v_ad, yedge);
-
-        Real uad = u_ad(i,j,k);
-        GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xylo, l_xyhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, true);
-
-
-        Real st = (uad >= 0.) ? l_xylo : l_xyhi;
-        Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
-        xylo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_xyhi + l_xylo);
-    },
-    //
-    // Add d/dx term to y-faces
-    // Start with {ylo,yhi} --> {yxlo, yxhi} and upwind using v_ad to {yxlo}
-    //
-    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        amrex::ParallelFor(Box(xylo), Box(yxlo),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 2;
+            Real l_xylo, l_xyhi;
+            GodunovCornerCouple::AddCornerCoupleTermXY(l_xylo, l_xyhi,
+                                  i, j, k, n, l_dt, dy, false,
+                                  xlo(i,j,k,n), xhi(i,j,k,n),
+                                  q, divu, v_ad, yedge);
+            xylo(i,j,k) = GodunovCornerCouple::UpwindFaceState(l_xylo, l_xyhi, u_ad(i,j,k));
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 2;
+            Real l_yxlo, l_yxhi;
+            GodunovCornerCouple::AddCornerCoupleTermYX(l_yxlo, l_yxhi,
+                                  i, j, k, n, l_dt, dx, false,
+                                  ylo(i,j,k,n), yhi(i,j,k,n),
+                                  q, divu, u_ad, xedge);
+            yxlo(i,j,k) = GodunovCornerCouple::UpwindFaceState(l_yxlo, l_yxhi, v_ad(i,j,k));
+        });
+    }
+    else
     {
-        constexpr int n = 2;
-        const auto bc = pbc[n];
-        Real l_yxlo, l_yxhi;
-        GodunovCornerCouple::AddCornerCoupleTermYX(l_yxlo, l_yxhi,
-                              i, j, k, n, l_dt, dx, false,
-                              ylo(i,j,k,n), yhi(i,j,k,n),
-                              q, divu, u_ad, xedge);
-
-        Real vad = v_ad(i,j,k);
-        GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yxlo, l_yxhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, true);
-
-
-        Real st = (vad >= 0.) ? l_yxlo : l_yxhi;
-        Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
-        yxlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_yxhi + l_yxlo);
-    });
+        amrex::ParallelFor(Box(xylo), Box(yxlo),
+        //
+        // Add d/dy term to x-faces
+        // Start with {xlo,xhi} --> {xylo, xyhi} and upwind using u_ad to {xylo}
+        //
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 2;
+            const auto bc = pbc[n];
+            Real l_xylo, l_xyhi;
+            GodunovCornerCouple::AddCornerCoupleTermXY(l_xylo, l_xyhi,
+                                  i, j, k, n, l_dt, dy, false,
+                                  xlo(i,j,k,n), xhi(i,j,k,n),
+                                  q, divu, v_ad, yedge);
+
+            Real uad = u_ad(i,j,k);
+            GodunovTransBC::SetTransTermXBCs(i, j, k, n, q, l_xylo, l_xyhi, bc.lo(0), bc.hi(0), dlo.x, dhi.x, true);
+
+
+            Real st = (uad >= 0.) ? l_xylo : l_xyhi;
+            Real fu = (amrex::Math::abs(uad) < small_vel) ? 0.0 : 1.0;
+            xylo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_xyhi + l_xylo);
+        },
+        //
+        // Add d/dx term to y-faces
+        // Start with {ylo,yhi} --> {yxlo, yxhi} and upwind using v_ad to {yxlo}
+        //
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr int n = 2;
+            const auto bc = pbc[n];
+            Real l_yxlo, l_yxhi;
+            GodunovCornerCouple::AddCornerCoupleTermYX(l_yxlo, l_yxhi,
+                                  i, j, k, n, l_dt, dx, false,
+                                  ylo(i,j,k,n), yhi(i,j,k,n),
+                                  q, divu, u_ad, xedge);
+
+            Real vad = v_ad(i,j,k);
+            GodunovTransBC::SetTransTermYBCs(i, j, k, n, q, l_yxlo, l_yxhi, bc.lo(1), bc.hi(1), dlo.y, dhi.y, true);
+
+
+            Real st = (vad >= 0.) ? l_yxlo : l_yxhi;
+            Real fu = (amrex::Math::abs(vad) < small_vel) ? 0.0 : 1.0;
+            yxlo(i,j,k) = fu*st + (1.0 - fu) * 0.5 * (l_yxhi + l_yxlo);
+        });
+    }
     //
     amrex::ParallelFor(zbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
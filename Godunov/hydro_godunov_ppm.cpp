@@ -42,4 +42,141 @@ PPM::PredictVelOnFaces (Box const& bx,
 #endif
     });
 }
+
+void
+PPM::PredictStateOnFaces (Box const& bx, int ncomp,
+                          AMREX_D_DECL( Array4<Real> const& Imx,
+                                        Array4<Real> const& Imy,
+                                        Array4<Real> const& Imz),
+                          AMREX_D_DECL( Array4<Real> const& Ipx,
+                                        Array4<Real> const& Ipy,
+                                        Array4<Real> const& Ipz),
+                          Array4<Real const> const& q,
+                          AMREX_D_DECL( Array4<Real const> const& umac,
+                                        Array4<Real const> const& vmac,
+                                        Array4<Real const> const& wmac),
+                          Geometry const& geom,
+                          Real dt,
+                          BCRec const* pbc)
+{
+    const Box& domain = geom.Domain();
+    const Dim3 dlo = amrex::lbound(domain);
+    const Dim3 dhi = amrex::ubound(domain);
+
+    const auto dx = geom.CellSizeArray();
+
+    if (Gpu::inLaunchRegion())
+    {
+        amrex::ParallelFor(bx, ncomp,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            PredictStateOnXFace(i, j, k, n, dt, dx[0], Imx(i,j,k,n), Ipx(i,j,k,n),
+                                q, umac, pbc[n], dlo.x, dhi.x);
+            PredictStateOnYFace(i, j, k, n, dt, dx[1], Imy(i,j,k,n), Ipy(i,j,k,n),
+                                q, vmac, pbc[n], dlo.y, dhi.y);
+#if (AMREX_SPACEDIM==3)
+            PredictStateOnZFace(i, j, k, n, dt, dx[2], Imz(i,j,k,n), Ipz(i,j,k,n),
+                                q, wmac, pbc[n], dlo.z, dhi.z);
+#endif
+        });
+        return;
+    }
+
+    // One pencil along i per (j,k,n)
+    const int ilo = bx.smallEnd(0);
+    const int ihi = bx.bigEnd(0);
+    Box rowbx(bx);
+    rowbx.setBig(0, ilo);
+
+    amrex::ParallelFor(rowbx, ncomp,
+    [=] AMREX_GPU_DEVICE (int, int j, int k, int n) noexcept
+    {
+        const BCRec bc = pbc[n];
+
+        // x: the window q(i-1:i+2), the slopes at i-1:i+1 and the value on
+        // the low face are carried to the next cell, so each cell costs one
+        // load, one slope and one interface value
+        {
+            Real sm1 = q(ilo-1,j,k,n);
+            Real s0  = q(ilo  ,j,k,n);
+            Real sp1 = q(ilo+1,j,k,n);
+            Real dm1 = vanLeer(sm1, s0, q(ilo-2,j,k,n));
+            Real d0  = vanLeer(s0, sp1, sm1);
+            Real elo = EdgeValue(sm1, s0, dm1, d0);
+
+            for (int i = ilo; i <= ihi; ++i)
+            {
+                const Real sp2 = q(i+2,j,k,n);
+                const Real dp1 = vanLeer(sp1, sp2, s0);
+                const Real ehi = EdgeValue(s0, sp1, d0, dp1);
+
+                Real sm, sp;
+                LimitEdges(s0, elo, ehi, sm, sp);
+
+                Real sedge1 = elo;
+                Real sedge2 = ehi;
+                SetXBCs(i, j, k, n, sm, sp, sedge1, sedge2, q, bc.lo(0), bc.hi(0), dlo.x, dhi.x);
+
+                TraceToFaces(s0, sm, sp, umac(i,j,k), umac(i+1,j,k), dt, dx[0],
+                             Imx(i,j,k,n), Ipx(i,j,k,n));
+
+                sm1 = s0; s0 = sp1; sp1 = sp2;
+                d0 = dp1;
+                elo = ehi;
+            }
+        }
+
+        // y: no dependence between cells of the pencil
+        AMREX_PRAGMA_SIMD
+        for (int i = ilo; i <= ihi; ++i)
+        {
+            const Real sm2 = q(i,j-2,k,n);
+            const Real sm1 = q(i,j-1,k,n);
+            const Real s0  = q(i,j  ,k,n);
+            const Real sp1 = q(i,j+1,k,n);
+            const Real sp2 = q(i,j+2,k,n);
+
+            const Real dm1 = vanLeer(sm1, s0, sm2);
+            const Real d0  = vanLeer(s0, sp1, sm1);
+            const Real dp1 = vanLeer(sp1, sp2, s0);
+
+            Real sedge1 = EdgeValue(sm1, s0, dm1, d0);
+            Real sedge2 = EdgeValue(s0, sp1, d0, dp1);
+
+            Real sm, sp;
+            LimitEdges(s0, sedge1, sedge2, sm, sp);
+            SetYBCs(i, j, k, n, sm, sp, sedge1, sedge2, q, bc.lo(1), bc.hi(1), dlo.y, dhi.y);
+
+            TraceToFaces(s0, sm, sp, vmac(i,j,k), vmac(i,j+1,k), dt, dx[1],
+                         Imy(i,j,k,n), Ipy(i,j,k,n));
+        }
+
+#if (AMREX_SPACEDIM==3)
+        // z: no dependence between cells of the pencil
+        AMREX_PRAGMA_SIMD
+        for (int i = ilo; i <= ihi; ++i)
+        {
+            const Real sm2 = q(i,j,k-2,n);
+            const Real sm1 = q(i,j,k-1,n);
+            const Real s0  = q(i,j,k  ,n);
+            const Real sp1 = q(i,j,k+1,n);
+            const Real sp2 = q(i,j,k+2,n);
+
+            const Real dm1 = vanLeer(sm1, s0, sm2);
+            const Real d0  = vanLeer(s0, sp1, sm1);
+            const Real dp1 = vanLeer(sp1, sp2, s0);
+
+            Real sedge1 = EdgeValue(sm1, s0, dm1, d0);
+            Real sedge2 = EdgeValue(s0, sp1, d0, dp1);
+
+            Real sm, sp;
+            LimitEdges(s0, sedge1, sedge2, sm, sp);
+            SetZBCs(i, j, k, n, sm, sp, sedge1, sedge2, q, bc.lo(2), bc.hi(2), dlo.z, dhi.z);
+
+            TraceToFaces(s0, sm, sp, wmac(i,j,k), wmac(i,j,k+1), dt, dx[2],
+                         Imz(i,j,k,n), Ipz(i,j,k,n));
+        }
+#endif
+    });
+}
 /** @} */
@@ -6,6 +6,7 @@
 #include <hydro_constants.H>
 #include <hydro_utils.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_MFParallelFor.H>
 
 using namespace amrex;
 
@@ -30,12 +31,21 @@ MOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
                    BCRec  const* d_bcrec_ptr,
                    Gpu::DeviceVector<int>& iconserv,
                    Geometry const&  geom,
-                   const bool is_velocity)
+                   const bool is_velocity,
+                   HydroUtils::AdvectionDiagnostics* diagnostics,
+                   const bool fuse_boxes)
 {
     BL_PROFILE("MOL::ComputeAofs()");
 
     bool fluxes_are_area_weighted = true;
 
+    // Optional diagnostics, reduced in the kernel that finishes aofs on each tile
+    std::unique_ptr<HydroUtils::AdvectionDiagnosticsReduction> diag_reduction;
+    if (diagnostics) {
+        diag_reduction = std::make_unique<HydroUtils::AdvectionDiagnosticsReduction>(
+            ncomp, geom, fluxes_are_area_weighted);
+    }
+
     AMREX_ALWAYS_ASSERT(aofs.nComp()  >= aofs_comp  + ncomp);
     AMREX_ALWAYS_ASSERT(state.nComp() >= state_comp + ncomp);
     AMREX_D_TERM( AMREX_ALWAYS_ASSERT(xedge.nComp() >= edge_comp  + ncomp);,
@@ -53,13 +63,78 @@ MOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
     // To compute edge states, need at least 2 more ghost cells in state than in
     //  xedge
     if ( !known_edgestate ) {
-        AMREX_ALWAYS_ASSERT(state.nGrow() >= xedge.nGrow()+2);
+        AMREX_ALWAYS_ASSERT(state.nGrow() >= xedge.nGrow() +
+                            HydroUtils::RequiredGhostCells(HydroUtils::AdvectionScheme::MOL, false, false,
+                                                           HydroUtils::RedistType::NoRedist,
+                                                           known_edgestate).state);
     }
 
     int const* iconserv_ptr = iconserv.data();
 
     Box  const& domain = geom.Domain();
 
+    if (fuse_boxes && Gpu::inLaunchRegion())
+    {
+        // Each step in one launch over all boxes of the level
+        const IntVect ng_f(xfluxes.nGrow());
+
+        if (!known_edgestate)
+        {
+            ComputeEdgeState( AMREX_D_DECL( xedge, yedge, zedge ), edge_comp,
+                              state, state_comp, ncomp,
+                              AMREX_D_DECL( umac, vmac, wmac ), domain, bcs, d_bcrec_ptr,
+                              is_velocity);
+        }
+
+        HydroUtils::ComputeFluxes( AMREX_D_DECL( xfluxes, yfluxes, zfluxes ), fluxes_comp,
+                                   AMREX_D_DECL( umac, vmac, wmac ),
+                                   AMREX_D_DECL( xedge, yedge, zedge ), edge_comp,
+                                   geom, ncomp, ng_f );
+
+        const auto dx     = geom.CellSizeArray();
+        const auto dxinv  = geom.InvCellSizeArray();
+        const auto problo = geom.ProbLoArray();
+        const bool is_rz  = geom.IsRZ();
+        const Real qvol   = AMREX_D_TERM(dxinv[0],*dxinv[1],*dxinv[2]);
+
+        AMREX_D_TERM( auto const& ma_fx = xfluxes.const_arrays();,
+                      auto const& ma_fy = yfluxes.const_arrays();,
+                      auto const& ma_fz = zfluxes.const_arrays(););
+        auto const& ma_q    = state.const_arrays();
+        auto const& ma_divu = divu.const_arrays();
+        auto const& ma_aofs = aofs.arrays();
+
+        // div(F), minus q divu for the convective components
+        auto finish_aofs = [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            Real div = HydroUtils::flux_divergence(i, j, k, n + fluxes_comp,
+                                                   AMREX_D_DECL(ma_fx[box], ma_fy[box], ma_fz[box]),
+                                                   qvol, dx, problo, is_rz);
+            if (!iconserv_ptr[n])
+                div -= ma_q[box](i,j,k,n+state_comp)*ma_divu[box](i,j,k);
+
+            ma_aofs[box](i,j,k,n+aofs_comp) = div;
+        };
+
+        if (diag_reduction)
+        {
+            diag_reduction->ParallelFor(aofs, aofs_comp, ncomp,
+                                        {{AMREX_D_DECL(umac.const_arrays(),
+                                                       vmac.const_arrays(),
+                                                       wmac.const_arrays())},
+                                         {AMREX_D_DECL(ma_fx, ma_fy, ma_fz)},
+                                         fluxes_comp},
+                                        finish_aofs);
+            diag_reduction->finalize(*diagnostics);
+        }
+        else
+        {
+            amrex::ParallelFor(aofs, IntVect(0), ncomp, finish_aofs);
+        }
+
+        return;
+    }
+
     MFItInfo mfi_info;
 
     if (Gpu::notInLaunchRegion())  mfi_info.EnableTiling().SetDynamic(true);
@@ -119,8 +194,9 @@ MOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
         auto const& aofs_arr  = aofs.array(mfi, aofs_comp);
         auto const& q = state.array(mfi, state_comp);
         auto const& divu_arr  = divu.array(mfi);
-        amrex::ParallelFor(bx, ncomp, [=]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        HydroUtils::ParallelForWithDiagnostics(diag_reduction.get(), bx, ncomp, aofs_arr,
+                                               {{AMREX_D_DECL(u,v,w)}, {AMREX_D_DECL(fx,fy,fz)}, {}},
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         {
             if (!iconserv_ptr[n])
                 aofs_arr( i, j, k, n ) += q(i,j,k,n)*divu_arr(i,j,k);
@@ -131,6 +207,10 @@ MOL::ComputeAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
         Gpu::streamSynchronize();  // otherwise we might be using too much memory
     }
 
+    if (diag_reduction) {
+        diag_reduction->finalize(*diagnostics);
+    }
+
 }
 
 void
@@ -176,7 +256,10 @@ MOL::ComputeSyncAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
     // To compute edge states, need at least 2 more ghost cells in state than in
     //  xedge
     if ( !known_edgestate ) {
-        AMREX_ALWAYS_ASSERT(state.nGrow() >= xedge.nGrow()+2);
+        AMREX_ALWAYS_ASSERT(state.nGrow() >= xedge.nGrow() +
+                            HydroUtils::RequiredGhostCells(HydroUtils::AdvectionScheme::MOL, false, false,
+                                                           HydroUtils::RedistType::NoRedist,
+                                                           known_edgestate).state);
     }
 
     Box  const& domain = geom.Domain();
@@ -218,13 +301,6 @@ MOL::ComputeSyncAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
 
         }
 
-        // Temporary divergence
-        Box tmpbox = amrex::surroundingNodes(bx);
-        int tmpcomp = ncomp*AMREX_SPACEDIM;
-        FArrayBox tmpfab(tmpbox, tmpcomp);
-        Elixir eli = tmpfab.elixir();
-        Array4<Real> divtmp_arr = tmpfab.array();
-
         // Compute fluxes
         HydroUtils::ComputeFluxes( bx,
                                    AMREX_D_DECL(fx,fy,fz),
@@ -233,18 +309,13 @@ MOL::ComputeSyncAofs ( MultiFab& aofs, int aofs_comp, int ncomp,
                                    geom, ncomp, fluxes_are_area_weighted );
 
         // Compute divergence
-        Real mult = -1.0;
-        HydroUtils::ComputeDivergence( bx, divtmp_arr,
+        // The sync contribution is +div, added straight into aofs
+        Real mult = 1.0;
+        HydroUtils::ComputeDivergence( bx, aofs.array(mfi, aofs_comp),
                                        AMREX_D_DECL(fx,fy,fz),
                                        ncomp, geom,
-                                       mult, fluxes_are_area_weighted);
-
-        // Sum contribution to sync aofs
-        auto const& aofs_arr = aofs.array(mfi, aofs_comp);
-
-        amrex::ParallelFor(bx, ncomp, [aofs_arr, divtmp_arr]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        { aofs_arr( i, j, k, n ) += -divtmp_arr( i, j, k, n ); });
+                                       mult, fluxes_are_area_weighted,
+                                       /*accumulate=*/true);
 
         Gpu::streamSynchronize();  // otherwise we might be using too much memory
     }
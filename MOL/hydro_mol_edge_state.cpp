@@ -5,6 +5,8 @@
 #include <hydro_mol.H>
 #include <hydro_mol_edge_state_K.H>
 
+#include <AMReX_MFParallelFor.H>
+
 using namespace amrex;
 
 namespace {
@@ -143,4 +145,79 @@ MOL::ComputeEdgeState (const Box& bx,
 
 #endif
 }
+
+
+//
+// Compute edge state on all REGULAR boxes of a level
+//
+void
+MOL::ComputeEdgeState (AMREX_D_DECL( MultiFab& xedge,
+                                     MultiFab& yedge,
+                                     MultiFab& zedge),
+                       const int edge_comp,
+                       MultiFab const& state,
+                       const int state_comp,
+                       const int ncomp,
+                       AMREX_D_DECL( MultiFab const& umac,
+                                     MultiFab const& vmac,
+                                     MultiFab const& wmac),
+                       const Box&       domain,
+                       const Vector<BCRec>& bcs,
+                       const        BCRec * d_bcrec_ptr,
+                       bool         is_velocity,
+                       int const*   box_mask)
+{
+    auto const& ma_q = state.const_arrays();
+
+    Array<MultiFab*,AMREX_SPACEDIM> const edge{AMREX_D_DECL(&xedge, &yedge, &zedge)};
+    Array<MultiFab const*,AMREX_SPACEDIM> const vel{AMREX_D_DECL(&umac, &vmac, &wmac)};
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
+    {
+        auto const& ma_e = edge[dir]->arrays();
+        auto const& ma_u = vel[dir]->const_arrays();
+        const int domlo = domain.smallEnd(dir);
+        const int domhi = domain.bigEnd(dir);
+
+        // The boxes differ, so the ext_dir variant is used on all of them
+        // as soon as any component needs it in this direction
+        auto extdir_lohi = has_extdir_or_ho(bcs.dataPtr(), ncomp, dir);
+        const bool extdir = extdir_lohi.first || extdir_lohi.second;
+
+        amrex::ParallelFor(*edge[dir], IntVect(edge[dir]->nGrow()), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            if (box_mask && !box_mask[box]) { return; }
+
+            auto const q = Array4<Real const>(ma_q[box], state_comp);
+            auto const& u = ma_u[box];
+            Real qs;
+            if (dir == 0) {
+                qs = extdir ? MOL::hydro_mol_xedge_state_extdir(i, j, k, n, q, u, d_bcrec_ptr,
+                                                                domlo, domhi, is_velocity)
+                            : MOL::hydro_mol_xedge_state(i, j, k, n, q, u, d_bcrec_ptr,
+                                                         domlo, domhi, is_velocity);
+            } else
+#if (AMREX_SPACEDIM == 3)
+            if (dir == 1)
+#endif
+            {
+                qs = extdir ? MOL::hydro_mol_yedge_state_extdir(i, j, k, n, q, u, d_bcrec_ptr,
+                                                                domlo, domhi, is_velocity)
+                            : MOL::hydro_mol_yedge_state(i, j, k, n, q, u, d_bcrec_ptr,
+                                                         domlo, domhi, is_velocity);
+            }
+#if (AMREX_SPACEDIM == 3)
+            else
+            {
+                qs = extdir ? MOL::hydro_mol_zedge_state_extdir(i, j, k, n, q, u, d_bcrec_ptr,
+                                                                domlo, domhi, is_velocity)
+                            : MOL::hydro_mol_zedge_state(i, j, k, n, q, u, d_bcrec_ptr,
+                                                         domlo, domhi, is_velocity);
+            }
+#endif
+            ma_e[box](i,j,k,n+edge_comp) = qs;
+        });
+    }
+}
 /** @}*/
@@ -1,14 +1,114 @@
 #ifdef AMREX_USE_EB
 #include <AMReX_EBMultiFabUtil.H>
+#include <AMReX_EBMultiFabUtil_C.H>
 #endif
 
 #include <AMReX_MultiFabUtil.H>
+#include <AMReX_MFParallelFor.H>
 #include <AMReX_ParmParse.H>
 
 #include <hydro_MacProjector.H>
 
+#include <type_traits>
+
 using namespace amrex;
 
+namespace {
+
+// dst = src on the valid cells, converting between precisions
+template <typename DMF, typename SMF>
+void convert_copy (DMF& dst, SMF const& src)
+{
+    using DT = typename DMF::value_type;
+    auto const& d = dst.arrays();
+    auto const& s = src.const_arrays();
+    amrex::ParallelFor(dst, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+    {
+        d[box_no](i,j,k) = static_cast<DT>(s[box_no](i,j,k));
+    });
+    Gpu::streamSynchronize();
+}
+
+// Apply the mac_proj inputs to a linear operator and its MLMG, in double or
+// in single precision
+template <typename LP, typename MG>
+void set_solver_options (LP& linop, MG& mlmg, int& verbose)
+{
+    // Default values
+    int          maxorder(3);
+    int          bottom_verbose(0);
+    int          maxiter(200);
+    int          bottom_maxiter(200);
+    Real         bottom_rtol(1.0e-4_rt);
+    Real         bottom_atol(-1.0_rt);
+    std::string  bottom_solver("bicg");
+
+    int num_pre_smooth(2);
+    int num_post_smooth(2);
+
+    // Read from input file
+    ParmParse pp("mac_proj");
+    pp.query( "verbose"       , verbose );
+    pp.query( "maxorder"      , maxorder );
+    pp.query( "bottom_verbose", bottom_verbose );
+    pp.query( "maxiter"       , maxiter );
+    pp.query( "bottom_maxiter", bottom_maxiter );
+    pp.query( "bottom_rtol"   , bottom_rtol );
+    pp.query( "bottom_atol"   , bottom_atol );
+    pp.query( "bottom_solver" , bottom_solver );
+
+    pp.query( "num_pre_smooth"  , num_pre_smooth );
+    pp.query( "num_post_smooth" , num_post_smooth );
+
+    // Set default/input values
+    linop.setMaxOrder(maxorder);
+    mlmg.setVerbose(verbose);
+    mlmg.setBottomVerbose(bottom_verbose);
+    mlmg.setMaxIter(maxiter);
+    mlmg.setBottomMaxIter(bottom_maxiter);
+    mlmg.setBottomTolerance(bottom_rtol);
+    mlmg.setBottomToleranceAbs(bottom_atol);
+
+    mlmg.setPreSmooth(num_pre_smooth);
+    mlmg.setPostSmooth(num_post_smooth);
+
+    if (bottom_solver == "smoother")
+    {
+        mlmg.setBottomSolver(MG::BottomSolver::smoother);
+    }
+    else if (bottom_solver == "bicg")
+    {
+        mlmg.setBottomSolver(MG::BottomSolver::bicgstab);
+    }
+    else if (bottom_solver == "cg")
+    {
+        mlmg.setBottomSolver(MG::BottomSolver::cg);
+    }
+    else if (bottom_solver == "bicgcg")
+    {
+        mlmg.setBottomSolver(MG::BottomSolver::bicgcg);
+    }
+    else if (bottom_solver == "cgbicg")
+    {
+        mlmg.setBottomSolver(MG::BottomSolver::cgbicg);
+    }
+    else if (bottom_solver == "hypre")
+    {
+#ifdef AMREX_USE_HYPRE
+        if constexpr (std::is_same<MG,MLMG>::value) {
+            mlmg.setBottomSolver(MG::BottomSolver::hypre);
+        } else {
+            // hypre only works in double precision
+            mlmg.setBottomSolver(MG::BottomSolver::bicgstab);
+        }
+#else
+        amrex::Abort("AMReX was not built with HYPRE support");
+#endif
+    }
+}
+
+}
+
 namespace Hydro {
 
 MacProjector::MacProjector(
@@ -55,6 +155,9 @@ void MacProjector::initProjector (
     const Vector<Array<MultiFab const*,AMREX_SPACEDIM> >& a_beta,
     const Vector<iMultiFab const*>& a_overset_mask)
 {
+    m_lpinfo = a_lpinfo;
+    m_has_overset_mask = !a_overset_mask.empty();
+
     const int nlevs = a_beta.size();
     Vector<BoxArray> ba(nlevs);
     Vector<DistributionMapping> dm(nlevs);
@@ -68,6 +171,8 @@ void MacProjector::initProjector (
     m_phi.resize(nlevs);
     m_fluxes.resize(nlevs);
     m_divu.resize(nlevs);
+    m_needs_level_bcs.resize(nlevs, true);
+    m_level_bc_has_data.resize(nlevs, false);
 
 #ifdef AMREX_USE_EB
     bool has_eb = a_beta[0][0]->hasEBFabFactory();
@@ -132,6 +237,7 @@ void MacProjector::initProjector (
     m_mlmg = std::make_unique<MLMG>(*m_linop);
 
     setOptions();
+    if (m_solver_setup) { m_solver_setup(*m_linop, *m_mlmg); }
 
     m_needs_init = false;
 }
@@ -147,6 +253,10 @@ void MacProjector::updateBeta (
         m_poisson == nullptr,
         "MacProjector::updateBeta: should not be called for constant beta");
 
+    rebuildIfNeeded();
+    m_needs_beta = false;
+    m_mlmg_f.reset();
+
     const int nlevs = a_beta.size();
 #ifdef AMREX_USE_EB
     const bool has_eb = a_beta[0][0]->hasEBFabFactory();
@@ -165,6 +275,7 @@ void MacProjector::setUMAC(
     const Vector<Array<MultiFab*, AMREX_SPACEDIM>>& a_umac)
 {
     m_umac = a_umac;
+    m_needs_umac = false;
 }
 
 void MacProjector::setDivU(const Vector<MultiFab const*>& a_divu)
@@ -199,7 +310,11 @@ MacProjector::setDomainBC (const Array<LinOpBCType,AMREX_SPACEDIM>& lobc,
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
         m_linop != nullptr,
         "MacProjector::setDomainBC: initProjector must be called before calling this method");
+    rebuildIfNeeded();
     m_linop->setDomainBC(lobc, hibc);
+    m_mlmg_f.reset();
+    m_lobc = lobc;
+    m_hibc = hibc;
     m_needs_domain_bcs = false;
 }
 
@@ -209,19 +324,40 @@ MacProjector::setLevelBC (int amrlev, const MultiFab* levelbcdata)
 {
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_needs_domain_bcs,
                                      "setDomainBC must be called before setLevelBC");
+    rebuildIfNeeded();
     m_linop->setLevelBC(amrlev, levelbcdata);
+    m_level_bc_has_data[amrlev] = (levelbcdata != nullptr);
     m_needs_level_bcs[amrlev] = false;
 }
 
+void
+MacProjector::setSolverSetup (std::function<void(MLLinOp&, MLMG&)> a_setup)
+{
+    m_solver_setup = std::move(a_setup);
+    if (m_solver_setup && m_linop != nullptr && !m_needs_rebuild) {
+        m_solver_setup(*m_linop, *m_mlmg);
+    }
+}
+
 
 
 void
 MacProjector::project (Real reltol, Real atol)
 {
+    rebuildIfNeeded();
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_needs_beta,
+                                     "MacProjector::project: updateBeta must be called after updateGrids");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_needs_umac,
+                                     "MacProjector::project: setUMAC must be called after updateGrids");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_needs_crse_bc,
+                                     "MacProjector::project: setCoarseFineBC must be called after updateGrids");
+
     const int nlevs = m_rhs.size();
 
     for (int ilev = 0; ilev < nlevs; ++ilev) {
         if (m_needs_level_bcs[ilev]) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_level_bc_has_data[ilev],
+                                             "MacProjector::project: setLevelBC must be called after updateGrids");
             m_linop->setLevelBC(ilev, nullptr);
             m_needs_level_bcs[ilev] = false;
         }
@@ -230,6 +366,28 @@ MacProjector::project (Real reltol, Real atol)
     if ( m_umac[0][0] )
       averageDownVelocity();
 
+#ifdef AMREX_USE_EB
+    //
+    // With umac on face centers, the divergence in cut cells interpolates umac
+    // to the face centroids and therefore needs valid ghost faces. Start the
+    // halo exchanges for all levels and directions together, and compute the
+    // divergence in cells that only see valid faces while they are in flight.
+    //
+    const bool overlap_fillboundary = m_umac[0][0] && !m_eb_factory.empty()
+        && (m_umac_loc != MLMG::Location::FaceCentroid);
+
+    if (overlap_fillboundary)
+    {
+        for (int ilev = 0; ilev < nlevs; ++ilev) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_umac[ilev][idim]->nGrow() > 0,
+                                                 "MacProjector: with EB, umac must have at least one ghost cell if not already_on_centroid");
+                m_umac[ilev][idim]->FillBoundary_nowait(m_geom[ilev].periodicity());
+            }
+        }
+    }
+#endif
+
     for (int ilev = 0; ilev < nlevs; ++ilev)
     {
       if ( m_umac[0][0] )
@@ -239,19 +397,26 @@ MacProjector::project (Real reltol, Real atol)
             u[idim] = m_umac[ilev][idim];
         }
 #ifdef AMREX_USE_EB
-        if (m_umac_loc != MLMG::Location::FaceCentroid)
+        if (overlap_fillboundary)
         {
-            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-                AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_umac[ilev][idim]->nGrow() > 0,
-                                                 "MacProjector: with EB, umac must have at least one ghost cell if not already_on_centroid");
-                m_umac[ilev][idim]->FillBoundary(m_geom[ilev].periodicity());
-            }
+            computeDivergenceOverlapped(ilev);
         }
+        else
+        {
+            if (m_umac_loc != MLMG::Location::FaceCentroid)
+            {
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_umac[ilev][idim]->nGrow() > 0,
+                                                     "MacProjector: with EB, umac must have at least one ghost cell if not already_on_centroid");
+                    m_umac[ilev][idim]->FillBoundary(m_geom[ilev].periodicity());
+                }
+            }
 
-        if (m_eb_vel[ilev]) {
-           EB_computeDivergence(m_rhs[ilev], u, m_geom[ilev], (m_umac_loc == MLMG::Location::FaceCentroid), *m_eb_vel[ilev]);
-        } else {
-           EB_computeDivergence(m_rhs[ilev], u, m_geom[ilev], (m_umac_loc == MLMG::Location::FaceCentroid));
+            if (!m_eb_vel.empty() && m_eb_vel[ilev]) {
+               EB_computeDivergence(m_rhs[ilev], u, m_geom[ilev], (m_umac_loc == MLMG::Location::FaceCentroid), *m_eb_vel[ilev]);
+            } else {
+               EB_computeDivergence(m_rhs[ilev], u, m_geom[ilev], (m_umac_loc == MLMG::Location::FaceCentroid));
+            }
         }
 #else
         computeDivergence(m_rhs[ilev], u, m_geom[ilev]);
@@ -277,11 +442,20 @@ MacProjector::project (Real reltol, Real atol)
       m_phi[ilev].setVal(0.0);
     }
 
-    m_mlmg->solve(amrex::GetVecOfPtrs(m_phi), amrex::GetVecOfConstPtrs(m_rhs), reltol, atol);
+    if (m_use_defect_correction) {
+        solveWithDefectCorrection(reltol, atol);
+    } else {
+        m_mlmg->solve(amrex::GetVecOfPtrs(m_phi), amrex::GetVecOfConstPtrs(m_rhs), reltol, atol);
+    }
 
     if ( m_umac[0][0] )
     {
-      m_mlmg->getFluxes(amrex::GetVecOfArrOfPtrs(m_fluxes), m_umac_loc);
+      if (m_use_defect_correction) {
+          // MLMG did not see the final solution
+          m_mlmg->getFluxes(amrex::GetVecOfArrOfPtrs(m_fluxes), amrex::GetVecOfPtrs(m_phi), m_umac_loc);
+      } else {
+          m_mlmg->getFluxes(amrex::GetVecOfArrOfPtrs(m_fluxes), m_umac_loc);
+      }
 
       for (int ilev = 0; ilev < nlevs; ++ilev) {
         for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
@@ -301,6 +475,122 @@ MacProjector::project (Real reltol, Real atol)
 
 }
 
+#ifdef AMREX_USE_EB
+void
+MacProjector::computeDivergenceOverlapped (int ilev)
+{
+    BL_PROFILE("MacProjector::computeDivergenceOverlapped()");
+
+    auto const& ebfact = *m_eb_factory[ilev];
+    auto const& flags  = ebfact.getMultiEBCellFlagFab();
+    auto const& vfrac  = ebfact.getVolFrac();
+    auto const& area   = ebfact.getAreaFrac();
+    auto const& fcent  = ebfact.getFaceCent();
+
+    // The covered-cell mask only depends on the grids, so we build it once.
+    // Building it requires communication of its own.
+    if (m_cc_mask.size() < m_rhs.size()) {
+        m_cc_mask.resize(m_rhs.size());
+    }
+    if (!m_cc_mask[ilev].ok()) {
+        m_cc_mask[ilev].define(m_rhs[ilev].boxArray(), m_rhs[ilev].DistributionMap(), 1, 1);
+        m_cc_mask[ilev].BuildMask(m_geom[ilev].Domain(), m_geom[ilev].periodicity(), 1, 0, 0, 1);
+    }
+
+    const auto dxinv = m_geom[ilev].InvCellSizeArray();
+    const bool has_eb_vel = !m_eb_vel.empty() && m_eb_vel[ilev];
+    const bool already_on_centroids = false;
+
+    //
+    // The per-cell work is amrex::eb_compute_divergence, the kernel of
+    // amrex::EB_computeDivergence; only the order of the boxes differs.
+    // Pass 0 runs while the umac halo exchange is in flight and covers the
+    // regular tiles and the interior of the cut tiles, which only see valid
+    // faces. Pass 1 finishes the strips along the box boundary of the cut
+    // tiles once the ghost faces have arrived.
+    //
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        if (pass == 1) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                m_umac[ilev][idim]->FillBoundary_finish();
+            }
+        }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(m_rhs[ilev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            const FabType typ = flags[mfi].getType(bx);
+
+            if (typ == FabType::covered)
+            {
+                if (pass == 0) {
+                    m_rhs[ilev][mfi].setVal<RunOn::Device>(0.0, bx, 0, 1);
+                }
+                continue;
+            }
+
+            BoxList bl;
+            if (typ == FabType::regular)
+            {
+                if (pass == 0) { bl.push_back(bx); }
+            }
+            else
+            {
+                const Box interior = bx & amrex::grow(mfi.validbox(),-1);
+                if (pass == 0) {
+                    if (interior.ok()) { bl.push_back(interior); }
+                } else {
+                    if (interior.ok()) {
+                        bl = amrex::boxDiff(bx, interior);
+                    } else {
+                        bl.push_back(bx);
+                    }
+                }
+            }
+
+            auto const& div = m_rhs[ilev].array(mfi);
+            AMREX_D_TERM( Array4<Real const> const& u = m_umac[ilev][0]->const_array(mfi);,
+                          Array4<Real const> const& v = m_umac[ilev][1]->const_array(mfi);,
+                          Array4<Real const> const& w = m_umac[ilev][2]->const_array(mfi););
+            auto const& flag  = flags.const_array(mfi);
+            auto const& vfr   = vfrac.const_array(mfi);
+            auto const& ccm   = m_cc_mask[ilev].const_array(mfi);
+            AMREX_D_TERM( auto const& apx = area[0]->const_array(mfi);,
+                          auto const& apy = area[1]->const_array(mfi);,
+                          auto const& apz = area[2]->const_array(mfi););
+            AMREX_D_TERM( auto const& fcx = fcent[0]->const_array(mfi);,
+                          auto const& fcy = fcent[1]->const_array(mfi);,
+                          auto const& fcz = fcent[2]->const_array(mfi););
+
+            Array4<Real const> eb_vel, barea, bnorm;
+            if (has_eb_vel && typ != FabType::regular) {
+                eb_vel = m_eb_vel[ilev]->const_array(mfi);
+                barea  = ebfact.getBndryArea().const_array(mfi);
+                bnorm  = ebfact.getBndryNormal().const_array(mfi);
+            }
+
+            for (Box const& b : bl)
+            {
+                amrex::ParallelFor(b, [=]
+                AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    eb_compute_divergence(i,j,k,0,div,AMREX_D_DECL(u,v,w),ccm,flag,vfr,
+                                          AMREX_D_DECL(apx,apy,apz),AMREX_D_DECL(fcx,fcy,fcz),
+                                          dxinv,already_on_centroids);
+                    if (eb_vel) {
+                        eb_add_divergence_from_flow(i,j,k,0,div,eb_vel,flag,vfr,bnorm,barea,dxinv);
+                    }
+                });
+            }
+        }
+    }
+}
+#endif
+
 void
 MacProjector::project (const Vector<MultiFab*>& phi_inout, Real reltol, Real atol)
 {
@@ -316,10 +606,168 @@ MacProjector::project (const Vector<MultiFab*>& phi_inout, Real reltol, Real ato
     }
 }
 
+//
+// Build the single-precision operator for the corrections: same grids,
+// coefficients and BC types as the double-precision one, with homogeneous
+// BCs everywhere.
+//
+void
+MacProjector::buildCorrectionSolver ()
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_has_overset_mask,
+                                     "MacProjector: defect correction is not supported with an overset mask");
+#ifdef AMREX_USE_EB
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_eb_abeclap == nullptr,
+                                     "MacProjector: defect correction is not supported with EB");
+#endif
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_needs_domain_bcs,
+                                     "MacProjector: setDomainBC must be called before the projection");
+
+    const int nlevs = m_rhs.size();
+    Vector<BoxArray> ba(nlevs);
+    Vector<DistributionMapping> dm(nlevs);
+    for (int ilev = 0; ilev < nlevs; ++ilev) {
+        ba[ilev] = m_rhs[ilev].boxArray();
+        dm[ilev] = m_rhs[ilev].DistributionMap();
+    }
+
+    m_mlmg_f.reset();
+
+    MLLinOpT<FloatMultiFab>* linop_f = nullptr;
+    if (m_abeclap) {
+        m_abeclap_f = std::make_unique<MLABecLaplacianT<FloatMultiFab> >(m_geom, ba, dm, m_lpinfo);
+        m_abeclap_f->setScalars(0.0f, 1.0f);
+        for (int ilev = 0; ilev < nlevs; ++ilev) {
+            auto const& beta = m_abeclap->getBCoeffs(ilev, 0);
+            Array<FloatMultiFab,AMREX_SPACEDIM> beta_f;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                beta_f[idim].define(beta[idim]->boxArray(), beta[idim]->DistributionMap(), 1, 0);
+                convert_copy(beta_f[idim], *beta[idim]);
+            }
+            m_abeclap_f->setBCoeffs(ilev, amrex::GetArrOfConstPtrs(beta_f));
+        }
+        linop_f = m_abeclap_f.get();
+    } else {
+        m_poisson_f = std::make_unique<MLPoissonT<FloatMultiFab> >(m_geom, ba, dm, m_lpinfo);
+        linop_f = m_poisson_f.get();
+    }
+
+    linop_f->setDomainBC(m_lobc, m_hibc);
+    if (m_crse_bc) {
+        linop_f->setCoarseFineBC(nullptr, m_crse_ratio);
+    }
+    for (int ilev = 0; ilev < nlevs; ++ilev) {
+        linop_f->setLevelBC(ilev, nullptr);
+    }
+
+    m_mlmg_f = std::make_unique<MLMGT<FloatMultiFab> >(*linop_f);
+
+    int verbose = m_verbose;
+    set_solver_options(*linop_f, *m_mlmg_f, verbose);
+}
+
+//
+// Iterative refinement: the residual of the full problem, with its
+// inhomogeneous BCs, is computed by the double-precision operator; the
+// correction is solved in single precision to m_defect_correction_rtol and
+// added to phi. The passes stop on the same target MLMG would use for
+// (reltol, atol), so the result meets the double-precision tolerance.
+//
+void
+MacProjector::solveWithDefectCorrection (Real reltol, Real atol)
+{
+    BL_PROFILE("MacProjector::solveWithDefectCorrection()");
+
+    if (!m_mlmg_f) { buildCorrectionSolver(); }
+
+    const int nlevs = m_rhs.size();
+    Vector<MultiFab> res(nlevs);
+    Vector<FloatMultiFab> res_f(nlevs);
+    Vector<FloatMultiFab> cor_f(nlevs);
+    for (int ilev = 0; ilev < nlevs; ++ilev) {
+        res[ilev].define  (m_rhs[ilev].boxArray(), m_rhs[ilev].DistributionMap(), 1, 0);
+        res_f[ilev].define(m_rhs[ilev].boxArray(), m_rhs[ilev].DistributionMap(), 1, 0);
+        cor_f[ilev].define(m_rhs[ilev].boxArray(), m_rhs[ilev].DistributionMap(), 1, 1);
+    }
+
+    // MLMG solves a singular problem for the rhs without its mean, and so
+    // does the single-precision solve, so the mean is left out of the residual
+    const bool singular = m_linop->isSingular(0) && m_linop->getEnforceSingularSolvable();
+
+    auto residual_norm = [&] ()
+    {
+        m_mlmg->compResidual(amrex::GetVecOfPtrs(res), amrex::GetVecOfPtrs(m_phi),
+                             amrex::GetVecOfConstPtrs(m_rhs));
+        if (singular) {
+            res[0].plus(-res[0].sum(0) / Real(m_geom[0].Domain().d_numPts()), 0, 1);
+        }
+        Real norm = 0.0;
+        for (int ilev = 0; ilev < nlevs; ++ilev) {
+            norm = std::max(norm, res[ilev].norminf(0, 0, true));
+        }
+        ParallelAllReduce::Max(norm, ParallelContext::CommunicatorSub());
+        return norm;
+    };
+
+    Real rhsnorm = 0.0;
+    for (int ilev = 0; ilev < nlevs; ++ilev) {
+        rhsnorm = std::max(rhsnorm, m_rhs[ilev].norminf(0, 0, true));
+    }
+    ParallelAllReduce::Max(rhsnorm, ParallelContext::CommunicatorSub());
+
+    Real resnorm = residual_norm();
+    const Real target = std::max(atol, reltol*std::max(rhsnorm, resnorm));
+
+    // Single precision cannot resolve a much smaller reduction per pass
+    const float rtol_f = static_cast<float>(std::max(m_defect_correction_rtol, Real(1.e-5)));
+
+    int iter = 0;
+    while (resnorm > target)
+    {
+        if (iter == m_defect_correction_maxiter) {
+            amrex::Abort("MacProjector: defect correction failed to converge");
+        }
+
+        for (int ilev = 0; ilev < nlevs; ++ilev) {
+            convert_copy(res_f[ilev], res[ilev]);
+            cor_f[ilev].setVal(0.0f);
+        }
+
+        m_mlmg_f->solve(amrex::GetVecOfPtrs(cor_f), amrex::GetVecOfConstPtrs(res_f), rtol_f, 0.0f);
+
+        for (int ilev = 0; ilev < nlevs; ++ilev) {
+            auto const& phi = m_phi[ilev].arrays();
+            auto const& cor = cor_f[ilev].const_arrays();
+            amrex::ParallelFor(m_phi[ilev], [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+            {
+                phi[box_no](i,j,k) += static_cast<Real>(cor[box_no](i,j,k));
+            });
+        }
+        Gpu::streamSynchronize();
+
+        resnorm = residual_norm();
+        ++iter;
+
+        if (m_verbose > 1) {
+            amrex::Print() << "MacProjector: defect correction pass " << iter
+                           << ", residual " << resnorm << std::endl;
+        }
+    }
+
+    if (m_verbose > 0) {
+        amrex::Print() << "MacProjector: defect correction took " << iter
+                       << " passes, final residual " << resnorm
+                       << " (target " << target << ")" << std::endl;
+    }
+}
+
 void
 MacProjector::getFluxes (const Vector<Array<MultiFab*,AMREX_SPACEDIM> >& a_flux,
                          const Vector<MultiFab*>& a_sol, MLMG::Location a_loc) const
 {
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_needs_rebuild,
+                                     "MacProjector::getFluxes: no projection since the last updateGrids");
+
     int ilev = 0;
     if (m_needs_level_bcs[ilev])
         m_linop->setLevelBC(ilev, nullptr);
@@ -340,72 +788,163 @@ MacProjector::getFluxes (const Vector<Array<MultiFab*,AMREX_SPACEDIM> >& a_flux,
 void
 MacProjector::setOptions ()
 {
-    // Default values
-    int          maxorder(3);
-    int          bottom_verbose(0);
-    int          maxiter(200);
-    int          bottom_maxiter(200);
-    Real         bottom_rtol(1.0e-4_rt);
-    Real         bottom_atol(-1.0_rt);
-    std::string  bottom_solver("bicg");
+    set_solver_options(*m_linop, *m_mlmg, m_verbose);
 
-    int num_pre_smooth(2);
-    int num_post_smooth(2);
-
-    // Read from input file
     ParmParse pp("mac_proj");
-    pp.query( "verbose"       , m_verbose );
-    pp.query( "maxorder"      , maxorder );
-    pp.query( "bottom_verbose", bottom_verbose );
-    pp.query( "maxiter"       , maxiter );
-    pp.query( "bottom_maxiter", bottom_maxiter );
-    pp.query( "bottom_rtol"   , bottom_rtol );
-    pp.query( "bottom_atol"   , bottom_atol );
-    pp.query( "bottom_solver" , bottom_solver );
-
-    pp.query( "num_pre_smooth"  , num_pre_smooth );
-    pp.query( "num_post_smooth" , num_post_smooth );
+    pp.query( "defect_correction"        , m_use_defect_correction );
+    pp.query( "defect_correction_rtol"   , m_defect_correction_rtol );
+    pp.query( "defect_correction_maxiter", m_defect_correction_maxiter );
+}
 
-    // Set default/input values
-    m_linop->setMaxOrder(maxorder);
-    m_mlmg->setVerbose(m_verbose);
-    m_mlmg->setBottomVerbose(bottom_verbose);
-    m_mlmg->setMaxIter(maxiter);
-    m_mlmg->setBottomMaxIter(bottom_maxiter);
-    m_mlmg->setBottomTolerance(bottom_rtol);
-    m_mlmg->setBottomToleranceAbs(bottom_atol);
+void
+MacProjector::updateGrids (int a_lev, const Geometry& a_geom,
+                           const BoxArray& a_ba, const DistributionMapping& a_dm,
+                           FabFactory<FArrayBox> const* a_factory)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_linop != nullptr,
+        "MacProjector::updateGrids: initProjector must be called before calling this method");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a_lev >= 0 && a_lev <= m_rhs.size(),
+                                     "MacProjector::updateGrids: level out of range");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!m_has_overset_mask,
+                                     "MacProjector::updateGrids: not supported with an overset mask");
 
-    m_mlmg->setPreSmooth(num_pre_smooth);
-    m_mlmg->setPostSmooth(num_post_smooth);
+    const BoxArray ba = amrex::convert(a_ba, IntVect::TheZeroVector());
 
-    if (bottom_solver == "smoother")
-    {
-        m_mlmg->setBottomSolver(MLMG::BottomSolver::smoother);
-    }
-    else if (bottom_solver == "bicg")
+    if (a_lev == m_rhs.size())
     {
-        m_mlmg->setBottomSolver(MLMG::BottomSolver::bicgstab);
+        // New finest level
+        const int nlevs = a_lev + 1;
+        m_rhs.resize(nlevs);
+        m_phi.resize(nlevs);
+        m_fluxes.resize(nlevs);
+        m_divu.resize(nlevs);
+        m_needs_level_bcs.resize(nlevs, true);
+        m_level_bc_has_data.resize(nlevs, false);
+        m_geom.resize(nlevs);
+#ifdef AMREX_USE_EB
+        if (!m_eb_factory.empty()) {
+            m_eb_factory.resize(nlevs, nullptr);
+            m_eb_vel.resize(nlevs);
+        }
+#endif
     }
-    else if (bottom_solver == "cg")
-    {
-        m_mlmg->setBottomSolver(MLMG::BottomSolver::cg);
+    // The grids at coarser levels are untouched, and so is their data
+    else if (ba == m_rhs[a_lev].boxArray() && a_dm == m_rhs[a_lev].DistributionMap()) {
+        return;
     }
-    else if (bottom_solver == "bicgcg")
+
+    m_geom[a_lev] = a_geom;
+    m_divu[a_lev].clear();
+
+    // umac lives on the old grids
+    m_umac.clear();
+    m_needs_umac = true;
+
+#ifdef AMREX_USE_EB
+    if (!m_eb_factory.empty()) {
+        m_eb_factory[a_lev] = dynamic_cast<EBFArrayBoxFactory const*>(a_factory);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_eb_factory[a_lev] != nullptr,
+                                         "MacProjector::updateGrids: EBFArrayBoxFactory required with EB");
+
+        m_eb_vel[a_lev].reset();
+        if (a_lev < m_cc_mask.size()) {
+            m_cc_mask[a_lev].clear();
+        }
+
+        m_rhs[a_lev].define(ba, a_dm, 1, 0, MFInfo(), *a_factory);
+        m_phi[a_lev].define(ba, a_dm, 1, 1, MFInfo(), *a_factory);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_fluxes[a_lev][idim].define(
+                amrex::convert(ba, IntVect::TheDimensionVector(idim)),
+                a_dm, 1, 0, MFInfo(), *a_factory);
+        }
+    } else
+#endif
     {
-        m_mlmg->setBottomSolver(MLMG::BottomSolver::bicgcg);
+        amrex::ignore_unused(a_factory);
+
+        m_rhs[a_lev].define(ba, a_dm, 1, 0);
+        m_phi[a_lev].define(ba, a_dm, 1, 1);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_fluxes[a_lev][idim].define(
+                amrex::convert(ba, IntVect::TheDimensionVector(idim)),
+                a_dm, 1, 0);
+        }
     }
-    else if (bottom_solver == "cgbicg")
-    {
-        m_mlmg->setBottomSolver(MLMG::BottomSolver::cgbicg);
+
+    m_rhs[a_lev].setVal(0.0);
+    m_phi[a_lev].setVal(0.0);
+
+    m_needs_rebuild = true;
+}
+
+//
+// Rebuild the linear operator and MLMG on the current grids if updateGrids
+// has been called. AMReX's operators set up all levels at once and cannot be
+// redistributed, so this cannot be restricted to the levels that changed.
+//
+void
+MacProjector::rebuildIfNeeded ()
+{
+    if (!m_needs_rebuild) return;
+
+    BL_PROFILE("MacProjector::rebuildIfNeeded()");
+
+    const int nlevs = m_rhs.size();
+    Vector<BoxArray> ba(nlevs);
+    Vector<DistributionMapping> dm(nlevs);
+    for (int ilev = 0; ilev < nlevs; ++ilev) {
+        ba[ilev] = m_rhs[ilev].boxArray();
+        dm[ilev] = m_rhs[ilev].DistributionMap();
     }
-    else if (bottom_solver == "hypre")
-    {
-#ifdef AMREX_USE_HYPRE
-        m_mlmg->setBottomSolver(MLMG::BottomSolver::hypre);
-#else
-        amrex::Abort("AMReX was not built with HYPRE support");
+
+    // MLMG holds a reference to the operator
+    m_mlmg.reset();
+    m_mlmg_f.reset();
+
+#ifdef AMREX_USE_EB
+    if (m_eb_abeclap) {
+        m_eb_abeclap = std::make_unique<MLEBABecLap>(m_geom, ba, dm, m_lpinfo, m_eb_factory);
+        m_linop = m_eb_abeclap.get();
+
+        if (m_phi_loc == MLMG::Location::CellCentroid)
+            m_eb_abeclap->setPhiOnCentroid();
+
+        m_eb_abeclap->setScalars(0.0, 1.0);
+        m_needs_beta = true;
+    } else
 #endif
+    if (m_abeclap) {
+        m_abeclap = std::make_unique<MLABecLaplacian>(m_geom, ba, dm, m_lpinfo);
+        m_linop = m_abeclap.get();
+
+        m_abeclap->setScalars(0.0, 1.0);
+        m_needs_beta = true;
+    } else {
+        m_poisson = std::make_unique<MLPoisson>(m_geom, ba, dm, m_lpinfo);
+        m_linop = m_poisson.get();
     }
+
+    m_mlmg = std::make_unique<MLMG>(*m_linop);
+
+    setOptions();
+    if (m_solver_setup) { m_solver_setup(*m_linop, *m_mlmg); }
+
+    // The domain BCs are set again on the new operator. The level and
+    // coarse/fine BC data belong to the caller and may not outlive the regrid,
+    // so they are not reapplied: project asserts that they are set again.
+    if (!m_needs_domain_bcs) {
+        m_linop->setDomainBC(m_lobc, m_hibc);
+    }
+    if (m_crse_bc) {
+        m_needs_crse_bc = true;
+    }
+    for (int ilev = 0; ilev < nlevs; ++ilev) {
+        m_needs_level_bcs[ilev] = true;
+    }
+
+    m_needs_rebuild = false;
 }
 
 void
@@ -419,15 +958,34 @@ MacProjector::averageDownVelocity ()
 
         IntVect rr  = m_geom[lev].Domain().size() / m_geom[lev-1].Domain().size();
 
+        //
+        // Average down onto the coarsened fine grids first, which is purely
+        // local work, then start the copies to the coarse grids for all
+        // directions together and wait for them at once.
+        //
+        Array<MultiFab,AMREX_SPACEDIM> ctmp;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            BoxArray cba = m_umac[lev][idim]->boxArray();
+            cba.coarsen(rr);
+            ctmp[idim].define(cba, m_umac[lev][idim]->DistributionMap(),
+                              m_umac[lev-1][idim]->nComp(), 0);
+        }
+
 #ifdef AMREX_USE_EB
         EB_average_down_faces(GetArrOfConstPtrs(m_umac[lev]),
-                              m_umac[lev-1],
-                              rr, m_geom[lev-1]);
+                              GetArrOfPtrs(ctmp), rr, 0);
 #else
         average_down_faces(GetArrOfConstPtrs(m_umac[lev]),
-                           m_umac[lev-1],
-                           rr, m_geom[lev-1]);
+                           GetArrOfPtrs(ctmp), rr, 0);
 #endif
+
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_umac[lev-1][idim]->ParallelCopy_nowait(ctmp[idim], 0, 0, ctmp[idim].nComp(),
+                                                     0, 0, m_geom[lev-1].periodicity());
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_umac[lev-1][idim]->ParallelCopy_finish();
+        }
     }
 }
 
@@ -438,6 +996,8 @@ void MacProjector::initProjector (Vector<BoxArray> const& a_grids,
                                   const Vector<iMultiFab const*>& a_overset_mask)
 {
     m_const_beta = a_const_beta;
+    m_lpinfo = a_lpinfo;
+    m_has_overset_mask = !a_overset_mask.empty();
 
     const int nlevs = a_grids.size();
     Vector<BoxArray> ba(nlevs);
@@ -450,6 +1010,8 @@ void MacProjector::initProjector (Vector<BoxArray> const& a_grids,
     m_phi.resize(nlevs);
     m_fluxes.resize(nlevs);
     m_divu.resize(nlevs);
+    m_needs_level_bcs.resize(nlevs, true);
+    m_level_bc_has_data.resize(nlevs, false);
 
     for (int ilev = 0; ilev < nlevs; ++ilev) {
         m_rhs[ilev].define(ba[ilev], dm[ilev], 1, 0);
@@ -474,6 +1036,7 @@ void MacProjector::initProjector (Vector<BoxArray> const& a_grids,
     m_mlmg = std::make_unique<MLMG>(*m_linop);
 
     setOptions();
+    if (m_solver_setup) { m_solver_setup(*m_linop, *m_mlmg); }
 
     m_needs_init = false;
 }
@@ -48,80 +48,113 @@ void NodalProjector::define (LPInfo const& a_lpinfo)
 {
     int nlevs = m_vel.size();
 
-    Vector<BoxArray> ba(nlevs);
-    Vector<DistributionMapping> dm(nlevs);
-    for (int lev = 0; lev < nlevs; ++lev)
-    {
-        ba[lev] = m_vel[lev]->boxArray();
-        dm[lev] = m_vel[lev]->DistributionMap();
-    }
+    m_lpinfo = a_lpinfo;
 
     // Resize member data
     m_phi.resize(nlevs);
     m_fluxes.resize(nlevs);
     m_rhs.resize(nlevs);
 
-
 #ifdef AMREX_USE_EB
     bool has_eb = m_vel[0] -> hasEBFabFactory();
     if (has_eb)
     {
         m_ebfactory.resize(nlevs,nullptr);
-        for (int lev = 0; lev < nlevs; ++lev )
-        {
-            m_ebfactory[lev] = dynamic_cast<EBFArrayBoxFactory const*>(&(m_vel[lev]->Factory()));
+        m_volume.resize(nlevs);
+    }
+#endif
+
+    for (int lev = 0; lev < nlevs; ++lev)
+    {
+        defineLevelData(lev);
+    }
+
+    buildOperator();
+}
+
+
+//
+// Define and initialize the data of level a_lev on the grids of m_vel[a_lev]
+//
+void NodalProjector::defineLevelData (int a_lev)
+{
+    const BoxArray&            ba = m_vel[a_lev]->boxArray();
+    const DistributionMapping& dm = m_vel[a_lev]->DistributionMap();
 
-            // Cell-centered data
-            m_fluxes[lev].define(ba[lev], dm[lev], AMREX_SPACEDIM, 0, MFInfo(), m_vel[lev]->Factory());
+    BoxArray tmp = ba;
+    const auto& ba_nd = tmp.surroundingNodes();
 
-            // Node-centered data
-            auto tmp = ba[lev];
-            const auto& ba_nd = tmp.surroundingNodes();
-            m_phi[lev].define(ba_nd, dm[lev], 1, 1, MFInfo(), m_vel[lev]->Factory());
-            m_rhs[lev].define(ba_nd, dm[lev], 1, 0, MFInfo(), m_vel[lev]->Factory());
+#ifdef AMREX_USE_EB
+    if (!m_ebfactory.empty())
+    {
+        m_ebfactory[a_lev] = dynamic_cast<EBFArrayBoxFactory const*>(&(m_vel[a_lev]->Factory()));
+
+        // Volumes of the fine cells are needed every time a_lev is averaged down
+        if (a_lev > 0)
+        {
+            m_volume[a_lev].define(ba, dm, 1, 0);
+            m_geom[a_lev].GetVolume(m_volume[a_lev]);
         }
+
+        // Cell-centered data
+        m_fluxes[a_lev].define(ba, dm, AMREX_SPACEDIM, 0, MFInfo(), m_vel[a_lev]->Factory());
+
+        // Node-centered data
+        m_phi[a_lev].define(ba_nd, dm, 1, 1, MFInfo(), m_vel[a_lev]->Factory());
+        m_rhs[a_lev].define(ba_nd, dm, 1, 0, MFInfo(), m_vel[a_lev]->Factory());
     }
     else
 #endif
     {
-        for (int lev = 0; lev < nlevs; ++lev )
-        {
-            // Cell-centered data
-            m_fluxes[lev].define(ba[lev], dm[lev], AMREX_SPACEDIM, 0);
-
-            // Node-centered data
-            BoxArray tmp = ba[lev];
-            const auto& ba_nd = tmp.surroundingNodes();
-            m_phi[lev].define(ba_nd, dm[lev], 1, 1);
-            m_rhs[lev].define(ba_nd, dm[lev], 1, 0);
-        }
+        // Cell-centered data
+        m_fluxes[a_lev].define(ba, dm, AMREX_SPACEDIM, 0);
+
+        // Node-centered data
+        m_phi[a_lev].define(ba_nd, dm, 1, 1);
+        m_rhs[a_lev].define(ba_nd, dm, 1, 0);
     }
 
-    // Initialize all variables
-    for (int lev(0); lev < m_phi.size(); ++lev)
+    m_phi[a_lev].setVal(0.0);
+    m_fluxes[a_lev].setVal(0.0);
+    m_rhs[a_lev].setVal(0.0);
+}
+
+
+//
+// Build the linear operator and the solver on the grids of m_vel
+//
+void NodalProjector::buildOperator ()
+{
+    int nlevs = m_vel.size();
+
+    Vector<BoxArray> ba(nlevs);
+    Vector<DistributionMapping> dm(nlevs);
+    for (int lev = 0; lev < nlevs; ++lev)
     {
-        m_phi[lev].setVal(0.0);
-        m_fluxes[lev].setVal(0.0);
-        m_rhs[lev].setVal(0.0);
+        ba[lev] = m_vel[lev]->boxArray();
+        dm[lev] = m_vel[lev]->DistributionMap();
     }
 
+    // MLMG holds a reference to the operator
+    m_mlmg.reset();
+
     //
     // Setup linear operator
     //
     if (m_sigma.empty()) {
 #ifdef AMREX_USE_EB
-        m_linop = std::make_unique<MLNodeLaplacian>(m_geom, ba, dm, a_lpinfo, m_ebfactory,
+        m_linop = std::make_unique<MLNodeLaplacian>(m_geom, ba, dm, m_lpinfo, m_ebfactory,
                                                     m_const_sigma);
 #else
-        m_linop = std::make_unique<MLNodeLaplacian>(m_geom, ba, dm, a_lpinfo,
+        m_linop = std::make_unique<MLNodeLaplacian>(m_geom, ba, dm, m_lpinfo,
                                                     Vector<FabFactory<FArrayBox> const*>{},
                                                     m_const_sigma);
 #endif
     } else {
 #ifdef AMREX_USE_EB
-        m_linop = std::make_unique<MLNodeLaplacian>(m_geom, ba, dm, a_lpinfo, m_ebfactory);
+        m_linop = std::make_unique<MLNodeLaplacian>(m_geom, ba, dm, m_lpinfo, m_ebfactory);
 #else
-        m_linop = std::make_unique<MLNodeLaplacian>(m_geom, ba, dm, a_lpinfo);
+        m_linop = std::make_unique<MLNodeLaplacian>(m_geom, ba, dm, m_lpinfo);
 #endif
     }
 
@@ -134,6 +167,111 @@ void NodalProjector::define (LPInfo const& a_lpinfo)
     m_mlmg = std::make_unique<MLMG>(*m_linop);
 
     setOptions();
+    if (m_solver_setup) { m_solver_setup(*m_linop, *m_mlmg); }
+}
+
+
+void
+NodalProjector::setSolverSetup (std::function<void(MLNodeLaplacian&, MLMG&)> a_setup)
+{
+    m_solver_setup = std::move(a_setup);
+    if (m_solver_setup && m_linop && !m_needs_rebuild) {
+        m_solver_setup(*m_linop, *m_mlmg);
+    }
+}
+
+
+void
+NodalProjector::updateGrids ( int a_lev,
+                              const Geometry& a_geom,
+                              MultiFab*       a_vel,
+                              const MultiFab* a_sigma,
+                              MultiFab*       a_S_cc,
+                              const MultiFab* a_S_nd )
+{
+    BL_PROFILE("NodalProjector::updateGrids");
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a_lev >= 0 && a_lev <= m_vel.size(),
+                                     "NodalProjector::updateGrids: level out of range");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a_vel != nullptr && a_vel->ixType().cellCentered(),
+                                     "NodalProjector::updateGrids: a_vel is not cell centered");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_sigma.empty() || a_sigma != nullptr,
+                                     "NodalProjector::updateGrids: sigma is required");
+
+    // grad(phi) on the levels that are kept must come from the operator it was solved with
+    computeGradPhi();
+
+    bool same_grids = false;
+    if (a_lev == m_vel.size())
+    {
+        // New finest level
+        const int nlevs = a_lev + 1;
+        m_geom.resize(nlevs);
+        m_vel.resize(nlevs);
+        m_phi.resize(nlevs);
+        m_fluxes.resize(nlevs);
+        m_rhs.resize(nlevs);
+        if (!m_sigma.empty()) { m_sigma.resize(nlevs); }
+        if (!m_S_cc.empty())  { m_S_cc.resize(nlevs);  }
+        if (!m_S_nd.empty())  { m_S_nd.resize(nlevs);  }
+#ifdef AMREX_USE_EB
+        if (!m_ebfactory.empty()) {
+            m_ebfactory.resize(nlevs, nullptr);
+            m_volume.resize(nlevs);
+        }
+#endif
+    }
+    else
+    {
+        // m_fluxes still lives on the old grids of a_lev
+        same_grids = a_vel->boxArray()       == m_fluxes[a_lev].boxArray()
+            &&       a_vel->DistributionMap() == m_fluxes[a_lev].DistributionMap();
+#ifdef AMREX_USE_EB
+        if (!m_ebfactory.empty()) {
+            same_grids = same_grids && (&(a_vel->Factory()) == m_ebfactory[a_lev]);
+        }
+#endif
+    }
+
+    m_geom[a_lev] = a_geom;
+    m_vel[a_lev] = a_vel;
+    if (!m_sigma.empty()) { m_sigma[a_lev] = a_sigma; }
+    if (!m_S_cc.empty())  { m_S_cc[a_lev]  = a_S_cc;  }
+    if (!m_S_nd.empty())  { m_S_nd[a_lev]  = a_S_nd;  }
+
+    if (same_grids) return;
+
+    // These refer to the old grids
+    m_alpha.clear();
+    m_has_alpha = false;
+    m_has_rhs   = false;
+
+    defineLevelData(a_lev);
+
+    m_needs_rebuild = true;
+}
+
+
+//
+// Rebuild the linear operator and MLMG if updateGrids has been called.
+// AMReX's operators set up all levels at once and cannot be redistributed,
+// so this cannot be restricted to the levels that changed. The options and
+// the solver setup are applied by buildOperator.
+//
+void
+NodalProjector::rebuildIfNeeded ()
+{
+    if (!m_needs_rebuild) return;
+
+    BL_PROFILE("NodalProjector::rebuildIfNeeded");
+
+    buildOperator();
+
+    if (!m_need_bcs) {
+        m_linop->setDomainBC(m_bc_lo,m_bc_hi);
+    }
+
+    m_needs_rebuild = false;
 }
 
 
@@ -219,6 +357,7 @@ void
 NodalProjector::setDomainBC ( std::array<LinOpBCType,AMREX_SPACEDIM> a_bc_lo,
                               std::array<LinOpBCType,AMREX_SPACEDIM> a_bc_hi )
 {
+    rebuildIfNeeded();
     m_bc_lo=a_bc_lo;
     m_bc_hi=a_bc_hi;
     m_linop->setDomainBC(m_bc_lo,m_bc_hi);
@@ -245,6 +384,8 @@ NodalProjector::project ( Real a_rtol, Real a_atol )
     BL_PROFILE("NodalProjector::project");
     AMREX_ALWAYS_ASSERT(!m_need_bcs);
 
+    rebuildIfNeeded();
+
     if (m_verbose > 0)
         amrex::Print() << "Nodal Projection:" << std::endl;
 
@@ -288,33 +429,59 @@ NodalProjector::project ( Real a_rtol, Real a_atol )
     // Compute sync residual BEFORE performing projection
     computeSyncResidual();
 
-    // Perform projection
+    //
+    // Perform projection in a single pass over the cell data
+    //
+    //   vel = vel + fluxes/alpha = vel - ( sigma / alpha ) * grad(phi)
+    //
+    // grad(phi) itself is only computed if the caller asks for it.
+    //
     for (int lev(0); lev < m_phi.size(); ++lev)
     {
-        if (m_has_alpha)
+        const bool has_alpha = m_has_alpha;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(*m_vel[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
-            // fluxes -> fluxes/alpha = - ( sigma / alpha ) * grad(phi)
-            for (int n = 0; n < AMREX_SPACEDIM; ++n)
+            const Box& bx = mfi.tilebox();
+            Array4<Real      > const& vel  = m_vel[lev]->array(mfi);
+            Array4<Real const> const& flux = m_fluxes[lev].const_array(mfi);
+            Array4<Real const> const& alpha = has_alpha ? m_alpha[lev]->const_array(mfi)
+                                                        : Array4<Real const>{};
+
+            amrex::ParallelFor(bx, AMREX_SPACEDIM, [=]
+            AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
             {
-                MultiFab::Divide( m_fluxes[lev], *m_alpha[lev], 0, n, 1, 0 );
-            }
+                if (has_alpha) {
+                    vel(i,j,k,n) += flux(i,j,k,n) / alpha(i,j,k);
+                } else {
+                    vel(i,j,k,n) += flux(i,j,k,n);
+                }
+            });
         }
-
-        //
-        // vel = vel + fluxes = vel - ( sigma / alpha ) * grad(phi)
-        //
-        MultiFab::Add( *m_vel[lev], m_fluxes[lev], 0, 0, AMREX_SPACEDIM, 0);
-
-        // set m_fluxes = grad(phi)
-        m_linop->compGrad(lev,m_fluxes[lev],m_phi[lev]);
     }
 
     //
     // At this time, results are "correct" only on regions not covered by finer grids.
     // We average them down so that they are "correct" everywhere in each level.
     //
-    averageDown(GetVecOfPtrs(m_fluxes));
-    averageDown(m_vel);
+    if (m_eager_grad_phi)
+    {
+        for (int lev(0); lev < m_phi.size(); ++lev)
+        {
+            m_linop->compGrad(lev, m_fluxes[lev], m_phi[lev]);
+        }
+
+        averageDownVelocityAndGradPhi();
+        m_grad_phi_is_current = true;
+    }
+    else
+    {
+        averageDown(m_vel);
+        m_grad_phi_is_current = false;
+    }
 
 
     // Print diagnostics
@@ -364,6 +531,8 @@ NodalProjector::computeRHS (  const amrex::Vector<amrex::MultiFab*>&       a_rhs
 
     BL_PROFILE("NodalProjector::computeRHS");
 
+    rebuildIfNeeded();
+
     bool has_S_cc(!a_S_cc.empty());
     bool has_S_nd(!a_S_nd.empty());
 
@@ -493,8 +662,29 @@ NodalProjector::setCoarseBoundaryVelocityForSync ()
 }
 
 
+//
+// Compute grad(phi) from the latest solution, if not done already
+//
 void
-NodalProjector::averageDown (const amrex::Vector<amrex::MultiFab*> a_var)
+NodalProjector::computeGradPhi () const
+{
+    if (m_grad_phi_is_current) return;
+
+    BL_PROFILE("NodalProjector::computeGradPhi");
+
+    for (int lev(0); lev < m_phi.size(); ++lev)
+    {
+        m_linop->compGrad(lev, m_fluxes[lev], m_phi[lev]);
+    }
+
+    averageDown(GetVecOfPtrs(m_fluxes));
+
+    m_grad_phi_is_current = true;
+}
+
+
+void
+NodalProjector::averageDown (const amrex::Vector<amrex::MultiFab*> a_var) const
 {
 
     int f_lev = a_var.size()-1;
@@ -505,21 +695,125 @@ NodalProjector::averageDown (const amrex::Vector<amrex::MultiFab*> a_var)
         IntVect rr   = m_geom[lev+1].Domain().size() / m_geom[lev].Domain().size();
 
 #ifdef AMREX_USE_EB
-        const auto ebf = dynamic_cast<EBFArrayBoxFactory const&>(a_var[lev+1]->Factory());
+        if (!m_ebfactory.empty())
+        {
+            EB_average_down(*a_var[lev+1], *a_var[lev], m_volume[lev+1],
+                            m_ebfactory[lev+1]->getVolFrac(),
+                            0, a_var[lev]->nComp(), rr);
+            continue;
+        }
+#endif
+        average_down(*a_var[lev+1], *a_var[lev], m_geom[lev+1], m_geom[lev],
+                     0, a_var[lev]->nComp(), rr);
+    }
+
 
-        amrex::MultiFab volume(a_var[lev+1]->boxArray(),a_var[lev+1]->DistributionMap(),1,0);
-        m_geom[lev+1].GetVolume(volume);
+}
 
-        EB_average_down(*a_var[lev+1], *a_var[lev], volume, ebf.getVolFrac(),
-                        0, a_var[lev]->nComp(), rr);
+
+//
+// Average down velocity and grad(phi) with a single pass over the fine data:
+// both are averaged into one coarsened temporary, which is then copied to the
+// coarse level with overlapping parallel copies.
+//
+void
+NodalProjector::averageDownVelocityAndGradPhi ()
+{
+    BL_PROFILE("NodalProjector::averageDownVelocityAndGradPhi");
+
+    constexpr int ncomp = 2*AMREX_SPACEDIM;
+
+#ifdef AMREX_USE_EB
+    const bool has_eb = !m_ebfactory.empty();
 #else
-        average_down(*a_var[lev+1], *a_var[lev], m_geom[lev+1], m_geom[lev],
-                     0, a_var[lev]->nComp(), rr);
+    const bool has_eb = false;
 #endif
 
-    }
+    for (int lev = m_phi.size()-2; lev >= 0; --lev)
+    {
+        IntVect rr   = m_geom[lev+1].Domain().size() / m_geom[lev].Domain().size();
+
+        const MultiFab& vel_fine     = *m_vel[lev+1];
+        const MultiFab& gradphi_fine = m_fluxes[lev+1];
+
+        // Without EB the volume weights are only needed in curvilinear coordinates
+        if (!has_eb && !m_geom[lev+1].IsCartesian())
+        {
+            average_down(vel_fine, *m_vel[lev], m_geom[lev+1], m_geom[lev],
+                         0, AMREX_SPACEDIM, rr);
+            average_down(gradphi_fine, m_fluxes[lev], m_geom[lev+1], m_geom[lev],
+                         0, AMREX_SPACEDIM, rr);
+            continue;
+        }
+
+        Dim3 ratio{1,1,1};
+        AMREX_D_TERM(ratio.x = rr[0];,
+                     ratio.y = rr[1];,
+                     ratio.z = rr[2];);
 
+        MultiFab ctmp(amrex::coarsen(vel_fine.boxArray(), rr), vel_fine.DistributionMap(), ncomp, 0);
 
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(ctmp,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real      > const& crse    = ctmp.array(mfi);
+            Array4<Real const> const& vel     = vel_fine.const_array(mfi);
+            Array4<Real const> const& gradphi = gradphi_fine.const_array(mfi);
+
+            // Unit weights unless EB
+            Array4<Real const> vol;
+            Array4<Real const> vfrac;
+#ifdef AMREX_USE_EB
+            if (has_eb)
+            {
+                vol   = m_volume[lev+1].const_array(mfi);
+                vfrac = m_ebfactory[lev+1]->getVolFrac().const_array(mfi);
+            }
+#endif
+
+            amrex::ParallelFor(bx, [=]
+            AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                Real sum[ncomp] = {};
+                Real wtot = 0.0;
+
+                for (int kk = k*ratio.z; kk < (k+1)*ratio.z; ++kk) {
+                for (int jj = j*ratio.y; jj < (j+1)*ratio.y; ++jj) {
+                for (int ii = i*ratio.x; ii < (i+1)*ratio.x; ++ii) {
+                    Real w = vol ? vol(ii,jj,kk) : Real(1.0);
+                    if (vfrac) w *= vfrac(ii,jj,kk);
+                    wtot += w;
+                    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                        sum[n]                += w * vel(ii,jj,kk,n);
+                        sum[n+AMREX_SPACEDIM] += w * gradphi(ii,jj,kk,n);
+                    }
+                }}}
+
+                if (wtot > Real(1.e-30)) {
+                    for (int n = 0; n < ncomp; ++n) {
+                        crse(i,j,k,n) = sum[n] / wtot;
+                    }
+                } else {
+                    // Fully covered coarse cell: same fallback as EB_average_down
+                    const int ii = i*ratio.x;
+                    const int jj = j*ratio.y;
+                    const int kk = k*ratio.z;
+                    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                        crse(i,j,k,n)                = vel(ii,jj,kk,n);
+                        crse(i,j,k,n+AMREX_SPACEDIM) = gradphi(ii,jj,kk,n);
+                    }
+                }
+            });
+        }
+
+        m_vel[lev]->ParallelCopy_nowait(ctmp, 0,              0, AMREX_SPACEDIM);
+        m_fluxes[lev].ParallelCopy_nowait(ctmp, AMREX_SPACEDIM, 0, AMREX_SPACEDIM);
+        m_vel[lev]->ParallelCopy_finish();
+        m_fluxes[lev].ParallelCopy_finish();
+    }
 }
 
 
@@ -26,14 +26,42 @@ void Redistribution::Apply ( Box const& bx, int ncomp,
                              Array4<Real const> const& ccc,
                              amrex::BCRec  const* d_bcrec_ptr,
                              Geometry const& lev_geom, Real dt,
-                             std::string redistribution_type,
+                             std::string const& redistribution_type,
                              const int srd_max_order,
                              amrex::Real target_volfrac,
                              Array4<Real const> const& srd_update_scale)
 {
-    // redistribution_type = "NoRedist";       // no redistribution
-    // redistribution_type = "FluxRedist"      // flux_redistribute
-    // redistribution_type = "StateRedist";    // (weighted) state redistribute
+    Apply(bx, ncomp, dUdt_out, dUdt_in, U_in, scratch, flag,
+          AMREX_D_DECL(apx, apy, apz), vfrac,
+          AMREX_D_DECL(fcx, fcy, fcz), ccc, d_bcrec_ptr, lev_geom, dt,
+          HydroUtils::RedistTypeFromString(redistribution_type),
+          srd_max_order, target_volfrac, srd_update_scale);
+}
+
+void Redistribution::Apply ( Box const& bx, int ncomp,
+                             Array4<Real      > const& dUdt_out,
+                             Array4<Real      > const& dUdt_in,
+                             Array4<Real const> const& U_in,
+                             Array4<Real> const& scratch,
+                             Array4<EBCellFlag const> const& flag,
+                             AMREX_D_DECL(Array4<Real const> const& apx,
+                                          Array4<Real const> const& apy,
+                                          Array4<Real const> const& apz),
+                             Array4<amrex::Real const> const& vfrac,
+                             AMREX_D_DECL(Array4<Real const> const& fcx,
+                                          Array4<Real const> const& fcy,
+                                          Array4<Real const> const& fcz),
+                             Array4<Real const> const& ccc,
+                             amrex::BCRec  const* d_bcrec_ptr,
+                             Geometry const& lev_geom, Real dt,
+                             HydroUtils::RedistType redistribution_type,
+                             const int srd_max_order,
+                             amrex::Real target_volfrac,
+                             Array4<Real const> const& srd_update_scale)
+{
+    // RedistType::NoRedist       // no redistribution
+    // RedistType::FluxRedist     // flux_redistribute
+    // RedistType::StateRedist    // (weighted) state redistribute
 
     amrex::ParallelFor(bx,ncomp,
     [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
@@ -41,12 +69,12 @@ void Redistribution::Apply ( Box const& bx, int ncomp,
             dUdt_out(i,j,k,n) = 0.;
         });
 
-    if (redistribution_type == "FluxRedist")
+    if (redistribution_type == HydroUtils::RedistType::FluxRedist)
     {
         int icomp = 0;
         apply_flux_redistribution (bx, dUdt_out, dUdt_in, scratch, icomp, ncomp, flag, vfrac, lev_geom);
 
-    } else if (redistribution_type == "StateRedist") {
+    } else if (redistribution_type == HydroUtils::RedistType::StateRedist) {
 
         Box const& bxg1 = grow(bx,1);
         Box const& bxg2 = grow(bx,2);
@@ -153,7 +181,7 @@ void Redistribution::Apply ( Box const& bx, int ncomp,
             }
         );
 
-    } else if (redistribution_type == "NoRedist") {
+    } else if (redistribution_type == HydroUtils::RedistType::NoRedist) {
         amrex::ParallelFor(bx, ncomp,
         [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
             {
@@ -180,7 +208,7 @@ Redistribution::ApplyToInitialData ( Box const& bx, int ncomp,
                                                   amrex::Array4<amrex::Real const> const& fcz),
                                      amrex::Array4<amrex::Real const> const& ccc,
                                      amrex::BCRec  const* d_bcrec_ptr,
-                                     Geometry& lev_geom, std::string redistribution_type,
+                                     Geometry& lev_geom, std::string const& redistribution_type,
                                      const int srd_max_order,
                                      amrex::Real target_volfrac)
 {
@@ -0,0 +1,265 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+#include <hydro_bds.H>
+
+#include <limits>
+#include <sstream>
+
+using namespace amrex;
+
+namespace {
+
+// One edge state of the golden data set
+struct Sample
+{
+    int dir;
+    IntVect iv;
+    int comp;
+    Real value;
+};
+
+// Reads the golden data set: comment lines start with '#', the first other
+// line is n_cell, then there is one sample per line
+Vector<Sample> read_golden (std::string const& golden_file, int& n_cell)
+{
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(golden_file, fileCharPtr);
+    std::istringstream is(fileCharPtr.dataPtr());
+
+    Vector<Sample> samples;
+    n_cell = -1;
+    std::string line;
+    while (std::getline(is, line))
+    {
+        if (line.empty() || line[0] == '#') { continue; }
+        std::istringstream ls(line);
+        if (n_cell < 0) {
+            ls >> n_cell;
+        } else {
+            Sample s;
+            ls >> s.dir >> s.iv[0] >> s.iv[1] >> s.iv[2] >> s.comp >> s.value;
+            samples.push_back(s);
+        }
+    }
+    return samples;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+
+    {
+        int max_grid_size = 32;
+        int nsteps = 20;
+        Real tol = 1.e-12;
+        std::string golden_file = "golden_3d.txt";
+
+        // read parameters
+        {
+            ParmParse pp;
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nsteps", nsteps);
+            pp.query("tol", tol);
+            pp.query("golden_file", golden_file);
+        }
+
+        // The golden data set fixes the number of cells
+        int n_cell;
+        const Vector<Sample> samples = read_golden(golden_file, n_cell);
+
+        // The golden data set has four components
+        const int ncomp = 4;
+
+        // Periodic in x, with an inflow (ext_dir) face at the low side of y
+        // and the high side of z, and an outflow face at the other sides
+        Box domain(IntVect(AMREX_D_DECL(0,0,0)),
+                   IntVect(AMREX_D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,0,0)};
+        Geometry geom(domain, rb, CoordSys::cartesian, is_periodic);
+
+        BoxArray grids(domain);
+        grids.maxSize(max_grid_size);
+        DistributionMapping dmap(grids);
+
+        MultiFab state(grids, dmap, ncomp, 3);
+        MultiFab force(grids, dmap, ncomp, 1);
+        MultiFab divu (grids, dmap, 1, 1);
+
+        MultiFab slopes(grids, dmap, 7*ncomp, 1);
+
+        Array<MultiFab,AMREX_SPACEDIM> umac, edge;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            BoxArray const& fba = amrex::convert(grids, IntVect::TheDimensionVector(d));
+            umac[d].define(fba, dmap, 1, 2);
+            edge[d].define(fba, dmap, ncomp, 0);
+        }
+
+        // Smooth functions, also in the ghost cells, where they are the
+        // periodic images in x and the Dirichlet values on inflow faces.
+        // They must not change: the golden data set was computed with them.
+        const auto dx = geom.CellSizeArray();
+        const Real pi2 = 2.0*Math::pi<Real>();
+        for (MFIter mfi(state); mfi.isValid(); ++mfi)
+        {
+            auto const& s = state.array(mfi);
+            ParallelFor(mfi.fabbox(), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                Real x = (i+0.5)*dx[0];
+                Real y = (j+0.5)*dx[1];
+                Real z = (k+0.5)*dx[2];
+                s(i,j,k,n) = std::sin(pi2*(n+1)*x) * std::cos(pi2*y) * std::sin(pi2*z+n) + 0.5*y;
+            });
+
+            auto const& f = force.array(mfi);
+            ParallelFor(force[mfi].box(), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                Real x = (i+0.5)*dx[0];
+                Real y = (j+0.5)*dx[1];
+                Real z = (k+0.5)*dx[2];
+                f(i,j,k,n) = 0.1*(n+1) * std::cos(pi2*x) * std::sin(pi2*(y+z));
+            });
+
+            auto const& dv = divu.array(mfi);
+            ParallelFor(divu[mfi].box(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                Real x = (i+0.5)*dx[0];
+                Real y = (j+0.5)*dx[1];
+                Real z = (k+0.5)*dx[2];
+                dv(i,j,k) = 0.1 * std::cos(pi2*x) * std::sin(pi2*y) * std::cos(pi2*z);
+            });
+
+            auto const& u = umac[0].array(mfi);
+            ParallelFor(umac[0][mfi].box(),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                u(i,j,k) = 0.2 + 0.5 * std::sin(pi2*(j+0.5)*dx[1]) * std::cos(pi2*(k+0.5)*dx[2]);
+            });
+            auto const& v = umac[1].array(mfi);
+            ParallelFor(umac[1][mfi].box(),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                v(i,j,k) = 0.5 + 0.3 * std::sin(pi2*(i+0.5)*dx[0]) * std::cos(pi2*(k+0.5)*dx[2]);
+            });
+            auto const& w = umac[2].array(mfi);
+            ParallelFor(umac[2][mfi].box(),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                w(i,j,k) = -0.4 + 0.3 * std::sin(pi2*(i+0.5)*dx[0]) * std::sin(pi2*(j+0.5)*dx[1]);
+            });
+        }
+
+        // advective CFL of about 0.5
+        const Real dt = 0.5*dx[0]/0.8;
+
+        Vector<BCRec> h_bc(ncomp);
+        for (int n = 0; n < ncomp; ++n) {
+            const int outflow = (n%2 == 0) ? BCType::foextrap : BCType::hoextrap;
+            h_bc[n].setLo(0, BCType::int_dir);
+            h_bc[n].setHi(0, BCType::int_dir);
+            h_bc[n].setLo(1, BCType::ext_dir);
+            h_bc[n].setHi(1, outflow);
+            h_bc[n].setLo(2, outflow);
+            h_bc[n].setHi(2, BCType::ext_dir);
+        }
+        Gpu::DeviceVector<BCRec> d_bc(ncomp);
+        Gpu::copy(Gpu::hostToDevice, h_bc.begin(), h_bc.end(), d_bc.begin());
+
+        Vector<int> h_iconserv(ncomp);
+        for (int n = 0; n < ncomp; ++n) {
+            h_iconserv[n] = n % 2;
+        }
+        Gpu::DeviceVector<int> d_iconserv(ncomp);
+        Gpu::copy(Gpu::hostToDevice, h_iconserv.begin(), h_iconserv.end(), d_iconserv.begin());
+        Gpu::streamSynchronize();
+
+        for (MFIter mfi(state); mfi.isValid(); ++mfi)
+        {
+            BDS::ComputeSlopes(mfi.validbox(), geom, ncomp,
+                               state.const_array(mfi), slopes.array(mfi),
+                               d_bc.data());
+        }
+
+        // ComputeConc, as called by BDS::ComputeEdgeState
+        auto compute_conc = [&] ()
+        {
+            for (MFIter mfi(state); mfi.isValid(); ++mfi)
+            {
+                BDS::ComputeConc(mfi.validbox(), geom, ncomp,
+                                 state.const_array(mfi),
+                                 edge[0].array(mfi), edge[1].array(mfi), edge[2].array(mfi),
+                                 slopes.const_array(mfi),
+                                 umac[0].const_array(mfi), umac[1].const_array(mfi), umac[2].const_array(mfi),
+                                 divu.const_array(mfi), force.const_array(mfi),
+                                 d_iconserv.data(), dt, d_bc.data(), false);
+            }
+            Gpu::streamSynchronize();
+        };
+
+        // warm up
+        compute_conc();
+
+        Real strt_time = amrex::second();
+        for (int step = 0; step < nsteps; ++step) {
+            compute_conc();
+        }
+        Real run_time = amrex::second() - strt_time;
+        ParallelDescriptor::ReduceRealMax(run_time, ParallelDescriptor::IOProcessorNumber());
+
+        // Compare with the golden data set on the host. A face on the
+        // boundary between two boxes is in both, with the same value.
+        Real diff_max = 0.0;
+        Real golden_max = 0.0;
+        Vector<int> found(samples.size(), 0);
+        for (int d = 0; d < AMREX_SPACEDIM; ++d)
+        {
+            MultiFab host_edge(edge[d].boxArray(), edge[d].DistributionMap(), ncomp, 0,
+                               MFInfo().SetArena(The_Pinned_Arena()));
+            MultiFab::Copy(host_edge, edge[d], 0, 0, ncomp, 0);
+            Gpu::streamSynchronize();
+
+            for (MFIter mfi(host_edge); mfi.isValid(); ++mfi)
+            {
+                Box const& b = mfi.validbox();
+                auto const& e = host_edge.const_array(mfi);
+                for (int is = 0; is < samples.size(); ++is)
+                {
+                    Sample const& s = samples[is];
+                    if (s.dir == d && b.contains(s.iv)) {
+                        diff_max = amrex::max(diff_max, std::abs(e(s.iv,s.comp) - s.value));
+                        found[is] = 1;
+                    }
+                }
+            }
+        }
+        for (auto const& s : samples) {
+            golden_max = amrex::max(golden_max, std::abs(s.value));
+        }
+        ParallelDescriptor::ReduceRealMax(diff_max);
+        ParallelDescriptor::ReduceIntMax(found.data(), static_cast<int>(found.size()));
+        for (int f : found) {
+            if (!f) {
+                amrex::Abort("BDS_EdgeState: a golden sample lies outside the domain");
+            }
+        }
+        const Real rel_diff = diff_max / amrex::max(golden_max, std::numeric_limits<Real>::min());
+
+        const Real ncells = static_cast<Real>(domain.numPts()) * ncomp;
+        amrex::Print() << " BDS::ComputeConc on " << n_cell << "^" << AMREX_SPACEDIM
+                       << " cells, " << ncomp << " components, max_grid_size " << max_grid_size << "\n"
+                       << " Time per call                      " << run_time/nsteps << "\n"
+                       << " Time per cell and comp             " << run_time/(nsteps*ncells) << "\n"
+                       << " Golden samples                     " << samples.size() << "\n"
+                       << " Max relative difference            " << rel_diff << std::endl;
+
+        if (rel_diff > tol) {
+            amrex::Abort("BDS_EdgeState: edge states differ from the golden data set by more than tol");
+        }
+    }
+
+    amrex::Finalize();
+}
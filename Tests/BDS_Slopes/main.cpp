@@ -0,0 +1,141 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+#include <hydro_bds.H>
+
+#include <limits>
+
+using namespace amrex;
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+
+    {
+        int n_cell = 64;
+        int max_grid_size = 32;
+        int ncomp = 4;
+        int nsteps = 20;
+        Real tol = 0.0;
+        Vector<int> is_periodic(AMREX_SPACEDIM, 0);
+        is_periodic[0] = 1;
+
+        // read parameters
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+            pp.query("nsteps", nsteps);
+            pp.query("tol", tol);
+            pp.queryarr("is_periodic", is_periodic, 0, AMREX_SPACEDIM);
+        }
+
+        Box domain(IntVect(AMREX_D_DECL(0,0,0)),
+                   IntVect(AMREX_D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> periodic{AMREX_D_DECL(is_periodic[0],
+                                                        is_periodic[1],
+                                                        is_periodic[2])};
+        Geometry geom(domain, rb, CoordSys::cartesian, periodic);
+
+        BoxArray grids(domain);
+        grids.maxSize(max_grid_size);
+        DistributionMapping dmap(grids);
+
+        constexpr int nslopes = (AMREX_SPACEDIM == 2) ? 3 : 7;
+
+        MultiFab state(grids, dmap, ncomp, 3);
+        MultiFab slopes(grids, dmap, nslopes*ncomp, 1);
+        MultiFab slopes_fused(grids, dmap, nslopes*ncomp, 1);
+
+        // smooth scalars with a sharp front, so that the limiter is active;
+        // the ghost cells hold the same functions, which are periodic in x
+        const auto dx = geom.CellSizeArray();
+        const Real pi2 = 2.0*Math::pi<Real>();
+        for (MFIter mfi(state); mfi.isValid(); ++mfi)
+        {
+            auto const& s = state.array(mfi);
+            ParallelFor(mfi.fabbox(), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                AMREX_D_TERM(Real x = (i+0.5)*dx[0];,
+                             Real y = (j+0.5)*dx[1];,
+                             Real z = (k+0.5)*dx[2];);
+                Real v = std::sin(pi2*(n+1)*x) * std::cos(pi2*y);
+#if (AMREX_SPACEDIM == 3)
+                v *= std::cos(pi2*z+n);
+#endif
+                s(i,j,k,n) = v + ((y > 0.5) ? 1.0 : 0.0);
+            });
+        }
+
+        // inflow (ext_dir) at the low and outflow at the high side of the
+        // non-periodic directions
+        Vector<BCRec> h_bc(ncomp);
+        for (int n = 0; n < ncomp; ++n) {
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                if (geom.isPeriodic(d)) {
+                    h_bc[n].setLo(d, BCType::int_dir);
+                    h_bc[n].setHi(d, BCType::int_dir);
+                } else {
+                    h_bc[n].setLo(d, BCType::ext_dir);
+                    h_bc[n].setHi(d, (n%2 == 0) ? BCType::foextrap : BCType::hoextrap);
+                }
+            }
+        }
+        Gpu::DeviceVector<BCRec> d_bc(ncomp);
+        Gpu::copy(Gpu::hostToDevice, h_bc.begin(), h_bc.end(), d_bc.begin());
+        Gpu::streamSynchronize();
+
+        auto compute_slopes = [&] (MultiFab& mf, bool fuse_nodes)
+        {
+            for (MFIter mfi(state); mfi.isValid(); ++mfi)
+            {
+                BDS::ComputeSlopes(mfi.validbox(), geom, ncomp,
+                                   state.const_array(mfi), mf.array(mfi),
+                                   d_bc.data(), fuse_nodes);
+            }
+            Gpu::streamSynchronize();
+        };
+
+        auto time_calls = [&] (auto const& f)
+        {
+            // warm up
+            f();
+
+            Real strt_time = amrex::second();
+            for (int step = 0; step < nsteps; ++step) {
+                f();
+            }
+            Real run_time = amrex::second() - strt_time;
+            ParallelDescriptor::ReduceRealMax(run_time, ParallelDescriptor::IOProcessorNumber());
+            return run_time;
+        };
+
+        const Real ref_time = time_calls([&] () { compute_slopes(slopes, false); });
+        const Real run_time = time_calls([&] () { compute_slopes(slopes_fused, true); });
+
+        const int ns = nslopes*ncomp;
+        const Real slope_max = slopes.norminf(0, ns, IntVect(1));
+        MultiFab::Subtract(slopes_fused, slopes, 0, 0, ns, 1);
+        const Real diff_max = slopes_fused.norminf(0, ns, IntVect(1));
+        const Real rel_diff = diff_max / amrex::max(slope_max, std::numeric_limits<Real>::min());
+
+        const Real ncells = static_cast<Real>(domain.numPts()) * ncomp;
+        amrex::Print() << " BDS::ComputeSlopes on " << n_cell << "^" << AMREX_SPACEDIM
+                       << " cells, " << ncomp << " components, max_grid_size " << max_grid_size << "\n"
+                       << " Two kernels: time per call           " << ref_time/nsteps << "\n"
+                       << " Two kernels: time per cell and comp  " << ref_time/(nsteps*ncells) << "\n"
+                       << " Fused:       time per call           " << run_time/nsteps << "\n"
+                       << " Fused:       time per cell and comp  " << run_time/(nsteps*ncells) << "\n"
+                       << " Speedup                              " << ref_time/run_time << "\n"
+                       << " Max relative difference              " << rel_diff << std::endl;
+
+        if (rel_diff > tol) {
+            amrex::Abort("BDS_Slopes: fused and two-kernel slopes differ by more than tol");
+        }
+    }
+
+    amrex::Finalize();
+}
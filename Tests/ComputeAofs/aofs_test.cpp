@@ -0,0 +1,246 @@
+#include <aofs_test.H>
+
+#include <hydro_bds.H>
+#include <hydro_godunov.H>
+#include <hydro_mol.H>
+
+#include <AMReX_ParmParse.H>
+
+#ifdef AMREX_USE_EB
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#endif
+
+#include <limits>
+
+using namespace amrex;
+
+AofsTestData::AofsTestData (int state_ghost)
+{
+    int n_cell = 64;
+    int max_grid_size = 16;
+    int coord_sys = 0;
+    Vector<int> is_periodic(AMREX_SPACEDIM, 0);
+    is_periodic[0] = 1;
+
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("ncomp", ncomp);
+        pp.query("coord_sys", coord_sys);
+        pp.queryarr("is_periodic", is_periodic, 0, AMREX_SPACEDIM);
+    }
+
+    Box domain(IntVect(AMREX_D_DECL(0,0,0)),
+               IntVect(AMREX_D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> periodic{AMREX_D_DECL(is_periodic[0],
+                                                    is_periodic[1],
+                                                    is_periodic[2])};
+    geom.define(domain, rb, coord_sys, periodic);
+
+    grids.define(domain);
+    grids.maxSize(max_grid_size);
+    dmap.define(grids);
+
+#ifdef AMREX_USE_EB
+    EB2::Build(EB2::makeShop(EB2::AllRegularIF()), geom, 0, 0);
+    const int ng_eb = amrex::max(state_ghost, 5);
+    factory = std::make_unique<EBFArrayBoxFactory>(EB2::IndexSpace::top().getLevel(geom), geom,
+                                                   grids, dmap, Vector<int>{ng_eb,ng_eb,ng_eb},
+                                                   EBSupport::basic);
+#endif
+
+    define_and_fill(state_ghost);
+    define_bcs();
+}
+
+AofsTestData::AofsTestData (AofsTestData const& crse, BoxArray const& fine_grids,
+                            IntVect const& ref_ratio)
+    : geom(amrex::refine(crse.geom, ref_ratio)), grids(fine_grids), dmap(fine_grids),
+      ncomp(crse.ncomp)
+{
+    define_and_fill(crse.state.nGrow());
+    define_bcs();
+}
+
+void
+AofsTestData::define_and_fill (int state_ghost)
+{
+    state.define(grids, dmap, ncomp, state_ghost);
+    fq.define   (grids, dmap, ncomp, state_ghost);
+    divu.define (grids, dmap, 1, state_ghost);
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        umac[d].define(amrex::convert(grids, IntVect::TheDimensionVector(d)), dmap, 1, 2);
+    }
+
+    const auto problo = geom.ProbLoArray();
+    const auto dx     = geom.CellSizeArray();
+    const Real pi2    = 2.0*Math::pi<Real>();
+
+    for (MFIter mfi(state); mfi.isValid(); ++mfi)
+    {
+        auto const& s  = state.array(mfi);
+        auto const& f  = fq.array(mfi);
+        auto const& du = divu.array(mfi);
+        ParallelFor(mfi.fabbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            AMREX_D_TERM(Real x = problo[0] + (i+0.5)*dx[0];,
+                         Real y = problo[1] + (j+0.5)*dx[1];,
+                         Real z = problo[2] + (k+0.5)*dx[2];);
+            du(i,j,k) = 0.1*std::cos(pi2*x)*std::sin(pi2*y);
+            for (int n = 0; n < s.nComp(); ++n) {
+                Real v = std::sin(pi2*(n+1)*x) * std::cos(pi2*y);
+#if (AMREX_SPACEDIM == 3)
+                v *= std::sin(pi2*z+n);
+#endif
+                s(i,j,k,n) = v + 0.5*n;
+                f(i,j,k,n) = 0.3*std::cos(pi2*(x+y)) - 0.1*n;
+            }
+        });
+
+        AMREX_D_TERM(auto const& u = umac[0].array(mfi);,
+                     auto const& v = umac[1].array(mfi);,
+                     auto const& w = umac[2].array(mfi););
+        ParallelFor(umac[0][mfi].box(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            Real x = problo[0] + i*dx[0];
+            Real y = problo[1] + (j+0.5)*dx[1];
+            u(i,j,k) = 0.2 + 0.5*std::sin(pi2*y) + 0.1*std::cos(pi2*x);
+        });
+        ParallelFor(umac[1][mfi].box(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            Real x = problo[0] + (i+0.5)*dx[0];
+            Real y = problo[1] + j*dx[1];
+            v(i,j,k) = 0.3 - 0.5*std::sin(pi2*x) + 0.1*std::sin(pi2*y);
+        });
+#if (AMREX_SPACEDIM == 3)
+        ParallelFor(umac[2][mfi].box(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            Real x = problo[0] + (i+0.5)*dx[0];
+            Real z = problo[2] + k*dx[2];
+            w(i,j,k) = 0.1 + 0.4*std::sin(pi2*x) + 0.1*std::cos(pi2*z);
+        });
+#endif
+    }
+
+    // the largest face velocity is 0.8, so this is an advective CFL of about 0.5
+    dt = 0.5*dx[0]/0.8;
+}
+
+AofsTestData::AofsTestData (AofsTestData const& src, HydroUtils::GhostCells const& ng)
+    : geom(src.geom), grids(src.grids), dmap(src.dmap), ncomp(src.ncomp), dt(src.dt)
+{
+    AMREX_ALWAYS_ASSERT(ng.state  <= src.state.nGrow() &&
+                        ng.forces <= src.fq.nGrow() &&
+                        ng.divu   <= src.divu.nGrow() &&
+                        ng.umac   <= src.umac[0].nGrow());
+
+    state.define(grids, dmap, ncomp, ng.state);
+    fq.define   (grids, dmap, ncomp, ng.forces);
+    divu.define (grids, dmap, 1, ng.divu);
+    MultiFab::Copy(state, src.state, 0, 0, ncomp, ng.state);
+    MultiFab::Copy(fq,    src.fq,    0, 0, ncomp, ng.forces);
+    MultiFab::Copy(divu,  src.divu,  0, 0, 1,     ng.divu);
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        umac[d].define(src.umac[d].boxArray(), dmap, 1, ng.umac);
+        MultiFab::Copy(umac[d], src.umac[d], 0, 0, 1, ng.umac);
+    }
+
+    define_bcs();
+}
+
+void
+AofsTestData::define_bcs ()
+{
+    h_bc.resize(ncomp);
+    iconserv.resize(ncomp);
+    for (int n = 0; n < ncomp; ++n) {
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            if (geom.isPeriodic(d)) {
+                h_bc[n].setLo(d, BCType::int_dir);
+                h_bc[n].setHi(d, BCType::int_dir);
+            } else {
+                h_bc[n].setLo(d, BCType::ext_dir);
+                h_bc[n].setHi(d, (n%2 == 0) ? BCType::foextrap : BCType::hoextrap);
+            }
+        }
+        iconserv[n] = n % 2;
+    }
+
+    d_bc.resize(ncomp);
+    d_iconserv.resize(ncomp);
+    Gpu::copy(Gpu::hostToDevice, h_bc.begin(), h_bc.end(), d_bc.begin());
+    Gpu::copy(Gpu::hostToDevice, iconserv.begin(), iconserv.end(), d_iconserv.begin());
+    Gpu::streamSynchronize();
+}
+
+void
+compute_aofs (AofsScheme const& s, AofsTestData& data, MultiFab& aofs,
+              Array<MultiFab,AMREX_SPACEDIM>& edge, Array<MultiFab,AMREX_SPACEDIM>& flux,
+              HydroUtils::AdvectionDiagnostics* diagnostics)
+{
+    const int ncomp = data.ncomp;
+    switch (s.scheme)
+    {
+    case HydroUtils::AdvectionScheme::MOL:
+        MOL::ComputeAofs(aofs, 0, ncomp, data.state, 0,
+                         AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                         AMREX_D_DECL(edge[0], edge[1], edge[2]), 0, false,
+                         AMREX_D_DECL(flux[0], flux[1], flux[2]), 0,
+                         data.divu, data.h_bc, data.d_bc.data(), data.d_iconserv,
+                         data.geom, false, diagnostics);
+        break;
+    case HydroUtils::AdvectionScheme::Godunov:
+        Godunov::ComputeAofs(aofs, 0, ncomp, data.state, 0,
+                             AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                             AMREX_D_DECL(edge[0], edge[1], edge[2]), 0, false,
+                             AMREX_D_DECL(flux[0], flux[1], flux[2]), 0,
+                             data.fq, 0, data.divu, data.d_bc.data(), data.geom,
+                             data.iconserv, data.dt, s.use_ppm, true, false, diagnostics);
+        break;
+    case HydroUtils::AdvectionScheme::BDS:
+        BDS::ComputeAofs(aofs, 0, ncomp, data.state, 0,
+                         AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                         AMREX_D_DECL(edge[0], edge[1], edge[2]), 0, false,
+                         AMREX_D_DECL(flux[0], flux[1], flux[2]), 0,
+                         data.fq, 0, data.divu, data.d_bc.data(), data.geom,
+                         data.iconserv, data.dt, false, nullptr, -1, diagnostics);
+        break;
+    default:
+        amrex::Abort("compute_aofs: unknown advection scheme");
+    }
+}
+
+void
+flux_divergence (MultiFab& div, Array<MultiFab,AMREX_SPACEDIM> const& flux, Geometry const& geom)
+{
+    MultiFab vol;
+    geom.GetVolume(vol, div.boxArray(), div.DistributionMap(), 0);
+
+    auto const& d = div.arrays();
+    auto const& v = vol.const_arrays();
+    AMREX_D_TERM(auto const& fx = flux[0].const_arrays();,
+                 auto const& fy = flux[1].const_arrays();,
+                 auto const& fz = flux[2].const_arrays(););
+    ParallelFor(div, IntVect(0), div.nComp(),
+    [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+    {
+        d[box](i,j,k,n) = (AMREX_D_TERM(  fx[box](i+1,j,k,n) - fx[box](i,j,k,n),
+                                        + fy[box](i,j+1,k,n) - fy[box](i,j,k,n),
+                                        + fz[box](i,j,k+1,n) - fz[box](i,j,k,n)))
+                          / v[box](i,j,k);
+    });
+    Gpu::streamSynchronize();
+}
+
+Real
+max_rel_diff (MultiFab const& a, MultiFab const& b, int comp, int ncomp)
+{
+    MultiFab diff(b.boxArray(), b.DistributionMap(), ncomp, 0);
+    MultiFab::Copy(diff, b, comp, 0, ncomp, 0);
+    const Real bmax = diff.norminf(0, ncomp, IntVect(0));
+    MultiFab::Subtract(diff, a, comp, 0, ncomp, 0);
+    return diff.norminf(0, ncomp, IntVect(0)) / amrex::max(bmax, std::numeric_limits<Real>::min());
+}
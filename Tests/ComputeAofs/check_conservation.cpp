@@ -0,0 +1,80 @@
+#include <aofs_test.H>
+
+#include <hydro_utils.H>
+
+#include <cmath>
+#include <limits>
+
+using namespace amrex;
+
+// The conservation diagnostics of ComputeAofs: for the conservative
+// components, the integral of aofs over the domain (aofs_sum) must equal the
+// net flux out through the non-periodic faces (boundary_flux_sum), since the
+// fluxes on the faces between cells cancel. The inflow and outflow faces
+// make both sums nonzero. Needs at least one non-periodic direction.
+bool check_conservation (AofsTestData& data, Real tol, int nsteps)
+{
+    amrex::ignore_unused(nsteps);
+
+    const int ncomp = data.ncomp;
+    bool pass = true;
+
+    amrex::Print() << " ComputeAofs conservation diagnostics, aofs_sum vs boundary_flux_sum, "
+                   << data.grids.size() << " boxes"
+                   << (data.geom.IsRZ() ? ", RZ" : "") << "\n";
+
+    if (data.geom.isAllPeriodic()) {
+        amrex::Print() << "   FAILED: the domain is periodic in all directions\n";
+        return false;
+    }
+
+    const AofsScheme cases[] = {
+        {"MOL",         HydroUtils::AdvectionScheme::MOL,     false},
+        {"Godunov PLM", HydroUtils::AdvectionScheme::Godunov, false},
+        {"Godunov PPM", HydroUtils::AdvectionScheme::Godunov, true},
+        {"BDS",         HydroUtils::AdvectionScheme::BDS,     false}
+    };
+
+    for (auto const& c : cases)
+    {
+        MultiFab aofs(data.grids, data.dmap, ncomp, 0);
+        Array<MultiFab,AMREX_SPACEDIM> edge, flux;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            BoxArray const& fba = amrex::convert(data.grids, IntVect::TheDimensionVector(d));
+            edge[d].define(fba, data.dmap, ncomp, 0);
+            flux[d].define(fba, data.dmap, ncomp, 0);
+        }
+
+        HydroUtils::AdvectionDiagnostics diag;
+        compute_aofs(c, data, aofs, edge, flux, &diag);
+
+        // The round-off of aofs_sum grows with the size of the terms it adds,
+        // so the difference is relative to max |aofs| times the domain volume
+        // if that is larger than the largest boundary flux
+        Real flux_max = 0.0;
+        Real diff_max = 0.0;
+        for (int n = 0; n < ncomp; ++n) {
+            if (data.iconserv[n]) {
+                flux_max = amrex::max(flux_max, std::abs(diag.boundary_flux_sum[n]));
+                diff_max = amrex::max(diff_max, std::abs(diag.aofs_sum[n] - diag.boundary_flux_sum[n]));
+            }
+        }
+        const Real scale = amrex::max(flux_max, diag.max_abs_aofs * data.geom.ProbDomain().volume(),
+                                      std::numeric_limits<Real>::min());
+        const Real rel_diff = diff_max / scale;
+
+        amrex::Print() << "   " << c.name << ": max |boundary_flux_sum| " << flux_max
+                       << "; max relative difference " << rel_diff << "\n";
+
+        if (flux_max == 0.0) {
+            amrex::Print() << "   FAILED: the boundary fluxes are zero, so nothing was compared\n";
+            pass = false;
+        }
+        if (rel_diff > tol) {
+            amrex::Print() << "   FAILED: aofs_sum and boundary_flux_sum differ by more than tol\n";
+            pass = false;
+        }
+    }
+
+    return pass;
+}
@@ -0,0 +1,161 @@
+#include <aofs_test.H>
+
+#include <hydro_utils.H>
+
+using namespace amrex;
+
+namespace {
+
+// HydroUtils::ComputeFluxesOnBoxFromState on every tile, with the scheme
+// given either as its name or as the enum
+template <typename S>
+void fluxes_on_boxes (S const& scheme, bool use_ppm, AofsTestData& data,
+                      Array<MultiFab,AMREX_SPACEDIM>& edge, Array<MultiFab,AMREX_SPACEDIM>& flux)
+{
+    const int ncomp = data.ncomp;
+    for (MFIter mfi(data.divu,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        Box const& bx = mfi.tilebox();
+        HydroUtils::ComputeFluxesOnBoxFromState(bx, ncomp, mfi, data.state.const_array(mfi),
+                                                AMREX_D_DECL(flux[0].array(mfi), flux[1].array(mfi),
+                                                             flux[2].array(mfi)),
+                                                AMREX_D_DECL(edge[0].array(mfi), edge[1].array(mfi),
+                                                             edge[2].array(mfi)),
+                                                false,
+                                                AMREX_D_DECL(data.umac[0].const_array(mfi),
+                                                             data.umac[1].const_array(mfi),
+                                                             data.umac[2].const_array(mfi)),
+                                                data.divu.const_array(mfi), data.fq.const_array(mfi),
+                                                data.geom, data.dt, data.h_bc, data.d_bc.data(),
+                                                data.d_iconserv.data(),
+#ifdef AMREX_USE_EB
+                                                *data.factory, Array4<Real const>{},
+#endif
+                                                use_ppm, true, false, true, scheme);
+    }
+    Gpu::streamSynchronize();
+}
+
+bool same_ghost_cells (HydroUtils::GhostCells const& a, HydroUtils::GhostCells const& b)
+{
+    return a.state == b.state && a.forces == b.forces && a.divu == b.divu && a.umac == b.umac;
+}
+
+}
+
+// The enum dispatch of the schemes: AdvectionSchemeFromString and
+// RedistTypeFromString on every name, RequiredGhostCells with names against
+// the enums, and ComputeFluxesOnBoxFromState with the name against the enum
+// (bit for bit) and against the ComputeAofs of the scheme (fluxes and edge
+// states), so that each entry of its function table runs the right scheme.
+bool check_dispatch (AofsTestData& data, Real tol, int nsteps)
+{
+    amrex::ignore_unused(nsteps);
+
+    const int ncomp = data.ncomp;
+    bool pass = true;
+
+    amrex::Print() << " Scheme dispatch on names vs enums, "
+                   << data.grids.size() << " boxes"
+                   << (data.geom.IsRZ() ? ", RZ" : "") << "\n";
+
+    const char* scheme_names[] = {"MOL", "Godunov", "BDS"};
+    const HydroUtils::AdvectionScheme schemes[] = {HydroUtils::AdvectionScheme::MOL,
+                                                   HydroUtils::AdvectionScheme::Godunov,
+                                                   HydroUtils::AdvectionScheme::BDS};
+    const char* redist_names[] = {"NoRedist", "FluxRedist", "StateRedist"};
+    const HydroUtils::RedistType redist_types[] = {HydroUtils::RedistType::NoRedist,
+                                                   HydroUtils::RedistType::FluxRedist,
+                                                   HydroUtils::RedistType::StateRedist};
+
+    for (int is = 0; is < 3; ++is)
+    {
+        if (HydroUtils::AdvectionSchemeFromString(scheme_names[is]) != schemes[is]) {
+            amrex::Print() << "   FAILED: AdvectionSchemeFromString(\"" << scheme_names[is]
+                           << "\") is not the matching enum\n";
+            pass = false;
+        }
+    }
+    for (int ir = 0; ir < 3; ++ir)
+    {
+        if (HydroUtils::RedistTypeFromString(redist_names[ir]) != redist_types[ir]) {
+            amrex::Print() << "   FAILED: RedistTypeFromString(\"" << redist_names[ir]
+                           << "\") is not the matching enum\n";
+            pass = false;
+        }
+    }
+
+    for (int is = 0; is < 3; ++is) {
+    for (int ir = 0; ir < 3; ++ir) {
+    for (int eb = 0; eb < 2; ++eb) {
+    for (int known = 0; known < 2; ++known)
+    {
+        auto const& ng_name = HydroUtils::RequiredGhostCells(scheme_names[is], false, eb == 1,
+                                                             redist_names[ir], known == 1);
+        auto const& ng_enum = HydroUtils::RequiredGhostCells(schemes[is], false, eb == 1,
+                                                             redist_types[ir], known == 1);
+        if (!same_ghost_cells(ng_name, ng_enum)) {
+            amrex::Print() << "   FAILED: RequiredGhostCells differs between \"" << scheme_names[is]
+                           << "\", \"" << redist_names[ir] << "\" and the enums\n";
+            pass = false;
+        }
+    }}}}
+
+    const AofsScheme cases[] = {
+        {"MOL",         HydroUtils::AdvectionScheme::MOL,     false},
+        {"Godunov PLM", HydroUtils::AdvectionScheme::Godunov, false},
+        {"Godunov PPM", HydroUtils::AdvectionScheme::Godunov, true},
+        {"BDS",         HydroUtils::AdvectionScheme::BDS,     false}
+    };
+
+    for (auto const& c : cases)
+    {
+        // 0: ComputeAofs, 1: name, 2: enum
+        MultiFab aofs(data.grids, data.dmap, ncomp, 0);
+        Array<Array<MultiFab,AMREX_SPACEDIM>,3> edge, flux;
+        for (int k = 0; k < 3; ++k) {
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                BoxArray const& fba = amrex::convert(data.grids, IntVect::TheDimensionVector(d));
+                edge[k][d].define(fba, data.dmap, ncomp, 0);
+                flux[k][d].define(fba, data.dmap, ncomp, 0);
+            }
+        }
+
+        compute_aofs(c, data, aofs, edge[0], flux[0]);
+
+        const int is = static_cast<int>(c.scheme);
+        fluxes_on_boxes(std::string(scheme_names[is]), c.use_ppm, data, edge[1], flux[1]);
+        fluxes_on_boxes(c.scheme, c.use_ppm, data, edge[2], flux[2]);
+
+        Real name_diff = 0.0;
+        Real flux_diff = 0.0;
+        Real edge_diff = 0.0;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d)
+        {
+            for (auto* mf : {&flux, &edge})
+            {
+                MultiFab diff((*mf)[2][d].boxArray(), data.dmap, ncomp, 0);
+                MultiFab::Copy(diff, (*mf)[1][d], 0, 0, ncomp, 0);
+                MultiFab::Subtract(diff, (*mf)[2][d], 0, 0, ncomp, 0);
+                name_diff = amrex::max(name_diff, diff.norminf(0, ncomp, IntVect(0)));
+            }
+            flux_diff = amrex::max(flux_diff, max_rel_diff(flux[2][d], flux[0][d], 0, ncomp));
+            edge_diff = amrex::max(edge_diff, max_rel_diff(edge[2][d], edge[0][d], 0, ncomp));
+        }
+
+        amrex::Print() << "   " << c.name << ": max difference name vs enum " << name_diff
+                       << "; max relative difference to ComputeAofs fluxes " << flux_diff
+                       << ", edge states " << edge_diff << "\n";
+
+        if (name_diff != 0.0) {
+            amrex::Print() << "   FAILED: ComputeFluxesOnBoxFromState differs between the name and the enum\n";
+            pass = false;
+        }
+        if (flux_diff > tol || edge_diff > tol) {
+            amrex::Print() << "   FAILED: ComputeFluxesOnBoxFromState and ComputeAofs of the scheme differ by more than tol\n";
+            pass = false;
+        }
+    }
+
+    return pass;
+}
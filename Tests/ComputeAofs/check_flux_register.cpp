@@ -0,0 +1,157 @@
+#include <aofs_test.H>
+
+#include <hydro_godunov.H>
+
+#include <AMReX_YAFluxRegister.H>
+
+#include <memory>
+
+using namespace amrex;
+
+namespace {
+
+// Level-wide Godunov fluxes, divided by the face areas the MultiFab path
+// weights them with, since YAFluxRegister expects fluxes per unit area
+void compute_level_fluxes (AofsTestData& data, MultiFab& aofs,
+                           Array<MultiFab,AMREX_SPACEDIM>& edge,
+                           Array<MultiFab,AMREX_SPACEDIM>& flux, bool use_ppm)
+{
+    Godunov::ComputeAofs(aofs, 0, data.ncomp, data.state, 0,
+                         AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                         AMREX_D_DECL(edge[0], edge[1], edge[2]), 0, false,
+                         AMREX_D_DECL(flux[0], flux[1], flux[2]), 0,
+                         data.fq, 0, data.divu, data.d_bc.data(), data.geom,
+                         data.iconserv, data.dt, use_ppm, true, false);
+
+    const auto dx = data.geom.CellSizeArray();
+    const Real vol = AMREX_D_TERM(dx[0], *dx[1], *dx[2]);
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        flux[d].mult(dx[d]/vol, 0, data.ncomp);
+    }
+}
+
+}
+
+// Reflux through the Godunov::ComputeAofs overload that adds each tile's
+// fluxes to the flux registers, against the level-wide flux MultiFabs added
+// with CrseAdd (YAFluxRegister's counterpart of FluxRegister::CrseInit) and
+// FineAdd, for PLM and PPM. The fine level covers the middle of the domain
+// with a refinement of 2, and takes one step of dt/2. The reflux
+// corrections and the aofs of both levels are compared. The overload does
+// not support RZ, so the check is skipped there.
+bool check_flux_register (AofsTestData& data, Real tol, int nsteps)
+{
+    amrex::ignore_unused(nsteps);
+
+    const int ncomp = data.ncomp;
+    bool pass = true;
+
+    if (data.geom.IsRZ()) {
+        amrex::Print() << " ComputeAofs with flux registers: skipped, RZ is not supported\n";
+        return pass;
+    }
+
+    const IntVect ref_ratio(2);
+    const Box& domain = data.geom.Domain();
+    Box fine_box(domain.smallEnd() + domain.length()/4,
+                 domain.smallEnd() + (3*domain.length())/4 - 1);
+    BoxArray fine_grids(amrex::refine(fine_box, ref_ratio));
+    fine_grids.maxSize(data.grids[0].longside());
+
+    AofsTestData fine(data, fine_grids, ref_ratio);
+
+    amrex::Print() << " ComputeAofs with flux registers vs flux MultiFabs, "
+                   << data.grids.size() << " coarse and " << fine_grids.size()
+                   << " fine boxes\n";
+
+    AofsTestData* levels[] = {&data, &fine};
+
+    const char* names[] = {"Godunov PLM", "Godunov PPM"};
+    for (int use_ppm = 0; use_ppm < 2; ++use_ppm)
+    {
+        // [path][level], path 0 through the registers, path 1 through the MultiFabs
+        Array<Array<MultiFab,2>,2> aofs;
+        Array<Array<Array<MultiFab,AMREX_SPACEDIM>,2>,2> edge;
+        Array<Array<MultiFab,AMREX_SPACEDIM>,2> flux;
+        Array<std::unique_ptr<YAFluxRegister>,2> fr;
+        Array<MultiFab,2> correction;
+        for (int k = 0; k < 2; ++k)
+        {
+            fr[k] = std::make_unique<YAFluxRegister>(fine.grids, data.grids, fine.dmap, data.dmap,
+                                                     fine.geom, data.geom, ref_ratio, 1, ncomp);
+            correction[k].define(data.grids, data.dmap, ncomp, 0);
+            correction[k].setVal(0.0);
+            for (int lev = 0; lev < 2; ++lev)
+            {
+                AofsTestData const& ld = *levels[lev];
+                aofs[k][lev].define(ld.grids, ld.dmap, ncomp, 0);
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    BoxArray const& fba = amrex::convert(ld.grids, IntVect::TheDimensionVector(d));
+                    edge[k][lev][d].define(fba, ld.dmap, ncomp, 0);
+                    if (k == 1) {
+                        flux[lev][d].define(fba, ld.dmap, ncomp, 0);
+                    }
+                }
+            }
+        }
+
+        // Through the registers
+        for (int lev = 0; lev < 2; ++lev)
+        {
+            AofsTestData& ld = *levels[lev];
+            auto& e = edge[0][lev];
+            Godunov::ComputeAofs(aofs[0][lev], 0, ncomp, ld.state, 0,
+                                 AMREX_D_DECL(ld.umac[0], ld.umac[1], ld.umac[2]),
+                                 AMREX_D_DECL(e[0], e[1], e[2]), 0, false,
+                                 (lev == 0) ? fr[0].get() : nullptr,
+                                 (lev == 1) ? fr[0].get() : nullptr, 0,
+                                 ld.fq, 0, ld.divu, ld.d_bc.data(), ld.geom,
+                                 ld.iconserv, ld.dt, use_ppm == 1, true, false);
+        }
+
+        // Through the level-wide MultiFabs
+        for (int lev = 0; lev < 2; ++lev)
+        {
+            AofsTestData& ld = *levels[lev];
+            compute_level_fluxes(ld, aofs[1][lev], edge[1][lev], flux[lev], use_ppm == 1);
+
+            const RunOn run_on = Gpu::inLaunchRegion() ? RunOn::Gpu : RunOn::Cpu;
+            for (MFIter mfi(aofs[1][lev]); mfi.isValid(); ++mfi)
+            {
+                Array<FArrayBox const*,AMREX_SPACEDIM> flux_fab{
+                    AMREX_D_DECL(&flux[lev][0][mfi], &flux[lev][1][mfi], &flux[lev][2][mfi])};
+                if (lev == 0) {
+                    fr[1]->CrseAdd(mfi, flux_fab, ld.geom.CellSize(), ld.dt, 0, 0, ncomp, run_on);
+                } else {
+                    fr[1]->FineAdd(mfi, flux_fab, ld.geom.CellSize(), ld.dt, 0, 0, ncomp, run_on);
+                }
+            }
+        }
+
+        for (int k = 0; k < 2; ++k) {
+            fr[k]->Reflux(correction[k]);
+        }
+
+        const Real reflux_diff = max_rel_diff(correction[0], correction[1], 0, ncomp);
+        const Real reflux_max  = correction[1].norminf(0, ncomp, IntVect(0));
+        Real aofs_diff = 0.0;
+        for (int lev = 0; lev < 2; ++lev) {
+            aofs_diff = amrex::max(aofs_diff, max_rel_diff(aofs[0][lev], aofs[1][lev], 0, ncomp));
+        }
+
+        amrex::Print() << "   " << names[use_ppm] << ": max reflux correction " << reflux_max
+                       << "; max relative difference reflux " << reflux_diff
+                       << ", aofs " << aofs_diff << "\n";
+
+        if (reflux_max == 0.0) {
+            amrex::Print() << "   FAILED: the reflux correction is zero, so nothing was compared\n";
+            pass = false;
+        }
+        if (reflux_diff > tol || aofs_diff > tol) {
+            amrex::Print() << "   FAILED: flux register and flux MultiFab results differ by more than tol\n";
+            pass = false;
+        }
+    }
+
+    return pass;
+}
@@ -0,0 +1,80 @@
+#include <aofs_test.H>
+
+#include <hydro_godunov.H>
+#include <hydro_mol.H>
+
+using namespace amrex;
+
+// ComputeAofs with fuse_boxes against the tiled ComputeAofs: aofs, the
+// fluxes and the edge states, for Godunov PLM, Godunov PPM and MOL.
+bool check_fused (AofsTestData& data, Real tol, int nsteps)
+{
+    const int ncomp = data.ncomp;
+    bool pass = true;
+
+    amrex::Print() << " Fused vs tiled ComputeAofs, " << data.grids.size() << " boxes"
+                   << (data.geom.IsRZ() ? ", RZ" : "") << "\n";
+    if (Gpu::notInLaunchRegion()) {
+        amrex::Print() << "   (not running on a GPU: both versions take the tiled path)\n";
+    }
+
+    const char* names[] = {"Godunov PLM", "Godunov PPM", "MOL"};
+    for (int scheme = 0; scheme < 3; ++scheme)
+    {
+        Array<MultiFab,2> aofs;
+        Array<Array<MultiFab,AMREX_SPACEDIM>,2> edge, flux;
+        for (int k = 0; k < 2; ++k) {
+            aofs[k].define(data.grids, data.dmap, ncomp, 0);
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                BoxArray const& fba = amrex::convert(data.grids, IntVect::TheDimensionVector(d));
+                edge[k][d].define(fba, data.dmap, ncomp, 0);
+                flux[k][d].define(fba, data.dmap, ncomp, 0);
+            }
+        }
+
+        auto compute_aofs = [&] (int k)
+        {
+            const bool fuse_boxes = (k == 1);
+            if (scheme < 2) {
+                Godunov::ComputeAofs(aofs[k], 0, ncomp, data.state, 0,
+                                     AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                                     AMREX_D_DECL(edge[k][0], edge[k][1], edge[k][2]), 0, false,
+                                     AMREX_D_DECL(flux[k][0], flux[k][1], flux[k][2]), 0,
+                                     data.fq, 0, data.divu, data.d_bc.data(), data.geom,
+                                     data.iconserv, data.dt, scheme == 1, true, false,
+                                     nullptr, fuse_boxes);
+            } else {
+                MOL::ComputeAofs(aofs[k], 0, ncomp, data.state, 0,
+                                 AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                                 AMREX_D_DECL(edge[k][0], edge[k][1], edge[k][2]), 0, false,
+                                 AMREX_D_DECL(flux[k][0], flux[k][1], flux[k][2]), 0,
+                                 data.divu, data.h_bc, data.d_bc.data(), data.d_iconserv,
+                                 data.geom, false, nullptr, fuse_boxes);
+            }
+        };
+
+        const Real tiled_time = time_calls([&] () { compute_aofs(0); }, nsteps);
+        const Real fused_time = time_calls([&] () { compute_aofs(1); }, nsteps);
+
+        Real aofs_diff = max_rel_diff(aofs[1], aofs[0], 0, ncomp);
+        Real flux_diff = 0.0;
+        Real edge_diff = 0.0;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            flux_diff = amrex::max(flux_diff, max_rel_diff(flux[1][d], flux[0][d], 0, ncomp));
+            edge_diff = amrex::max(edge_diff, max_rel_diff(edge[1][d], edge[0][d], 0, ncomp));
+        }
+
+        amrex::Print() << "   " << names[scheme] << ": time per call tiled " << tiled_time
+                       << ", fused " << fused_time
+                       << "; max relative difference aofs " << aofs_diff
+                       << ", fluxes " << flux_diff
+                       << ", edge states " << edge_diff << "\n";
+
+        if (aofs_diff > tol || flux_diff > tol || edge_diff > tol) {
+            amrex::Print() << "   FAILED: fused and tiled results differ by more than tol\n";
+            pass = false;
+        }
+    }
+
+    return pass;
+}
@@ -0,0 +1,79 @@
+#include <aofs_test.H>
+
+#include <hydro_utils.H>
+
+using namespace amrex;
+
+// ComputeAofs with exactly the ghost cells HydroUtils::RequiredGhostCells
+// asks for, against the same inputs with more ghost cells, for each scheme
+// without EB. The ghost cells hold the smooth functions of the valid cells,
+// so a scheme that reads no further than it declares gives the same
+// divergence, fluxes and edge states with both.
+bool check_ghost_cells (AofsTestData& data, Real tol, int nsteps)
+{
+    const int ncomp = data.ncomp;
+    bool pass = true;
+
+    amrex::Print() << " ComputeAofs with the required ghost cells vs extra ghost cells, "
+                   << data.grids.size() << " boxes"
+                   << (data.geom.IsRZ() ? ", RZ" : "") << "\n";
+
+    const AofsScheme cases[] = {
+        {"MOL",         HydroUtils::AdvectionScheme::MOL,     false},
+        {"Godunov PLM", HydroUtils::AdvectionScheme::Godunov, false},
+        {"Godunov PPM", HydroUtils::AdvectionScheme::Godunov, true},
+        {"BDS",         HydroUtils::AdvectionScheme::BDS,     false}
+    };
+
+    for (auto const& c : cases)
+    {
+        const HydroUtils::GhostCells ng =
+            HydroUtils::RequiredGhostCells(c.scheme, c.use_ppm, false,
+                                           HydroUtils::RedistType::NoRedist, false);
+        HydroUtils::GhostCells ng_extra;
+        ng_extra.state  = ng.state + 1;
+        ng_extra.forces = ng.forces + 2;
+        ng_extra.divu   = ng.divu + 2;
+        ng_extra.umac   = ng.umac + 1;
+
+        AofsTestData exact(data, ng);
+        AofsTestData extra(data, ng_extra);
+
+        Array<MultiFab,2> aofs;
+        Array<Array<MultiFab,AMREX_SPACEDIM>,2> edge, flux;
+        for (int k = 0; k < 2; ++k) {
+            aofs[k].define(data.grids, data.dmap, ncomp, 0);
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                BoxArray const& fba = amrex::convert(data.grids, IntVect::TheDimensionVector(d));
+                edge[k][d].define(fba, data.dmap, ncomp, 0);
+                flux[k][d].define(fba, data.dmap, ncomp, 0);
+            }
+        }
+
+        const Real exact_time = time_calls([&] () { compute_aofs(c, exact, aofs[0], edge[0], flux[0]); }, nsteps);
+        const Real extra_time = time_calls([&] () { compute_aofs(c, extra, aofs[1], edge[1], flux[1]); }, nsteps);
+
+        Real aofs_diff = max_rel_diff(aofs[0], aofs[1], 0, ncomp);
+        Real flux_diff = 0.0;
+        Real edge_diff = 0.0;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            flux_diff = amrex::max(flux_diff, max_rel_diff(flux[0][d], flux[1][d], 0, ncomp));
+            edge_diff = amrex::max(edge_diff, max_rel_diff(edge[0][d], edge[1][d], 0, ncomp));
+        }
+
+        amrex::Print() << "   " << c.name << ": ghost cells state " << ng.state
+                       << ", forces " << ng.forces << ", divu " << ng.divu
+                       << ", umac " << ng.umac
+                       << "; time per call " << exact_time << " vs " << extra_time
+                       << "; max relative difference aofs " << aofs_diff
+                       << ", fluxes " << flux_diff
+                       << ", edge states " << edge_diff << "\n";
+
+        if (aofs_diff > tol || flux_diff > tol || edge_diff > tol) {
+            amrex::Print() << "   FAILED: results with the required and with extra ghost cells differ by more than tol\n";
+            pass = false;
+        }
+    }
+
+    return pass;
+}
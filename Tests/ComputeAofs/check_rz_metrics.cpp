@@ -0,0 +1,145 @@
+#include <aofs_test.H>
+
+#include <hydro_utils.H>
+#include <hydro_utils_K.H>
+
+using namespace amrex;
+
+// The RZ metrics that HydroUtils::ComputeFluxes and ComputeDivergence
+// compute inline, instead of calling Geometry::GetFaceArea and GetVolume on
+// every box: first rz_face_area and rz_volume against those two, then
+// ComputeFluxes with area weighting against the fluxes without it times the
+// GetFaceArea areas, and ComputeDivergence of both against the divergence
+// with the GetVolume volumes. Only in RZ; passes without checking otherwise.
+bool check_rz_metrics (AofsTestData& data, Real tol, int nsteps)
+{
+    amrex::ignore_unused(nsteps);
+
+    if (!data.geom.IsRZ()) {
+        amrex::Print() << " RZ metrics: skipped, the geometry is not RZ\n";
+        return true;
+    }
+
+#if (AMREX_SPACEDIM == 2)
+    const int ncomp = data.ncomp;
+    bool pass = true;
+
+    amrex::Print() << " Inline RZ metrics vs Geometry::GetFaceArea and GetVolume, "
+                   << data.grids.size() << " boxes\n";
+
+    const auto dx     = data.geom.CellSizeArray();
+    const auto problo = data.geom.ProbLoArray();
+
+    MultiFab vol_ref;
+    data.geom.GetVolume(vol_ref, data.grids, data.dmap, 0);
+    MultiFab vol(data.grids, data.dmap, 1, 0);
+    {
+        auto const& v = vol.arrays();
+        ParallelFor(vol, [=] AMREX_GPU_DEVICE (int box, int i, int j, int k) noexcept
+        {
+            v[box](i,j,k) = HydroUtils::rz_volume(i,dx,problo);
+        });
+        Gpu::streamSynchronize();
+    }
+
+    const Real vol_diff = max_rel_diff(vol, vol_ref, 0, 1);
+    amrex::Print() << "   rz_volume: max relative difference " << vol_diff << "\n";
+    if (vol_diff > tol) {
+        amrex::Print() << "   FAILED: rz_volume and Geometry::GetVolume differ by more than tol\n";
+        pass = false;
+    }
+
+    Array<MultiFab,AMREX_SPACEDIM> area_ref;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d)
+    {
+        data.geom.GetFaceArea(area_ref[d], data.grids, data.dmap, d, 0);
+        MultiFab area(area_ref[d].boxArray(), data.dmap, 1, 0);
+        auto const& a = area.arrays();
+        ParallelFor(area, [=] AMREX_GPU_DEVICE (int box, int i, int j, int k) noexcept
+        {
+            a[box](i,j,k) = HydroUtils::rz_face_area(i,d,dx,problo);
+        });
+        Gpu::streamSynchronize();
+
+        const Real area_diff = max_rel_diff(area, area_ref[d], 0, 1);
+        amrex::Print() << "   rz_face_area, direction " << d
+                       << ": max relative difference " << area_diff << "\n";
+        if (area_diff > tol) {
+            amrex::Print() << "   FAILED: rz_face_area and Geometry::GetFaceArea differ by more than tol\n";
+            pass = false;
+        }
+    }
+
+    // Edge states to build the fluxes from: those of a Godunov ComputeAofs
+    MultiFab aofs(data.grids, data.dmap, ncomp, 0);
+    Array<MultiFab,AMREX_SPACEDIM> edge, flux, flux_aw;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        BoxArray const& fba = amrex::convert(data.grids, IntVect::TheDimensionVector(d));
+        edge[d].define(fba, data.dmap, ncomp, 0);
+        flux[d].define(fba, data.dmap, ncomp, 0);
+        flux_aw[d].define(fba, data.dmap, ncomp, 0);
+    }
+    compute_aofs({"Godunov PLM", HydroUtils::AdvectionScheme::Godunov, false},
+                 data, aofs, edge, flux);
+
+    MultiFab div(data.grids, data.dmap, ncomp, 0);
+    MultiFab div_aw(data.grids, data.dmap, ncomp, 0);
+
+    for (MFIter mfi(aofs,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        Box const& bx = mfi.tilebox();
+
+        HydroUtils::ComputeFluxes(bx, flux[0].array(mfi), flux[1].array(mfi),
+                                  data.umac[0].const_array(mfi), data.umac[1].const_array(mfi),
+                                  edge[0].const_array(mfi), edge[1].const_array(mfi),
+                                  data.geom, ncomp, false);
+        HydroUtils::ComputeFluxes(bx, flux_aw[0].array(mfi), flux_aw[1].array(mfi),
+                                  data.umac[0].const_array(mfi), data.umac[1].const_array(mfi),
+                                  edge[0].const_array(mfi), edge[1].const_array(mfi),
+                                  data.geom, ncomp, true);
+
+        HydroUtils::ComputeDivergence(bx, div.array(mfi),
+                                      flux[0].const_array(mfi), flux[1].const_array(mfi),
+                                      ncomp, data.geom, Real(1.0), false);
+        HydroUtils::ComputeDivergence(bx, div_aw.array(mfi),
+                                      flux_aw[0].const_array(mfi), flux_aw[1].const_array(mfi),
+                                      ncomp, data.geom, Real(1.0), true);
+    }
+    Gpu::streamSynchronize();
+
+    // Area weight the plain fluxes with the GetFaceArea areas
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        for (int n = 0; n < ncomp; ++n) {
+            MultiFab::Multiply(flux[d], area_ref[d], 0, n, 1, 0);
+        }
+    }
+
+    Real flux_diff = 0.0;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        flux_diff = amrex::max(flux_diff, max_rel_diff(flux_aw[d], flux[d], 0, ncomp));
+    }
+    amrex::Print() << "   ComputeFluxes: max relative difference area weighted fluxes "
+                   << flux_diff << "\n";
+    if (flux_diff > tol) {
+        amrex::Print() << "   FAILED: area weighted fluxes and fluxes times GetFaceArea differ by more than tol\n";
+        pass = false;
+    }
+
+    MultiFab div_ref(data.grids, data.dmap, ncomp, 0);
+    flux_divergence(div_ref, flux, data.geom);
+
+    const Real div_diff    = max_rel_diff(div, div_ref, 0, ncomp);
+    const Real div_aw_diff = max_rel_diff(div_aw, div_ref, 0, ncomp);
+    amrex::Print() << "   ComputeDivergence: max relative difference " << div_diff
+                   << ", area weighted " << div_aw_diff << "\n";
+    if (div_diff > tol || div_aw_diff > tol) {
+        amrex::Print() << "   FAILED: ComputeDivergence and div(fluxes) with GetVolume differ by more than tol\n";
+        pass = false;
+    }
+
+    return pass;
+#else
+    amrex::ignore_unused(tol);
+    return true;
+#endif
+}
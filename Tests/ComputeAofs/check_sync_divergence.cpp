@@ -0,0 +1,165 @@
+#include <aofs_test.H>
+
+#include <hydro_bds.H>
+#include <hydro_godunov.H>
+#include <hydro_mol.H>
+#include <hydro_utils.H>
+
+using namespace amrex;
+
+namespace {
+
+// aofs += div of the sync fluxes, for one scheme
+void compute_sync_aofs (AofsScheme const& s, AofsTestData& data, MultiFab& aofs,
+                        Array<MultiFab,AMREX_SPACEDIM> const& ucorr,
+                        Array<MultiFab,AMREX_SPACEDIM>& edge, Array<MultiFab,AMREX_SPACEDIM>& flux)
+{
+    const int ncomp = data.ncomp;
+    switch (s.scheme)
+    {
+    case HydroUtils::AdvectionScheme::MOL:
+        MOL::ComputeSyncAofs(aofs, 0, ncomp, data.state, 0,
+                             AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                             AMREX_D_DECL(ucorr[0], ucorr[1], ucorr[2]),
+                             AMREX_D_DECL(edge[0], edge[1], edge[2]), 0, false,
+                             AMREX_D_DECL(flux[0], flux[1], flux[2]), 0,
+                             data.h_bc, data.d_bc.data(), data.geom, false);
+        break;
+    case HydroUtils::AdvectionScheme::Godunov:
+        Godunov::ComputeSyncAofs(aofs, 0, ncomp, data.state, 0,
+                                 AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                                 AMREX_D_DECL(ucorr[0], ucorr[1], ucorr[2]),
+                                 AMREX_D_DECL(edge[0], edge[1], edge[2]), 0, false,
+                                 AMREX_D_DECL(flux[0], flux[1], flux[2]), 0,
+                                 data.fq, 0, data.divu, data.d_bc.data(), data.geom,
+                                 data.d_iconserv, data.dt, s.use_ppm, true, false);
+        break;
+    case HydroUtils::AdvectionScheme::BDS:
+        BDS::ComputeSyncAofs(aofs, 0, ncomp, data.state, 0,
+                             AMREX_D_DECL(data.umac[0], data.umac[1], data.umac[2]),
+                             AMREX_D_DECL(ucorr[0], ucorr[1], ucorr[2]),
+                             AMREX_D_DECL(edge[0], edge[1], edge[2]), 0, false,
+                             AMREX_D_DECL(flux[0], flux[1], flux[2]), 0,
+                             data.fq, 0, data.divu, data.d_bc.data(), data.geom,
+                             data.d_iconserv, data.dt, false);
+        break;
+    default:
+        amrex::Abort("compute_sync_aofs: unknown advection scheme");
+    }
+}
+
+}
+
+// HydroUtils::ComputeDivergence with accumulate = true, which the
+// ComputeSyncAofs of Godunov, MOL and BDS use to add the sync divergence
+// straight into aofs. First the kernel on its own: adding mult*div to aofs
+// must give the same bits as computing div into a temporary and adding it,
+// for both signs of mult and with and without area weighted fluxes. Then
+// ComputeSyncAofs, with aofs holding the forcing beforehand, against that
+// forcing plus the divergence of the returned sync fluxes.
+bool check_sync_divergence (AofsTestData& data, Real tol, int nsteps)
+{
+    amrex::ignore_unused(nsteps);
+
+    const int ncomp = data.ncomp;
+    bool pass = true;
+
+    amrex::Print() << " ComputeDivergence with accumulate and ComputeSyncAofs, "
+                   << data.grids.size() << " boxes"
+                   << (data.geom.IsRZ() ? ", RZ" : "") << "\n";
+
+    // Fluxes to take the divergence of: those of a Godunov ComputeAofs
+    MultiFab aofs(data.grids, data.dmap, ncomp, 0);
+    Array<MultiFab,AMREX_SPACEDIM> edge, flux;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        BoxArray const& fba = amrex::convert(data.grids, IntVect::TheDimensionVector(d));
+        edge[d].define(fba, data.dmap, ncomp, 0);
+        flux[d].define(fba, data.dmap, ncomp, 0);
+    }
+    compute_aofs({"Godunov PLM", HydroUtils::AdvectionScheme::Godunov, false},
+                 data, aofs, edge, flux);
+
+    for (int area_weighted = 0; area_weighted < 2; ++area_weighted)
+    {
+        for (Real mult : {Real(1.0), Real(-1.0)})
+        {
+            MultiFab acc(data.grids, data.dmap, ncomp, 0);
+            MultiFab sum(data.grids, data.dmap, ncomp, 0);
+            MultiFab::Copy(acc, data.fq, 0, 0, ncomp, 0);
+            MultiFab::Copy(sum, data.fq, 0, 0, ncomp, 0);
+
+            for (MFIter mfi(acc,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                Box const& bx = mfi.tilebox();
+                AMREX_D_TERM(auto const& fx = flux[0].const_array(mfi);,
+                             auto const& fy = flux[1].const_array(mfi);,
+                             auto const& fz = flux[2].const_array(mfi););
+
+                HydroUtils::ComputeDivergence(bx, acc.array(mfi), AMREX_D_DECL(fx, fy, fz),
+                                              ncomp, data.geom, mult, area_weighted == 1, true);
+
+                FArrayBox tmpfab(bx, ncomp, The_Async_Arena());
+                auto const& tmp = tmpfab.array();
+                HydroUtils::ComputeDivergence(bx, tmp, AMREX_D_DECL(fx, fy, fz),
+                                              ncomp, data.geom, mult, area_weighted == 1);
+                auto const& s = sum.array(mfi);
+                ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    s(i,j,k,n) += tmp(i,j,k,n);
+                });
+                Gpu::streamSynchronize();
+            }
+
+            MultiFab::Subtract(acc, sum, 0, 0, ncomp, 0);
+            const Real diff_max = acc.norminf(0, ncomp, IntVect(0));
+
+            amrex::Print() << "   ComputeDivergence, mult " << mult
+                           << (area_weighted ? ", area weighted" : "")
+                           << ": max difference accumulate vs temporary " << diff_max << "\n";
+
+            if (diff_max != 0.0) {
+                amrex::Print() << "   FAILED: accumulating and adding a temporary differ\n";
+                pass = false;
+            }
+        }
+    }
+
+    // The sync correction velocity only needs to be a face velocity
+    Array<MultiFab,AMREX_SPACEDIM> ucorr;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        ucorr[d].define(data.umac[d].boxArray(), data.dmap, 1, data.umac[d].nGrow());
+        MultiFab::Copy(ucorr[d], data.umac[d], 0, 0, 1, data.umac[d].nGrow());
+        ucorr[d].mult(0.1);
+    }
+
+    const AofsScheme cases[] = {
+        {"MOL",         HydroUtils::AdvectionScheme::MOL,     false},
+        {"Godunov PLM", HydroUtils::AdvectionScheme::Godunov, false},
+        {"Godunov PPM", HydroUtils::AdvectionScheme::Godunov, true},
+        {"BDS",         HydroUtils::AdvectionScheme::BDS,     false}
+    };
+
+    for (auto const& c : cases)
+    {
+        MultiFab sync(data.grids, data.dmap, ncomp, 0);
+        MultiFab::Copy(sync, data.fq, 0, 0, ncomp, 0);
+
+        compute_sync_aofs(c, data, sync, ucorr, edge, flux);
+
+        MultiFab sync_ref(data.grids, data.dmap, ncomp, 0);
+        flux_divergence(sync_ref, flux, data.geom);
+        MultiFab::Add(sync_ref, data.fq, 0, 0, ncomp, 0);
+
+        const Real sync_diff = max_rel_diff(sync, sync_ref, 0, ncomp);
+
+        amrex::Print() << "   " << c.name << " ComputeSyncAofs: max relative difference "
+                       << sync_diff << "\n";
+
+        if (sync_diff > tol) {
+            amrex::Print() << "   FAILED: ComputeSyncAofs and forcing plus div(fluxes) differ by more than tol\n";
+            pass = false;
+        }
+    }
+
+    return pass;
+}
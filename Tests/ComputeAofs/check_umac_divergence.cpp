@@ -0,0 +1,107 @@
+#include <aofs_test.H>
+
+#include <hydro_utils.H>
+#include <hydro_utils_K.H>
+
+#include <AMReX_MultiFabUtil.H>
+
+using namespace amrex;
+
+// The div(umac) that Godunov and BDS ComputeAofs compute inline for the
+// convective form, against amrex::computeDivergence, which they used to
+// call on a temporary: first HydroUtils::umac_divergence on its own, then
+// the whole aofs. The reference aofs is the divergence of the returned
+// fluxes, minus q div(umac) for the components in convective form, with q
+// the average of their returned edge states. Also in RZ.
+bool check_umac_divergence (AofsTestData& data, Real tol, int nsteps)
+{
+    amrex::ignore_unused(nsteps);
+
+    const int ncomp = data.ncomp;
+    bool pass = true;
+
+    amrex::Print() << " Inline div(umac) vs amrex::computeDivergence, "
+                   << data.grids.size() << " boxes"
+                   << (data.geom.IsRZ() ? ", RZ" : "") << "\n";
+
+    MultiFab divu_ref(data.grids, data.dmap, 1, 0);
+    amrex::computeDivergence(divu_ref, {AMREX_D_DECL(&data.umac[0], &data.umac[1], &data.umac[2])},
+                             data.geom);
+
+    MultiFab divu_inline(data.grids, data.dmap, 1, 0);
+    {
+        const auto dxinv  = data.geom.InvCellSizeArray();
+        const auto problo = data.geom.ProbLoArray();
+        const bool is_rz  = data.geom.IsRZ();
+        auto const& dv = divu_inline.arrays();
+        AMREX_D_TERM(auto const& u = data.umac[0].const_arrays();,
+                     auto const& v = data.umac[1].const_arrays();,
+                     auto const& w = data.umac[2].const_arrays(););
+        ParallelFor(divu_inline, [=] AMREX_GPU_DEVICE (int box, int i, int j, int k) noexcept
+        {
+            dv[box](i,j,k) = HydroUtils::umac_divergence(i,j,k,AMREX_D_DECL(u[box],v[box],w[box]),
+                                                         dxinv,problo,is_rz);
+        });
+        Gpu::streamSynchronize();
+    }
+
+    const Real kernel_diff = max_rel_diff(divu_inline, divu_ref, 0, 1);
+    amrex::Print() << "   umac_divergence: max relative difference " << kernel_diff << "\n";
+    if (kernel_diff > tol) {
+        amrex::Print() << "   FAILED: umac_divergence and amrex::computeDivergence differ by more than tol\n";
+        pass = false;
+    }
+
+    const AofsScheme cases[] = {
+        {"Godunov PLM", HydroUtils::AdvectionScheme::Godunov, false},
+        {"Godunov PPM", HydroUtils::AdvectionScheme::Godunov, true},
+        {"BDS",         HydroUtils::AdvectionScheme::BDS,     false}
+    };
+
+    for (auto const& c : cases)
+    {
+        MultiFab aofs(data.grids, data.dmap, ncomp, 0);
+        MultiFab aofs_ref(data.grids, data.dmap, ncomp, 0);
+        Array<MultiFab,AMREX_SPACEDIM> edge, flux;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            BoxArray const& fba = amrex::convert(data.grids, IntVect::TheDimensionVector(d));
+            edge[d].define(fba, data.dmap, ncomp, 0);
+            flux[d].define(fba, data.dmap, ncomp, 0);
+        }
+
+        compute_aofs(c, data, aofs, edge, flux);
+
+        flux_divergence(aofs_ref, flux, data.geom);
+
+        int const* iconserv = data.d_iconserv.data();
+        auto const& a  = aofs_ref.arrays();
+        auto const& dv = divu_ref.const_arrays();
+        AMREX_D_TERM(auto const& xed = edge[0].const_arrays();,
+                     auto const& yed = edge[1].const_arrays();,
+                     auto const& zed = edge[2].const_arrays(););
+        ParallelFor(aofs_ref, IntVect(0), ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            if (!iconserv[n])
+            {
+                const Real q = (AMREX_D_TERM(  xed[box](i,j,k,n) + xed[box](i+1,j,k,n),
+                                             + yed[box](i,j,k,n) + yed[box](i,j+1,k,n),
+                                             + zed[box](i,j,k,n) + zed[box](i,j,k+1,n)))
+                               / Real(2*AMREX_SPACEDIM);
+                a[box](i,j,k,n) -= q*dv[box](i,j,k);
+            }
+        });
+        Gpu::streamSynchronize();
+
+        const Real aofs_diff = max_rel_diff(aofs, aofs_ref, 0, ncomp);
+
+        amrex::Print() << "   " << c.name << ": max relative difference aofs " << aofs_diff << "\n";
+
+        if (aofs_diff > tol) {
+            amrex::Print() << "   FAILED: aofs and the reference with amrex::computeDivergence differ by more than tol\n";
+            pass = false;
+        }
+    }
+
+    return pass;
+}
@@ -0,0 +1,63 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+
+#include <aofs_test.H>
+
+#include <functional>
+#include <map>
+
+using namespace amrex;
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+
+    {
+        int nsteps = 10;
+        Real tol = 1.e-12;
+        Vector<std::string> checks;
+
+        std::map<std::string,std::function<bool(AofsTestData&,Real,int)>> all_checks{
+            {"fused", check_fused},
+            {"overlapped", check_overlapped},
+            {"ghost_cells", check_ghost_cells},
+            {"flux_register", check_flux_register},
+            {"conservation", check_conservation},
+            {"umac_divergence", check_umac_divergence},
+            {"sync_divergence", check_sync_divergence},
+            {"rz_metrics", check_rz_metrics},
+            {"dispatch", check_dispatch}
+        };
+        for (auto const& c : all_checks) {
+            checks.push_back(c.first);
+        }
+
+        // read parameters
+        {
+            ParmParse pp;
+            pp.query("nsteps", nsteps);
+            pp.query("tol", tol);
+            pp.queryarr("checks", checks);
+        }
+
+        AofsTestData data(4);
+
+        int nfail = 0;
+        for (auto const& c : checks) {
+            auto it = all_checks.find(c);
+            if (it == all_checks.end()) {
+                amrex::Abort("ComputeAofs: unknown check " + c);
+            }
+            if (!it->second(data, tol, nsteps)) {
+                ++nfail;
+            }
+        }
+
+        if (nfail > 0) {
+            amrex::Abort("ComputeAofs: " + std::to_string(nfail) + " check(s) failed");
+        }
+        amrex::Print() << " All checks passed" << std::endl;
+    }
+
+    amrex::Finalize();
+}
@@ -0,0 +1,80 @@
+#include <eb_test.H>
+
+#include <hydro_ebgodunov.H>
+
+using namespace amrex;
+
+// EBGodunov::ExtrapVelToFaces only sets the ghost faces of the mac
+// velocities before its tile loop, so every valid face must be written by
+// that loop: on regular, cut and covered tiles alike. It is called on mac
+// velocities holding 0 and on mac velocities holding 7; the results must be
+// the same bit for bit on all faces, ghost faces included. The boxes of each
+// type are counted, so that a problem without one of them fails rather
+// than passing without testing it. Run with DEBUG = TRUE to also catch
+// reads and writes outside the scratch, which is sized per tile type.
+bool check_extrap_vel (EBTestData& data)
+{
+    bool pass = true;
+
+    amrex::Print() << " EBGodunov::ExtrapVelToFaces on mac velocities holding 0 vs 7, "
+                   << data.grids.size() << " boxes\n";
+
+    // Same test on the flags as ExtrapVelToFaces
+    auto const& flags = data.factory->getMultiEBCellFlagFab();
+    int nregular = 0;
+    int ncut = 0;
+    int ncovered = 0;
+    for (MFIter mfi(data.vel); mfi.isValid(); ++mfi)
+    {
+        Box const& bx = mfi.validbox();
+        if (flags[mfi].getType(bx) == FabType::covered) {
+            ++ncovered;
+        } else if (flags[mfi].getType(amrex::grow(bx,3)) == FabType::regular) {
+            ++nregular;
+        } else {
+            ++ncut;
+        }
+    }
+    ParallelDescriptor::ReduceIntSum(nregular);
+    ParallelDescriptor::ReduceIntSum(ncut);
+    ParallelDescriptor::ReduceIntSum(ncovered);
+
+    Array<Array<MultiFab,AMREX_SPACEDIM>,2> umac;
+    for (int k = 0; k < 2; ++k)
+    {
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            umac[k][d].define(amrex::convert(data.grids, IntVect::TheDimensionVector(d)), data.dmap,
+                              1, 1, MFInfo(), *data.factory);
+            umac[k][d].setVal(k == 0 ? 0.0 : 7.0);
+        }
+
+        EBGodunov::ExtrapVelToFaces(data.vel, data.vel_forces,
+                                    AMREX_D_DECL(umac[k][0], umac[k][1], umac[k][2]),
+                                    data.h_bc, data.d_bc.data(), data.geom, data.dt);
+    }
+
+    Real diff_max = 0.0;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d)
+    {
+        MultiFab diff(umac[1][d].boxArray(), data.dmap, 1, 1);
+        MultiFab::Copy(diff, umac[1][d], 0, 0, 1, 1);
+        MultiFab::Subtract(diff, umac[0][d], 0, 0, 1, 1);
+        diff_max = amrex::max(diff_max, diff.norminf(0, 1, IntVect(1)));
+    }
+
+    amrex::Print() << "   regular boxes " << nregular << ", cut boxes " << ncut
+                   << ", covered boxes " << ncovered
+                   << "; max difference " << diff_max << "\n";
+
+    if (nregular == 0 || ncut == 0 || ncovered == 0) {
+        amrex::Print() << "   FAILED: there must be regular, cut and covered boxes;"
+                       << " change max_grid_size or the sphere\n";
+        pass = false;
+    }
+    if (diff_max != 0.0) {
+        amrex::Print() << "   FAILED: a face of the mac velocities was not written\n";
+        pass = false;
+    }
+
+    return pass;
+}
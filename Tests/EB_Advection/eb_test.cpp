@@ -0,0 +1,95 @@
+#include <eb_test.H>
+
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+EBTestData::EBTestData (int ngrow)
+{
+    int n_cell = 64;
+    int max_grid_size = 8;
+    Real sphere_radius = 0.25;
+    Vector<Real> sphere_center(AMREX_SPACEDIM, 0.5);
+    Vector<int> is_periodic(AMREX_SPACEDIM, 0);
+    is_periodic[0] = 1;
+
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("sphere_radius", sphere_radius);
+        pp.queryarr("sphere_center", sphere_center, 0, AMREX_SPACEDIM);
+        pp.queryarr("is_periodic", is_periodic, 0, AMREX_SPACEDIM);
+    }
+
+    Box domain(IntVect(AMREX_D_DECL(0,0,0)),
+               IntVect(AMREX_D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> periodic{AMREX_D_DECL(is_periodic[0],
+                                                    is_periodic[1],
+                                                    is_periodic[2])};
+    geom.define(domain, rb, CoordSys::cartesian, periodic);
+
+    grids.define(domain);
+    grids.maxSize(max_grid_size);
+    dmap.define(grids);
+
+    // The fluid is outside the sphere
+    RealArray center{AMREX_D_DECL(sphere_center[0], sphere_center[1], sphere_center[2])};
+    EB2::SphereIF sphere(sphere_radius, center, false);
+    auto gshop = EB2::makeShop(sphere);
+    EB2::Build(gshop, geom, 0, 100);
+
+    EB2::Level const& eb_level = EB2::IndexSpace::top().getLevel(geom);
+    // The redistribution reads the EB data 4 cells out
+    const int ng_eb = std::max(ngrow, 5);
+    factory = std::make_unique<EBFArrayBoxFactory>(eb_level, geom, grids, dmap,
+                                                   Vector<int>{ng_eb, ng_eb, ng_eb},
+                                                   EBSupport::full);
+
+    vel.define       (grids, dmap, AMREX_SPACEDIM, ngrow, MFInfo(), *factory);
+    vel_forces.define(grids, dmap, AMREX_SPACEDIM, ngrow, MFInfo(), *factory);
+
+    const auto problo = geom.ProbLoArray();
+    const auto dx     = geom.CellSizeArray();
+    const Real pi2    = 2.0*Math::pi<Real>();
+
+    for (MFIter mfi(vel); mfi.isValid(); ++mfi)
+    {
+        auto const& v = vel.array(mfi);
+        auto const& f = vel_forces.array(mfi);
+        ParallelFor(mfi.fabbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            AMREX_D_TERM(Real x = problo[0] + (i+0.5)*dx[0];,
+                         Real y = problo[1] + (j+0.5)*dx[1];,
+                         Real z = problo[2] + (k+0.5)*dx[2];);
+            AMREX_D_TERM(v(i,j,k,0) = 0.5 + 0.2*std::sin(pi2*y);,
+                         v(i,j,k,1) = 0.3*std::cos(pi2*x);,
+                         v(i,j,k,2) = 0.2*std::sin(pi2*x)*std::cos(pi2*z););
+            for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                f(i,j,k,n) = 0.1*(n+1)*std::cos(pi2*(x+y));
+            }
+        });
+    }
+
+    // the largest velocity is about 0.7, so this is an advective CFL of about 0.5
+    dt = 0.5*dx[0]/0.7;
+
+    h_bc.resize(AMREX_SPACEDIM);
+    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            if (geom.isPeriodic(d)) {
+                h_bc[n].setLo(d, BCType::int_dir);
+                h_bc[n].setHi(d, BCType::int_dir);
+            } else {
+                h_bc[n].setLo(d, BCType::ext_dir);
+                h_bc[n].setHi(d, BCType::foextrap);
+            }
+        }
+    }
+    d_bc.resize(AMREX_SPACEDIM);
+    Gpu::copy(Gpu::hostToDevice, h_bc.begin(), h_bc.end(), d_bc.begin());
+    Gpu::streamSynchronize();
+}
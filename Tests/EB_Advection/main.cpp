@@ -0,0 +1,52 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+
+#include <eb_test.H>
+
+#include <functional>
+#include <map>
+
+using namespace amrex;
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+
+    {
+        Vector<std::string> checks;
+
+        std::map<std::string,std::function<bool(EBTestData&)>> all_checks{
+            {"extrap_vel", check_extrap_vel},
+            {"redistribution", check_redistribution}
+        };
+        for (auto const& c : all_checks) {
+            checks.push_back(c.first);
+        }
+
+        // read parameters
+        {
+            ParmParse pp;
+            pp.queryarr("checks", checks);
+        }
+
+        EBTestData data(5);
+
+        int nfail = 0;
+        for (auto const& c : checks) {
+            auto it = all_checks.find(c);
+            if (it == all_checks.end()) {
+                amrex::Abort("EB_Advection: unknown check " + c);
+            }
+            if (!it->second(data)) {
+                ++nfail;
+            }
+        }
+
+        if (nfail > 0) {
+            amrex::Abort("EB_Advection: " + std::to_string(nfail) + " check(s) failed");
+        }
+        amrex::Print() << " All checks passed" << std::endl;
+    }
+
+    amrex::Finalize();
+}
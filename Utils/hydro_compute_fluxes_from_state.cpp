@@ -6,6 +6,8 @@
 #include <hydro_bds.H>
 #include <hydro_mol.H>
 #include <hydro_utils.H>
+#include <hydro_utils_K.H>
+#include <hydro_constants.H>
 
 #ifdef AMREX_USE_EB
 #include <hydro_ebgodunov.H>
@@ -37,7 +39,7 @@ HydroUtils::ComputeFluxesOnBoxFromState (Box const& bx, int ncomp, MFIter& mfi,
                                          const EBFArrayBoxFactory& ebfact,
                                          bool godunov_use_ppm, bool godunov_use_forces_in_trans,
                                          bool is_velocity, bool fluxes_are_area_weighted,
-                                         std::string& advection_type)
+                                         std::string const& advection_type)
 
 {
     ComputeFluxesOnBoxFromState(bx, ncomp, mfi, q,
@@ -54,6 +56,123 @@ HydroUtils::ComputeFluxesOnBoxFromState (Box const& bx, int ncomp, MFIter& mfi,
 #endif
 
 
+namespace {
+
+// Everything a scheme needs to fill the face states of one box
+struct FaceStateArgs
+{
+    Box bx;
+    int ncomp;
+    Array4<Real const> q;
+    GpuArray<Array4<Real>,AMREX_SPACEDIM> face;
+    GpuArray<Array4<Real const>,AMREX_SPACEDIM> vel;
+    Array4<Real const> divu;
+    Array4<Real const> fq;
+    Geometry const* geom;
+    Real dt;
+    Vector<BCRec> const* h_bcrec;
+    BCRec const* d_bcrec;
+    int const* iconserv;
+    bool godunov_use_ppm;
+    bool godunov_use_forces_in_trans;
+    bool is_velocity;
+#ifdef AMREX_USE_EB
+    bool regular;
+    EBFArrayBoxFactory const* ebfact;
+    Array4<EBCellFlag const> flag;
+    GpuArray<Array4<Real const>,AMREX_SPACEDIM> ap;
+    GpuArray<Array4<Real const>,AMREX_SPACEDIM> fc;
+    Array4<Real const> vfrac;
+    Array4<Real const> ccc;
+    Array4<Real const> values_on_eb_inflow;
+#endif
+};
+
+using FaceStateFn = void (*) (FaceStateArgs const& a);
+
+void
+mol_face_states (FaceStateArgs const& a)
+{
+#ifdef AMREX_USE_EB
+    if (!a.regular)
+        EBMOL::ComputeEdgeState( a.bx,
+                                 AMREX_D_DECL(a.face[0],a.face[1],a.face[2]),
+                                 a.q, a.ncomp,
+                                 AMREX_D_DECL(a.vel[0],a.vel[1],a.vel[2]),
+                                 a.geom->Domain(), *a.h_bcrec, a.d_bcrec,
+                                 AMREX_D_DECL(a.fc[0],a.fc[1],a.fc[2]),
+                                 a.ccc, a.vfrac, a.flag,
+                                 a.is_velocity);
+    else
+#endif
+        MOL::ComputeEdgeState( a.bx,
+                               AMREX_D_DECL(a.face[0],a.face[1],a.face[2]),
+                               a.q, a.ncomp,
+                               AMREX_D_DECL(a.vel[0],a.vel[1],a.vel[2]),
+                               a.geom->Domain(), *a.h_bcrec, a.d_bcrec,
+                               a.is_velocity);
+}
+
+void
+godunov_face_states (FaceStateArgs const& a)
+{
+#ifdef AMREX_USE_EB
+    if (!a.regular)
+    {
+        int ngrow = 4; // NOT SURE ABOUT THIS
+        FArrayBox tmpfab_v(amrex::grow(a.bx,ngrow),  (4*AMREX_SPACEDIM + 2)*a.ncomp);
+        Elixir    eli = tmpfab_v.elixir();
+
+        EBGodunov::ComputeEdgeState(a.bx, a.ncomp, a.q,
+                                    AMREX_D_DECL(a.face[0],a.face[1],a.face[2]),
+                                    AMREX_D_DECL(a.vel[0],a.vel[1],a.vel[2]),
+                                    a.divu, a.fq,
+                                    *a.geom, a.dt,
+                                    *a.h_bcrec, a.d_bcrec, a.iconserv,
+                                    tmpfab_v.dataPtr(), a.flag,
+                                    AMREX_D_DECL(a.ap[0],a.ap[1],a.ap[2]), a.vfrac,
+                                    AMREX_D_DECL(a.fc[0],a.fc[1],a.fc[2]), a.ccc,
+                                    a.is_velocity,
+                                    a.values_on_eb_inflow);
+    }
+    else
+#endif
+        Godunov::ComputeEdgeState(a.bx, a.ncomp, a.q,
+                                  AMREX_D_DECL(a.face[0],a.face[1],a.face[2]),
+                                  AMREX_D_DECL(a.vel[0],a.vel[1],a.vel[2]),
+                                  a.divu, a.fq,
+                                  *a.geom,
+                                  a.dt, a.d_bcrec, a.iconserv,
+                                  a.godunov_use_ppm, a.godunov_use_forces_in_trans,
+                                  a.is_velocity);
+}
+
+void
+bds_face_states (FaceStateArgs const& a)
+{
+#ifdef AMREX_USE_EB
+    if (!a.ebfact->isAllRegular()) Abort("BDS is not available with EB");
+#endif
+    BDS::ComputeEdgeState( a.bx, a.ncomp, a.q,
+                           AMREX_D_DECL(a.face[0],a.face[1],a.face[2]),
+                           AMREX_D_DECL(a.vel[0],a.vel[1],a.vel[2]),
+                           a.divu, a.fq, *a.geom,
+                           a.dt, a.d_bcrec, a.iconserv,
+                           a.is_velocity);
+}
+
+// Indexed by HydroUtils::AdvectionScheme
+constexpr FaceStateFn face_state_fns[] = { mol_face_states,
+                                           godunov_face_states,
+                                           bds_face_states };
+
+static_assert(sizeof(face_state_fns)/sizeof(FaceStateFn) ==
+              static_cast<std::size_t>(HydroUtils::AdvectionScheme::NumSchemes),
+              "face_state_fns needs one entry per AdvectionScheme");
+
+}
+
+
 void
 HydroUtils::ComputeFluxesOnBoxFromState (Box const& bx, int ncomp, MFIter& mfi,
                                          Array4<Real const> const& q,
@@ -61,7 +180,7 @@ HydroUtils::ComputeFluxesOnBoxFromState (Box const& bx, int ncomp, MFIter& mfi,
                                                       Array4<Real> const& flux_y,
                                                       Array4<Real> const& flux_z),
                                          AMREX_D_DECL(Array4<Real> const& face_x,
-                                         Array4<Real> const& face_y,
+                                                      Array4<Real> const& face_y,
                                                       Array4<Real> const& face_z),
                                          bool knownFaceState,
                                          AMREX_D_DECL(Array4<Real const> const& u_mac,
@@ -79,101 +198,107 @@ HydroUtils::ComputeFluxesOnBoxFromState (Box const& bx, int ncomp, MFIter& mfi,
 #endif
                                          bool godunov_use_ppm, bool godunov_use_forces_in_trans,
                                          bool is_velocity, bool fluxes_are_area_weighted,
-                                         std::string& advection_type)
+                                         std::string const& advection_type)
 
 {
+    ComputeFluxesOnBoxFromState(bx, ncomp, mfi, q,
+                                AMREX_D_DECL(flux_x, flux_y, flux_z),
+                                AMREX_D_DECL(face_x, face_y, face_z),
+                                knownFaceState,
+                                AMREX_D_DECL(u_mac, v_mac, w_mac),
+                                divu, fq, geom, l_dt, h_bcrec, d_bcrec, iconserv,
 #ifdef AMREX_USE_EB
-    EBCellFlagFab const& flagfab = ebfact.getMultiEBCellFlagFab()[mfi];
-    Array4<EBCellFlag const> const& flag = flagfab.const_array();
+                                ebfact, values_on_eb_inflow,
+#endif
+                                godunov_use_ppm, godunov_use_forces_in_trans,
+                                is_velocity, fluxes_are_area_weighted,
+                                AdvectionSchemeFromString(advection_type));
+}
+
+
+void
+HydroUtils::ComputeFluxesOnBoxFromState (Box const& bx, int ncomp, MFIter& mfi,
+                                         Array4<Real const> const& q,
+                                         AMREX_D_DECL(Array4<Real> const& flux_x,
+                                                      Array4<Real> const& flux_y,
+                                                      Array4<Real> const& flux_z),
+                                         AMREX_D_DECL(Array4<Real> const& face_x,
+                                                      Array4<Real> const& face_y,
+                                                      Array4<Real> const& face_z),
+                                         bool knownFaceState,
+                                         AMREX_D_DECL(Array4<Real const> const& u_mac,
+                                                      Array4<Real const> const& v_mac,
+                                                      Array4<Real const> const& w_mac),
+                                         Array4<Real const> const& divu,
+                                         Array4<Real const> const& fq,
+                                         Geometry geom, Real l_dt,
+                                         Vector<BCRec> const& h_bcrec,
+                                         const BCRec* d_bcrec,
+                                         int const* iconserv,
+#ifdef AMREX_USE_EB
+                                         const EBFArrayBoxFactory& ebfact,
+                                         Array4<Real const> const& values_on_eb_inflow,
+#endif
+                                         bool godunov_use_ppm, bool godunov_use_forces_in_trans,
+                                         bool is_velocity, bool fluxes_are_area_weighted,
+                                         AdvectionScheme advection_scheme)
 
-    Array4<Real const> AMREX_D_DECL(fcx, fcy, fcz), ccc, vfrac, AMREX_D_DECL(apx, apy, apz);
+{
+    FaceStateArgs a;
+    a.bx = bx;
+    a.ncomp = ncomp;
+    a.q = q;
+    a.face = {AMREX_D_DECL(face_x,face_y,face_z)};
+    a.vel  = {AMREX_D_DECL(u_mac,v_mac,w_mac)};
+    a.divu = divu;
+    a.fq = fq;
+    a.geom = &geom;
+    a.dt = l_dt;
+    a.h_bcrec = &h_bcrec;
+    a.d_bcrec = d_bcrec;
+    a.iconserv = iconserv;
+    a.godunov_use_ppm = godunov_use_ppm;
+    a.godunov_use_forces_in_trans = godunov_use_forces_in_trans;
+    a.is_velocity = is_velocity;
+
+#ifdef AMREX_USE_EB
+    EBCellFlagFab const& flagfab = ebfact.getMultiEBCellFlagFab()[mfi];
 
     // If entire box is covered, don't do anything and return
     if (flagfab.getType(bx) == FabType::covered)
         return;
 
-    //FIXME? -- Godunov needs to check on grow 3, but MOL only needs 2
-    bool regular = (flagfab.getType(amrex::grow(bx,3)) == FabType::regular);
+    // The box is regular if the stencil of the regular face states does not
+    // see any cut cell
+    const int halo = RequiredGhostCells(advection_scheme, godunov_use_ppm, false,
+                                        RedistType::NoRedist, false).state;
+    const bool regular = (flagfab.getType(amrex::grow(bx,halo)) == FabType::regular);
+
+    a.regular = regular;
+    a.ebfact = &ebfact;
+    a.flag = flagfab.const_array();
+    a.values_on_eb_inflow = values_on_eb_inflow;
 
     if (!regular)
     {
-        vfrac = ebfact.getVolFrac().const_array(mfi);
-        ccc   = ebfact.getCentroid().const_array(mfi);
+        a.vfrac = ebfact.getVolFrac().const_array(mfi);
+        a.ccc   = ebfact.getCentroid().const_array(mfi);
 
-        AMREX_D_TERM( apx = ebfact.getAreaFrac()[0]->const_array(mfi);,
-                      apy = ebfact.getAreaFrac()[1]->const_array(mfi);,
-                      apz = ebfact.getAreaFrac()[2]->const_array(mfi););
-
-        AMREX_D_TERM( fcx = ebfact.getFaceCent()[0]->const_array(mfi);,
-                      fcy = ebfact.getFaceCent()[1]->const_array(mfi);,
-                      fcz = ebfact.getFaceCent()[2]->const_array(mfi););
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            a.ap[dir] = ebfact.getAreaFrac()[dir]->const_array(mfi);
+            a.fc[dir] = ebfact.getFaceCent()[dir]->const_array(mfi);
+        }
     }
+#else
+    amrex::ignore_unused(mfi);
 #endif
 
     if (!knownFaceState) {
-        if (advection_type == "MOL")
-        {
-#ifdef AMREX_USE_EB
-            if (!regular)
-                EBMOL::ComputeEdgeState( bx,
-                                         AMREX_D_DECL(face_x,face_y,face_z),
-                                         q, ncomp,
-                                         AMREX_D_DECL(u_mac,v_mac,w_mac),
-                                         geom.Domain(), h_bcrec, d_bcrec,
-                                         AMREX_D_DECL(fcx,fcy,fcz),
-                                         ccc, vfrac, flag,
-                                         is_velocity);
-            else
-#endif
-                MOL::ComputeEdgeState( bx,
-                                       AMREX_D_DECL(face_x,face_y,face_z),
-                                       q, ncomp,
-                                       AMREX_D_DECL(u_mac,v_mac,w_mac),
-                                       geom.Domain(), h_bcrec, d_bcrec,
-                                               is_velocity);
-
-        } else if (advection_type == "Godunov") {
-
-            int ngrow = 4; // NOT SURE ABOUT THIS
-            FArrayBox tmpfab_v(amrex::grow(bx,ngrow),  (4*AMREX_SPACEDIM + 2)*ncomp);
-            Elixir    eli = tmpfab_v.elixir();
-#ifdef AMREX_USE_EB
-            if (!regular)
-                EBGodunov::ComputeEdgeState(bx, ncomp, q,
-                                            AMREX_D_DECL(face_x,face_y,face_z),
-                                            AMREX_D_DECL(u_mac,v_mac,w_mac),
-                                            divu, fq,
-                                            geom, l_dt,
-                                            h_bcrec, d_bcrec, iconserv,
-                                            tmpfab_v.dataPtr(), flag,
-                                            AMREX_D_DECL(apx,apy,apz), vfrac,
-                                            AMREX_D_DECL(fcx,fcy,fcz), ccc,
-                                            is_velocity,
-                                            values_on_eb_inflow);
-            else
-#endif
-
-                Godunov::ComputeEdgeState(bx, ncomp, q,
-                                          AMREX_D_DECL(face_x,face_y,face_z),
-                                          AMREX_D_DECL(u_mac,v_mac,w_mac),
-                                          divu, fq,
-                                          geom,
-                                          l_dt, d_bcrec, iconserv,
-                                          godunov_use_ppm, godunov_use_forces_in_trans,
-                                             is_velocity);
-        } else if (advection_type == "BDS") {
-#ifdef AMREX_USE_EB
-            if (!ebfact.isAllRegular()) Abort("BDS is not available with EB");
-#endif
-            BDS::ComputeEdgeState( bx, ncomp, q,
-                                   AMREX_D_DECL(face_x,face_y,face_z),
-                                   AMREX_D_DECL(u_mac,v_mac,w_mac),
-                                   divu, fq, geom,
-                                   l_dt, d_bcrec, iconserv,
-                                   is_velocity);
-        } else {
-            Abort("Unknown advection_type: "+advection_type);
-        } // test advection type
+        const auto ischeme = static_cast<int>(advection_scheme);
+        if (ischeme < 0 || ischeme >= static_cast<int>(AdvectionScheme::NumSchemes)) {
+            Abort("ComputeFluxesOnBoxFromState: unknown advection scheme");
+        }
+        face_state_fns[ischeme](a);
     } // known face state
 
     // Compute fluxes
@@ -183,9 +308,9 @@ HydroUtils::ComputeFluxesOnBoxFromState (Box const& bx, int ncomp, MFIter& mfi,
                                       AMREX_D_DECL(flux_x,flux_y,flux_z),
                                       AMREX_D_DECL(u_mac,v_mac,w_mac),
                                       AMREX_D_DECL(face_x,face_y,face_z),
-                                      AMREX_D_DECL(apx,apy,apz),
+                                      AMREX_D_DECL(a.ap[0],a.ap[1],a.ap[2]),
                                       geom, ncomp,
-                                      flag, fluxes_are_area_weighted);
+                                      a.flag, fluxes_are_area_weighted);
     } else
 #endif
     {
@@ -196,4 +321,226 @@ HydroUtils::ComputeFluxesOnBoxFromState (Box const& bx, int ncomp, MFIter& mfi,
                                    geom, ncomp, fluxes_are_area_weighted );
     }
 }
+
+void
+HydroUtils::ComputeFluxesFromStateOverlapped (MultiFab& div, int div_comp, int ncomp,
+                                              MultiFab& state, int state_comp,
+                                              AMREX_D_DECL(MultiFab& flux_x,
+                                                           MultiFab& flux_y,
+                                                           MultiFab& flux_z),
+                                              int fluxes_comp,
+                                              AMREX_D_DECL(MultiFab& face_x,
+                                                           MultiFab& face_y,
+                                                           MultiFab& face_z),
+                                              int face_comp,
+                                              AMREX_D_DECL(MultiFab const& u_mac,
+                                                           MultiFab const& v_mac,
+                                                           MultiFab const& w_mac),
+                                              MultiFab const& divu,
+                                              MultiFab const& fq,
+                                              Geometry const& geom, Real l_dt,
+                                              Vector<BCRec> const& h_bcrec,
+                                              const BCRec* d_bcrec,
+                                              int const* iconserv,
+#ifdef AMREX_USE_EB
+                                              const EBFArrayBoxFactory& ebfact,
+#endif
+                                              bool godunov_use_ppm, bool godunov_use_forces_in_trans,
+                                              bool is_velocity, bool fluxes_are_area_weighted,
+                                              std::string const& advection_type)
+{
+    BL_PROFILE("HydroUtils::ComputeFluxesFromStateOverlapped()");
+
+    AMREX_ALWAYS_ASSERT(div.nComp()   >= div_comp   + ncomp);
+    AMREX_ALWAYS_ASSERT(state.nComp() >= state_comp + ncomp);
+    AMREX_D_TERM( AMREX_ALWAYS_ASSERT(flux_x.nComp() >= fluxes_comp + ncomp);,
+                  AMREX_ALWAYS_ASSERT(flux_y.nComp() >= fluxes_comp + ncomp);,
+                  AMREX_ALWAYS_ASSERT(flux_z.nComp() >= fluxes_comp + ncomp););
+    AMREX_D_TERM( AMREX_ALWAYS_ASSERT(face_x.nComp() >= face_comp + ncomp);,
+                  AMREX_ALWAYS_ASSERT(face_y.nComp() >= face_comp + ncomp);,
+                  AMREX_ALWAYS_ASSERT(face_z.nComp() >= face_comp + ncomp););
+
+#ifdef AMREX_USE_EB
+    const bool all_regular = ebfact.isAllRegular();
+    auto const& vfrac = ebfact.getVolFrac();
+#else
+    const bool all_regular = true;
+#endif
+    const AdvectionScheme advection_scheme = AdvectionSchemeFromString(advection_type);
+    AMREX_ALWAYS_ASSERT(state.nGrow() >= RequiredGhostCells(advection_scheme, godunov_use_ppm, !all_regular,
+                                                            RedistType::NoRedist, false).state);
+
+    // Only regular tiles are split, so the interior is that of the regular stencil
+    const int halo = RequiredGhostCells(advection_scheme, godunov_use_ppm, false,
+                                        RedistType::NoRedist, false).state;
+
+    // We compute -div, as ComputeAofs does before redistribution
+    Real mult = -1.0;
+
+    const auto dxinv  = geom.InvCellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const bool is_rz  = geom.IsRZ();
+
+    //
+    // Pass 0 runs while the state halo exchange is in flight. On the cells of
+    // each tile whose stencil only reaches valid cells of their own box, it
+    // computes the face states, the fluxes on their faces and the divergence.
+    // Pass 1 finishes the exchange and does the same on the strips of the
+    // shell along the box boundary, one call per strip. The faces a strip
+    // shares with the interior or with another strip are recomputed from the
+    // same stencil, so they are overwritten with identical values.
+    //
+    // With EB the face-state routines pick the regular or the cut-cell scheme
+    // from the box they are given, so a strip far from the EB could use a
+    // different scheme than the tile it belongs to. Tiles whose stencil sees
+    // a cut or covered cell are therefore not split: they are done whole in
+    // pass 1, as in ComputeAofs.
+    //
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        if (pass == 1) {
+            state.FillBoundary_finish();
+        }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(div,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            const Box interior = bx & amrex::grow(mfi.validbox(),-halo);
+
+            bool split = interior.ok();
+#ifdef AMREX_USE_EB
+            if (!all_regular) {
+                split = split && (ebfact.getMultiEBCellFlagFab()[mfi].getType(amrex::grow(bx,halo))
+                                  == FabType::regular);
+            }
+#endif
+
+            if (pass == 0 && !split) {
+                continue;
+            }
+
+            AMREX_D_TERM( Array4<Real> fx = flux_x.array(mfi,fluxes_comp);,
+                          Array4<Real> fy = flux_y.array(mfi,fluxes_comp);,
+                          Array4<Real> fz = flux_z.array(mfi,fluxes_comp););
+
+            AMREX_D_TERM( Array4<Real> xed = face_x.array(mfi,face_comp);,
+                          Array4<Real> yed = face_y.array(mfi,face_comp);,
+                          Array4<Real> zed = face_z.array(mfi,face_comp););
+
+            AMREX_D_TERM( Array4<Real const> u = u_mac.const_array(mfi);,
+                          Array4<Real const> v = v_mac.const_array(mfi);,
+                          Array4<Real const> w = w_mac.const_array(mfi););
+
+            BoxList div_boxes;
+            if (pass == 0) {
+                div_boxes.push_back(interior);
+            } else if (split) {
+                div_boxes = amrex::boxDiff(bx, interior);
+            } else {
+                div_boxes.push_back(bx);
+            }
+
+            for (Box const& b : div_boxes)
+            {
+                ComputeFluxesOnBoxFromState(b, ncomp, mfi,
+                                            state.const_array(mfi,state_comp),
+                                            AMREX_D_DECL(fx, fy, fz),
+                                            AMREX_D_DECL(xed, yed, zed),
+                                            false,
+                                            AMREX_D_DECL(u, v, w),
+                                            divu.const_array(mfi),
+                                            fq.const_array(mfi),
+                                            geom, l_dt, h_bcrec, d_bcrec, iconserv,
+#ifdef AMREX_USE_EB
+                                            ebfact, Array4<Real const>{},
+#endif
+                                            godunov_use_ppm, godunov_use_forces_in_trans,
+                                            is_velocity, fluxes_are_area_weighted,
+                                            advection_scheme);
+            }
+
+            auto const& div_arr = div.array(mfi,div_comp);
+#ifdef AMREX_USE_EB
+            const FabType typ = ebfact.getMultiEBCellFlagFab()[mfi].getType(bx);
+            Array4<Real const> vfrac_arr;
+            AMREX_D_TERM( Array4<Real const> apx;,
+                          Array4<Real const> apy;,
+                          Array4<Real const> apz;);
+            if (typ == FabType::singlevalued) {
+                vfrac_arr = vfrac.const_array(mfi);
+                AMREX_D_TERM( apx = ebfact.getAreaFrac()[0]->const_array(mfi);,
+                              apy = ebfact.getAreaFrac()[1]->const_array(mfi);,
+                              apz = ebfact.getAreaFrac()[2]->const_array(mfi););
+            }
+#endif
+
+            for (Box const& b : div_boxes)
+            {
+#ifdef AMREX_USE_EB
+                if (typ == FabType::covered)
+                {
+                    amrex::ParallelFor(b, ncomp, [div_arr] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                    { div_arr(i,j,k,n) = covered_val; });
+                    continue;
+                }
+                else if (typ != FabType::regular)
+                {
+                    HydroUtils::EB_ComputeDivergence( b, div_arr,
+                                                      AMREX_D_DECL(fx, fy, fz),
+                                                      vfrac_arr, ncomp, geom,
+                                                      mult, fluxes_are_area_weighted);
+
+                    // Convective form: add back q div(umac), with q the area
+                    // weighted average of the face states
+                    amrex::ParallelFor(b, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                    {
+                        if (!iconserv[n] && vfrac_arr(i,j,k) != 0)
+                        {
+                            Real q = xed(i,j,k,n)*apx(i,j,k) + xed(i+1,j,k,n)*apx(i+1,j,k)
+                                   + yed(i,j,k,n)*apy(i,j,k) + yed(i,j+1,k,n)*apy(i,j+1,k);
+#if (AMREX_SPACEDIM == 2)
+                            q /= (apx(i,j,k)+apx(i+1,j,k)+apy(i,j,k)+apy(i,j+1,k));
+#else
+                            q += zed(i,j,k,n)*apz(i,j,k) + zed(i,j,k+1,n)*apz(i,j,k+1);
+                            q /= (apx(i,j,k)+apx(i+1,j,k)+apy(i,j,k)+apy(i,j+1,k)+apz(i,j,k)+apz(i,j,k+1));
+#endif
+                            Real divu_c = ( AMREX_D_TERM(  dxinv[0] * (apx(i+1,j,k)*u(i+1,j,k) - apx(i,j,k)*u(i,j,k)),
+                                                         + dxinv[1] * (apy(i,j+1,k)*v(i,j+1,k) - apy(i,j,k)*v(i,j,k)),
+                                                         + dxinv[2] * (apz(i,j,k+1)*w(i,j,k+1) - apz(i,j,k)*w(i,j,k))) )
+                                          / vfrac_arr(i,j,k);
+                            div_arr(i,j,k,n) += q*divu_c;
+                        }
+                    });
+                    continue;
+                }
+#endif
+                HydroUtils::ComputeDivergence( b, div_arr,
+                                               AMREX_D_DECL(fx, fy, fz),
+                                               ncomp, geom,
+                                               mult, fluxes_are_area_weighted);
+
+                // Convective form: add back q div(umac), with q the average of the face states
+                amrex::ParallelFor(b, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    if (!iconserv[n])
+                    {
+                        Real q = xed(i,j,k,n) + xed(i+1,j,k,n)
+                               + yed(i,j,k,n) + yed(i,j+1,k,n);
+#if (AMREX_SPACEDIM == 2)
+                        q *= 0.25;
+#else
+                        q += zed(i,j,k,n) + zed(i,j,k+1,n);
+                        q /= 6.0;
+#endif
+                        div_arr(i,j,k,n) += q*HydroUtils::umac_divergence(i,j,k,AMREX_D_DECL(u,v,w),
+                                                                           dxinv,problo,is_rz);
+                    }
+                });
+            }
+        }
+    }
+}
 /** @}*/
@@ -26,7 +26,7 @@ HydroUtils::ExtrapVelToFaces ( amrex::MultiFab const& vel,
                                amrex::Real dt,
                                const EBFArrayBoxFactory& ebfact,
                                bool godunov_ppm, bool godunov_use_forces_in_trans,
-                               std::string advection_type)
+                               std::string const& advection_type)
 {
    ExtrapVelToFaces(vel, vel_forces, AMREX_D_DECL(u_mac,v_mac,w_mac),
                     h_bcrec, d_bcrec, geom, dt,
@@ -51,9 +51,37 @@ HydroUtils::ExtrapVelToFaces ( amrex::MultiFab const& vel,
                                amrex::MultiFab const* velocity_on_eb_inflow,
 #endif
                                bool godunov_ppm, bool godunov_use_forces_in_trans,
-                               std::string advection_type)
+                               std::string const& advection_type)
 {
-    if (advection_type == "Godunov") {
+    ExtrapVelToFaces(vel, vel_forces, AMREX_D_DECL(u_mac,v_mac,w_mac),
+                     h_bcrec, d_bcrec, geom, dt,
+#ifdef AMREX_USE_EB
+                     ebfact, velocity_on_eb_inflow,
+#endif
+                     godunov_ppm, godunov_use_forces_in_trans,
+                     AdvectionSchemeFromString(advection_type));
+}
+
+void
+HydroUtils::ExtrapVelToFaces ( amrex::MultiFab const& vel,
+                               amrex::MultiFab const& vel_forces,
+                               AMREX_D_DECL(amrex::MultiFab& u_mac,
+                                            amrex::MultiFab& v_mac,
+                                            amrex::MultiFab& w_mac),
+                               amrex::Vector<amrex::BCRec> const& h_bcrec,
+                               amrex::BCRec  const* d_bcrec,
+                               amrex::Geometry& geom,
+                               amrex::Real dt,
+#ifdef AMREX_USE_EB
+                               const EBFArrayBoxFactory& ebfact,
+                               amrex::MultiFab const* velocity_on_eb_inflow,
+#endif
+                               bool godunov_ppm, bool godunov_use_forces_in_trans,
+                               AdvectionScheme advection_scheme)
+{
+    switch (advection_scheme)
+    {
+    case AdvectionScheme::Godunov:
 #ifdef AMREX_USE_EB
         if (!ebfact.isAllRegular())
             EBGodunov::ExtrapVelToFaces(vel, vel_forces,
@@ -66,16 +94,18 @@ HydroUtils::ExtrapVelToFaces ( amrex::MultiFab const& vel,
                                       AMREX_D_DECL(u_mac, v_mac, w_mac),
                                       h_bcrec, d_bcrec,
                                       geom, dt, godunov_ppm, godunov_use_forces_in_trans);
+        break;
 
-    } else if (advection_type == "MOL") {
-
+    case AdvectionScheme::MOL:
 #ifdef AMREX_USE_EB
         if (!ebfact.isAllRegular())
             EBMOL::ExtrapVelToFaces(vel, AMREX_D_DECL(u_mac, v_mac, w_mac), geom, h_bcrec, d_bcrec);
         else
 #endif
             MOL::ExtrapVelToFaces(vel, AMREX_D_DECL(u_mac, v_mac, w_mac), geom, h_bcrec, d_bcrec);
-    } else {
+        break;
+
+    default:
         amrex::Abort("Dont know this advection_type in HydroUtils::ExtrapVelToFaces");
     }
 }
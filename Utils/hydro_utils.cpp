@@ -3,9 +3,177 @@
  */
 
 #include <hydro_utils.H>
+#include <hydro_utils_K.H>
+
+#include <AMReX_MFParallelFor.H>
 
 using namespace amrex;
 
+HydroUtils::AdvectionScheme
+HydroUtils::AdvectionSchemeFromString (std::string const& advection_type)
+{
+    if (advection_type == "MOL") {
+        return AdvectionScheme::MOL;
+    } else if (advection_type == "Godunov") {
+        return AdvectionScheme::Godunov;
+    } else if (advection_type == "BDS") {
+        return AdvectionScheme::BDS;
+    }
+    Abort("Unknown advection_type: "+advection_type);
+    return AdvectionScheme::NumSchemes;
+}
+
+
+HydroUtils::RedistType
+HydroUtils::RedistTypeFromString (std::string const& redistribution_type)
+{
+    if (redistribution_type == "NoRedist") {
+        return RedistType::NoRedist;
+    } else if (redistribution_type == "FluxRedist") {
+        return RedistType::FluxRedist;
+    } else if (redistribution_type == "StateRedist") {
+        return RedistType::StateRedist;
+    }
+    Abort("Not a legit redist_type: "+redistribution_type);
+    return RedistType::NoRedist;
+}
+
+
+HydroUtils::GhostCells
+HydroUtils::RequiredGhostCells ( std::string const& advection_type,
+                                 bool godunov_use_ppm,
+                                 bool eb,
+                                 std::string const& redistribution_type,
+                                 bool known_edgestate )
+{
+    return RequiredGhostCells(AdvectionSchemeFromString(advection_type),
+                              godunov_use_ppm,
+                              eb,
+                              RedistTypeFromString(redistribution_type),
+                              known_edgestate);
+}
+
+
+HydroUtils::GhostCells
+HydroUtils::RequiredGhostCells ( AdvectionScheme advection_scheme,
+                                 bool godunov_use_ppm,
+                                 bool eb,
+                                 RedistType redistribution_type,
+                                 bool known_edgestate )
+{
+    amrex::ignore_unused(godunov_use_ppm);
+
+    GhostCells ng;
+
+    if (!known_edgestate)
+    {
+        switch (advection_scheme)
+        {
+        case AdvectionScheme::MOL:
+            // The face state on i-1/2 uses the slopes of i-1 and i, which
+            // reach one cell further. umac is only read on the face itself.
+            ng.state = 2;
+            break;
+        case AdvectionScheme::Godunov:
+        case AdvectionScheme::BDS:
+            // The transverse terms predict states on the faces of grow(bx,1),
+            // and both PLM with 4th order slopes and PPM reach two more cells.
+            // umac, divu and the forces are read on grow(bx,1).
+            ng.state  = 3;
+            ng.forces = 1;
+            ng.divu   = 1;
+            ng.umac   = 1;
+            // The EB slopes of EBGodunov reach one cell further, as its
+            // scratch on grow(bx,4) does
+            if (eb && advection_scheme == AdvectionScheme::Godunov) {
+                ng.state = 4;
+            }
+            break;
+        default:
+            Abort("RequiredGhostCells: unknown advection scheme");
+        }
+    }
+
+    // State redistribution builds U_in + dt*dUdt_in on grow(bx,3)
+    if (eb && redistribution_type == RedistType::StateRedist) {
+        ng.state = std::max(ng.state, 3);
+    }
+
+    return ng;
+}
+
+
+HydroUtils::AdvectionDiagnosticsReduction::AdvectionDiagnosticsReduction ( int ncomp,
+                                                                          Geometry const& geom,
+                                                                          bool fluxes_are_area_weighted )
+    : m_ncomp(ncomp)
+{
+    const auto dx = geom.CellSizeArray();
+    const Box& domain = geom.Domain();
+
+    m_metrics.dx     = dx;
+    m_metrics.problo = geom.ProbLoArray();
+    m_metrics.vol    = AMREX_D_TERM(dx[0], *dx[1], *dx[2]);
+    m_metrics.is_rz  = geom.IsRZ();
+    m_metrics.fluxes_are_area_weighted = fluxes_are_area_weighted;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
+    {
+        // Same face areas as ComputeFluxes; the RZ ones are computed in the kernel
+        m_metrics.area[dir] = fluxes_are_area_weighted ? Real(1.0) : m_metrics.vol / dx[dir];
+        m_metrics.domlo[dir] = domain.smallEnd(dir);
+        m_metrics.domhi[dir] = domain.bigEnd(dir);
+        m_metrics.is_periodic[dir] = geom.isPeriodic(dir);
+    }
+
+    const int npass = (ncomp + ncomp_per_pass - 1) / ncomp_per_pass;
+    m_data.resize(npass);
+    for (auto& d : m_data) {
+        d = std::make_unique<ReduceDataType>(m_op);
+    }
+}
+
+void
+HydroUtils::AdvectionDiagnosticsReduction::finalize (AdvectionDiagnostics& diag)
+{
+    Array<Real,AMREX_SPACEDIM+1> rmax{};
+    bool has_nan = false;
+    Vector<Real> sums(2*m_ncomp, Real(0.0));
+
+    for (int pass = 0; pass < static_cast<int>(m_data.size()); ++pass)
+    {
+        auto const& hv = m_data[pass]->value(m_op);
+        if (pass == 0) {
+            rmax = {AMREX_D_DECL(amrex::get<0>(hv),
+                                 amrex::get<1>(hv),
+                                 amrex::get<2>(hv)),
+                    amrex::get<AMREX_SPACEDIM>(hv)};
+            has_nan = amrex::get<AMREX_SPACEDIM+1>(hv);
+        }
+
+        constexpr int s = AMREX_SPACEDIM+2;
+        const Array<Real,2*ncomp_per_pass> ps{amrex::get<s  >(hv), amrex::get<s+1>(hv),
+                                              amrex::get<s+2>(hv), amrex::get<s+3>(hv),
+                                              amrex::get<s+4>(hv), amrex::get<s+5>(hv),
+                                              amrex::get<s+6>(hv), amrex::get<s+7>(hv)};
+        const int c0 = pass*ncomp_per_pass;
+        for (int n = 0; n < ncomp_per_pass && c0+n < m_ncomp; ++n) {
+            sums[c0+n]         = ps[n];
+            sums[m_ncomp+c0+n] = ps[ncomp_per_pass+n];
+        }
+    }
+
+    ParallelDescriptor::ReduceRealMax(rmax.data(), AMREX_SPACEDIM+1);
+    ParallelDescriptor::ReduceBoolOr(has_nan);
+    ParallelDescriptor::ReduceRealSum(sums.data(), 2*m_ncomp);
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        diag.max_vel_over_dx[dir] = rmax[dir];
+    }
+    diag.max_abs_aofs = rmax[AMREX_SPACEDIM];
+    diag.has_nan      = has_nan;
+    diag.aofs_sum.assign(sums.begin(), sums.begin()+m_ncomp);
+    diag.boundary_flux_sum.assign(sums.begin()+m_ncomp, sums.end());
+}
 
 void
 HydroUtils::ComputeFluxes ( Box const& bx,
@@ -23,30 +191,18 @@ HydroUtils::ComputeFluxes ( Box const& bx,
 {
 #if (AMREX_SPACEDIM == 2)
     if (geom.IsRZ()) {
-        // Need metrics when using RZ
-        Array<FArrayBox,AMREX_SPACEDIM> area;
-        Array<Elixir,AMREX_SPACEDIM> area_eli;
-        if (fluxes_are_area_weighted) {
-            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
-            {
-                const int ngrow_area = 0;
-                geom.GetFaceArea(area[dir],BoxArray(bx),0,dir,ngrow_area);
-                area_eli[dir] = area[dir].elixir();
-            }
-        }
-        const auto& ax = (fluxes_are_area_weighted) ? area[0].const_array()
-                                                    : Array4<const Real>{};
-        const auto& ay = (fluxes_are_area_weighted) ? area[1].const_array()
-                                                    : Array4<const Real>{};
+        // The RZ metrics are computed inline rather than stored
+        const auto dx     = geom.CellSizeArray();
+        const auto problo = geom.ProbLoArray();
         //
         //  X flux
         //
         const Box& xbx = amrex::surroundingNodes(bx,0);
-        amrex::ParallelFor(xbx, ncomp, [fx, umac, xed, ax, fluxes_are_area_weighted]
+        amrex::ParallelFor(xbx, ncomp, [fx, umac, xed, dx, problo, fluxes_are_area_weighted]
         AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         {
             if (fluxes_are_area_weighted) {
-                fx(i,j,k,n) = xed(i,j,k,n) * umac(i,j,k) * ax(i,j,k);
+                fx(i,j,k,n) = xed(i,j,k,n) * umac(i,j,k) * HydroUtils::rz_face_area(i,0,dx,problo);
             } else {
                 fx(i,j,k,n) = xed(i,j,k,n) * umac(i,j,k);
             }
@@ -56,11 +212,11 @@ HydroUtils::ComputeFluxes ( Box const& bx,
         //  Y flux
         //
         const Box& ybx = amrex::surroundingNodes(bx,1);
-        amrex::ParallelFor(ybx, ncomp, [fy, vmac, yed, ay, fluxes_are_area_weighted]
+        amrex::ParallelFor(ybx, ncomp, [fy, vmac, yed, dx, problo, fluxes_are_area_weighted]
         AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         {
             if (fluxes_are_area_weighted) {
-                fy(i,j,k,n) = yed(i,j,k,n) * vmac(i,j,k) * ay(i,j,k);
+                fy(i,j,k,n) = yed(i,j,k,n) * vmac(i,j,k) * HydroUtils::rz_face_area(i,1,dx,problo);
             } else {
                 fy(i,j,k,n) = yed(i,j,k,n) * vmac(i,j,k);
             }
@@ -124,6 +280,63 @@ HydroUtils::ComputeFluxes ( Box const& bx,
 }
 
 
+void
+HydroUtils::ComputeFluxes ( AMREX_D_DECL( MultiFab& xfluxes,
+                                          MultiFab& yfluxes,
+                                          MultiFab& zfluxes),
+                            const int fluxes_comp,
+                            AMREX_D_DECL( MultiFab const& umac,
+                                          MultiFab const& vmac,
+                                          MultiFab const& wmac),
+                            AMREX_D_DECL( MultiFab const& xedge,
+                                          MultiFab const& yedge,
+                                          MultiFab const& zedge),
+                            const int edge_comp,
+                            Geometry const& geom, const int ncomp,
+                            IntVect const& nghost,
+                            int const* box_mask )
+{
+    const auto dx     = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const bool is_rz  = geom.IsRZ();
+
+    GpuArray<Real,AMREX_SPACEDIM> area;
+#if ( AMREX_SPACEDIM == 3 )
+    area[0] = dx[1]*dx[2];
+    area[1] = dx[0]*dx[2];
+    area[2] = dx[0]*dx[1];
+#else
+    area[0] = dx[1];
+    area[1] = dx[0];
+#endif
+
+    Array<MultiFab*,AMREX_SPACEDIM> const fluxes{AMREX_D_DECL(&xfluxes, &yfluxes, &zfluxes)};
+    Array<MultiFab const*,AMREX_SPACEDIM> const vel{AMREX_D_DECL(&umac, &vmac, &wmac)};
+    Array<MultiFab const*,AMREX_SPACEDIM> const edge{AMREX_D_DECL(&xedge, &yedge, &zedge)};
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
+    {
+        auto const& ma_f = fluxes[dir]->arrays();
+        auto const& ma_u = vel[dir]->const_arrays();
+        auto const& ma_e = edge[dir]->const_arrays();
+        const Real a_dir = area[dir];
+
+        amrex::ParallelFor(*fluxes[dir], nghost, ncomp,
+        [=] AMREX_GPU_DEVICE (int box, int i, int j, int k, int n) noexcept
+        {
+            if (box_mask && !box_mask[box]) { return; }
+            Real a = a_dir;
+#if (AMREX_SPACEDIM == 2)
+            if (is_rz) { a = HydroUtils::rz_face_area(i,dir,dx,problo); }
+#else
+            amrex::ignore_unused(is_rz, problo);
+#endif
+            ma_f[box](i,j,k,n+fluxes_comp) = ma_e[box](i,j,k,n+edge_comp) * ma_u[box](i,j,k) * a;
+        });
+    }
+}
+
+
 
 void
 HydroUtils::ComputeDivergence ( Box const& bx,
@@ -133,39 +346,30 @@ HydroUtils::ComputeDivergence ( Box const& bx,
                                               Array4<Real const> const& fz),
                                 const int ncomp, Geometry const& geom,
                                 const Real mult,
-                                const bool fluxes_are_area_weighted )
+                                const bool fluxes_are_area_weighted,
+                                const bool accumulate )
 {
 #if (AMREX_SPACEDIM == 2)
     if (geom.IsRZ()) {
-        // Need metrics when using RZ
-        const int ngrow_metric = 0;
-        FArrayBox vol_fab;
-        geom.GetVolume(vol_fab,BoxArray(bx),0,ngrow_metric);
-        Elixir vol_eli = vol_fab.elixir();
-        Array<FArrayBox,AMREX_SPACEDIM> area;
-        Array<Elixir,AMREX_SPACEDIM> area_eli;
-        if (!fluxes_are_area_weighted) {
-            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
-            {
-                geom.GetFaceArea(area[dir],BoxArray(bx),0,dir,ngrow_metric);
-                area_eli[dir] = area[dir].elixir();
-            }
-        }
-        const auto& vol = vol_fab.const_array();
-        const auto& ax  = (fluxes_are_area_weighted) ? Array4<const Real>{}
-                                                     : area[0].const_array();
-        const auto& ay  = (fluxes_are_area_weighted) ? Array4<const Real>{}
-                                                      : area[1].const_array();
+        // The RZ metrics are computed inline rather than stored
+        const auto dx     = geom.CellSizeArray();
+        const auto problo = geom.ProbLoArray();
         amrex::ParallelFor(bx, ncomp,[=]
         AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         {
+            const Real vol = HydroUtils::rz_volume(i,dx,problo);
+            Real d;
             if (fluxes_are_area_weighted) {
-                div(i,j,k,n) = ( fx(i+1,j,k,n) -  fx(i,j,k,n) +
-                                 fy(i,j+1,k,n) -  fy(i,j,k,n) ) * mult / vol(i,j,k);
+                d = ( fx(i+1,j,k,n) -  fx(i,j,k,n) +
+                      fy(i,j+1,k,n) -  fy(i,j,k,n) ) * mult / vol;
             } else {
-                div(i,j,k,n) = ( ax(i+1,j,k)*fx(i+1,j,k,n) -  ax(i,j,k)*fx(i,j,k,n) +
-                                 ay(i,j+1,k)*fy(i,j+1,k,n) -  ay(i,j,k)*fy(i,j,k,n) ) * mult / vol(i,j,k);
+                const Real axlo = HydroUtils::rz_face_area(i  ,0,dx,problo);
+                const Real axhi = HydroUtils::rz_face_area(i+1,0,dx,problo);
+                const Real ay   = HydroUtils::rz_face_area(i  ,1,dx,problo);
+                d = ( axhi*fx(i+1,j,k,n) -  axlo*fx(i,j,k,n) +
+                      ay*(fy(i,j+1,k,n) -  fy(i,j,k,n)) ) * mult / vol;
             }
+            div(i,j,k,n) = accumulate ? div(i,j,k,n) + d : d;
         });
     } else
 #endif
@@ -190,9 +394,10 @@ HydroUtils::ComputeDivergence ( Box const& bx,
         amrex::ParallelFor(bx, ncomp,[=]
         AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         {
-            div(i,j,k,n) = AMREX_D_TERM(  fact_x * ( fx(i+1,j,k,n) - fx(i,j,k,n) ),
+            const Real d = AMREX_D_TERM(  fact_x * ( fx(i+1,j,k,n) - fx(i,j,k,n) ),
                                         + fact_y * ( fy(i,j+1,k,n) - fy(i,j,k,n) ),
                                         + fact_z * ( fz(i,j,k+1,n) - fz(i,j,k,n) ));
+            div(i,j,k,n) = accumulate ? div(i,j,k,n) + d : d;
         });
     }
 }